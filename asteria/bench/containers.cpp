@@ -0,0 +1,666 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../rocket/cow_string.hpp"
+#include "../rocket/cow_vector.hpp"
+#include "../rocket/cow_hashmap.hpp"
+#include "../rocket/prehashed_string.hpp"
+#include "../rocket/static_vector.hpp"
+#include "../rocket/linear_buffer.hpp"
+#include "../rocket/tinyfmt_str.hpp"
+#include "../rocket/ascii_numput.hpp"
+#include "../rocket/ascii_numget.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <sstream>
+#include <chrono>
+#include <unistd.h>  // ::getopt()
+
+namespace {
+
+// Each function performs `nops` operations and returns the number of nanoseconds that
+// they took. Preparation that is not part of an operation is not measured.
+using Function = uint64_t (uint64_t nops);
+
+struct Benchmark
+  {
+    const char* name;
+    Function* rocket_func;
+    Function* std_func;
+  };
+
+uint64_t s_min_time_ns = 100000000;
+::FILE* s_output = stdout;
+
+template<typename valueT>
+inline
+void
+do_keep(const valueT& value)
+noexcept
+  {
+    // Prevent the compiler from optimizing `value` away.
+    __asm__ volatile ("" : : "r"(&value) : "memory");
+  }
+
+inline
+uint64_t
+do_get_nanoseconds()
+noexcept
+  {
+    auto dur = ::std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(dur).count());
+  }
+
+// Strings, keys and numbers are prepared once, so they are not measured.
+constexpr size_t s_nkeys = 65536;
+::std::vector<::std::string> s_std_keys;
+::std::vector<::std::string> s_std_misses;
+::std::vector<::rocket::prehashed_string> s_rocket_keys;
+::std::vector<::rocket::prehashed_string> s_rocket_misses;
+
+constexpr size_t s_nnums = 64;
+int64_t s_ints[s_nnums];
+double s_reals[s_nnums];
+::std::string s_int_texts[s_nnums];
+::std::string s_real_texts[s_nnums];
+
+void
+do_prepare()
+  {
+    char temp[64];
+    for(size_t i = 0;  i < s_nkeys;  ++i) {
+      ::std::sprintf(temp, "key_%zu", i * 2654435761 % 1000000007);
+      s_std_keys.emplace_back(temp);
+      s_rocket_keys.emplace_back(::rocket::cow_string(temp));
+      ::std::sprintf(temp, "miss_%zu", i * 2654435761 % 1000000007);
+      s_std_misses.emplace_back(temp);
+      s_rocket_misses.emplace_back(::rocket::cow_string(temp));
+    }
+
+    uint64_t seed = 12345;
+    for(size_t i = 0;  i < s_nnums;  ++i) {
+      seed = seed * 6364136223846793005 + 1442695040888963407;
+      s_ints[i] = static_cast<int64_t>(seed) >> (i % 48);
+      s_reals[i] = static_cast<double>(static_cast<int64_t>(seed >> 11)) / 3.0e12 * ((i & 1) ? -1 : 1);
+      ::std::sprintf(temp, "%lld", static_cast<long long>(s_ints[i]));
+      s_int_texts[i] = temp;
+      ::std::sprintf(temp, "%.17g", s_reals[i]);
+      s_real_texts[i] = temp;
+    }
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// Strings
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename stringT, size_t lengthT>
+uint64_t
+do_string_copy(uint64_t nops)
+  {
+    stringT str(lengthT, 'a');
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      stringT copy(str);
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_string_copy_split(uint64_t nops)
+  {
+    // The copy is split from the original when it is modified.
+    ::rocket::cow_string str(1000, 'a');
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::rocket::cow_string copy(str);
+      copy.mut(0) = 'b';
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_string_copy_split(uint64_t nops)
+  {
+    ::std::string str(1000, 'a');
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::std::string copy(str);
+      copy[0] = 'b';
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+template<typename stringT>
+uint64_t
+do_string_append(uint64_t nops)
+  {
+    stringT str;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      str.append("meowmeow", 8);
+      if(str.size() >= 4096)
+        str.clear();
+      do_keep(str);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// Vectors
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename vectorT>
+uint64_t
+do_vector_copy(uint64_t nops)
+  {
+    vectorT vec(size_t(1000), 42);
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      vectorT copy(vec);
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_vector_copy_split(uint64_t nops)
+  {
+    ::rocket::cow_vector<int> vec(size_t(1000), 42);
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::rocket::cow_vector<int> copy(vec);
+      copy.mut(0) = 1;
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_vector_copy_split(uint64_t nops)
+  {
+    ::std::vector<int> vec(size_t(1000), 42);
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::std::vector<int> copy(vec);
+      copy[0] = 1;
+      do_keep(copy);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+template<typename vectorT>
+uint64_t
+do_vector_push_back(uint64_t nops)
+  {
+    vectorT vec;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      vec.push_back(static_cast<int>(i));
+      if(vec.size() >= 1024)
+        vec.clear();
+      do_keep(vec);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+template<typename vectorT>
+uint64_t
+do_vector_fill_16(uint64_t nops)
+  {
+    // Each operation creates a vector and pushes 16 elements into it.
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      vectorT vec;
+      for(int k = 0;  k < 16;  ++k)
+        vec.push_back(k);
+      do_keep(vec);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// Hash maps
+///////////////////////////////////////////////////////////////////////////////
+
+using rocket_map = ::rocket::cow_hashmap<::rocket::prehashed_string, int, ::rocket::prehashed_string::hash,
+                                         ::std::equal_to<void>>;
+using std_map = ::std::unordered_map<::std::string, int>;
+
+inline
+void
+do_insert(rocket_map& map, const ::rocket::prehashed_string& key, int value)
+  {
+    map.try_emplace(key, value);
+  }
+
+inline
+void
+do_insert(std_map& map, const ::std::string& key, int value)
+  {
+    map.emplace(key, value);
+  }
+
+template<typename mapT, typename keyT>
+uint64_t
+do_map_insert(uint64_t nops, const ::std::vector<keyT>& keys, size_t count)
+  {
+    // Each operation inserts a key. The map is cleared every `count` keys.
+    mapT map;
+    uint64_t time = 0;
+    for(uint64_t done = 0;  done < nops;  done += count) {
+      map.clear();
+      auto start = do_get_nanoseconds();
+      for(size_t k = 0;  k < count;  ++k)
+        do_insert(map, keys[k], static_cast<int>(k));
+      time += do_get_nanoseconds() - start;
+      do_keep(map);
+    }
+    return time * nops / ((nops + count - 1) / count * count);
+  }
+
+template<typename mapT, typename keyT>
+uint64_t
+do_map_find(uint64_t nops, const ::std::vector<keyT>& keys, const ::std::vector<keyT>& probes, size_t count,
+            size_t reserve)
+  {
+    mapT map;
+    map.reserve(reserve);
+    for(size_t k = 0;  k < count;  ++k)
+      do_insert(map, keys[k], static_cast<int>(k));
+
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      auto it = map.find(probes[i % count]);
+      do_keep(it);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+template<typename mapT, typename keyT>
+uint64_t
+do_map_erase(uint64_t nops, const ::std::vector<keyT>& keys, size_t count)
+  {
+    // Each operation erases a key. The map is filled again when it becomes empty.
+    mapT map;
+    uint64_t time = 0;
+    for(uint64_t done = 0;  done < nops;  done += count) {
+      for(size_t k = 0;  k < count;  ++k)
+        do_insert(map, keys[k], static_cast<int>(k));
+      auto start = do_get_nanoseconds();
+      for(size_t k = 0;  k < count;  ++k)
+        map.erase(keys[k]);
+      time += do_get_nanoseconds() - start;
+      do_keep(map);
+    }
+    return time * nops / ((nops + count - 1) / count * count);
+  }
+
+template<size_t countT>
+uint64_t
+do_rocket_map_insert(uint64_t nops)
+  { return do_map_insert<rocket_map>(nops, s_rocket_keys, countT);  }
+
+template<size_t countT>
+uint64_t
+do_std_map_insert(uint64_t nops)
+  { return do_map_insert<std_map>(nops, s_std_keys, countT);  }
+
+template<size_t countT, size_t reserveT = 0>
+uint64_t
+do_rocket_map_find_hit(uint64_t nops)
+  { return do_map_find<rocket_map>(nops, s_rocket_keys, s_rocket_keys, countT, reserveT);  }
+
+template<size_t countT, size_t reserveT = 0>
+uint64_t
+do_std_map_find_hit(uint64_t nops)
+  { return do_map_find<std_map>(nops, s_std_keys, s_std_keys, countT, reserveT);  }
+
+template<size_t countT>
+uint64_t
+do_rocket_map_find_miss(uint64_t nops)
+  { return do_map_find<rocket_map>(nops, s_rocket_keys, s_rocket_misses, countT, 0);  }
+
+template<size_t countT>
+uint64_t
+do_std_map_find_miss(uint64_t nops)
+  { return do_map_find<std_map>(nops, s_std_keys, s_std_misses, countT, 0);  }
+
+template<size_t countT>
+uint64_t
+do_rocket_map_erase(uint64_t nops)
+  { return do_map_erase<rocket_map>(nops, s_rocket_keys, countT);  }
+
+template<size_t countT>
+uint64_t
+do_std_map_erase(uint64_t nops)
+  { return do_map_erase<std_map>(nops, s_std_keys, countT);  }
+
+///////////////////////////////////////////////////////////////////////////////
+// Buffers
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t
+do_rocket_buffer_put_get(uint64_t nops)
+  {
+    ::rocket::linear_buffer buf;
+    char temp[64] = { };
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      buf.putn(temp, sizeof(temp));
+      buf.putn(temp, sizeof(temp));
+      buf.getn(temp, sizeof(temp));
+      buf.getn(temp, sizeof(temp));
+      do_keep(temp);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_buffer_put_get(uint64_t nops)
+  {
+    ::std::string buf;
+    char temp[64] = { };
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      buf.append(temp, sizeof(temp));
+      buf.append(temp, sizeof(temp));
+      buf.copy(temp, sizeof(temp));
+      buf.erase(0, sizeof(temp));
+      buf.copy(temp, sizeof(temp));
+      buf.erase(0, sizeof(temp));
+      do_keep(temp);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+///////////////////////////////////////////////////////////////////////////////
+// Numbers
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t
+do_rocket_format_integer(uint64_t nops)
+  {
+    ::rocket::ascii_numput nump;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      nump.put_DI(s_ints[i % s_nnums]);
+      do_keep(nump);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_format_integer(uint64_t nops)
+  {
+    char temp[64];
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::std::snprintf(temp, sizeof(temp), "%lld", static_cast<long long>(s_ints[i % s_nnums]));
+      do_keep(temp);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_format_real(uint64_t nops)
+  {
+    ::rocket::ascii_numput nump;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      nump.put_DF(s_reals[i % s_nnums]);
+      do_keep(nump);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_format_real(uint64_t nops)
+  {
+    char temp[64];
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      ::std::snprintf(temp, sizeof(temp), "%.17g", s_reals[i % s_nnums]);
+      do_keep(temp);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_stream_integer(uint64_t nops)
+  {
+    ::rocket::tinyfmt_str fmt;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      fmt.clear_string();
+      fmt << s_ints[i % s_nnums];
+      do_keep(fmt);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_stream_integer(uint64_t nops)
+  {
+    ::std::ostringstream fmt;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      fmt.str(::std::string());
+      fmt << s_ints[i % s_nnums];
+      do_keep(fmt);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_parse_integer(uint64_t nops)
+  {
+    ::rocket::ascii_numget numg;
+    long long value;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      const auto& text = s_int_texts[i % s_nnums];
+      const char* bptr = text.data();
+      numg.get(value, bptr, text.data() + text.size());
+      do_keep(value);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_parse_integer(uint64_t nops)
+  {
+    long long value;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      value = ::std::strtoll(s_int_texts[i % s_nnums].c_str(), nullptr, 10);
+      do_keep(value);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_rocket_parse_real(uint64_t nops)
+  {
+    ::rocket::ascii_numget numg;
+    double value;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      const auto& text = s_real_texts[i % s_nnums];
+      const char* bptr = text.data();
+      numg.get(value, bptr, text.data() + text.size());
+      do_keep(value);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+uint64_t
+do_std_parse_real(uint64_t nops)
+  {
+    double value;
+    auto start = do_get_nanoseconds();
+    for(uint64_t i = 0;  i < nops;  ++i) {
+      value = ::std::strtod(s_real_texts[i % s_nnums].c_str(), nullptr);
+      do_keep(value);
+    }
+    return do_get_nanoseconds() - start;
+  }
+
+constexpr Benchmark s_benchmarks[] =
+  {
+    { "string_copy_16",
+      do_string_copy<::rocket::cow_string, 16>, do_string_copy<::std::string, 16> },
+    { "string_copy_1000",
+      do_string_copy<::rocket::cow_string, 1000>, do_string_copy<::std::string, 1000> },
+    { "string_copy_split_1000",
+      do_rocket_string_copy_split, do_std_string_copy_split },
+    { "string_append",
+      do_string_append<::rocket::cow_string>, do_string_append<::std::string> },
+
+    { "vector_copy_1000",
+      do_vector_copy<::rocket::cow_vector<int>>, do_vector_copy<::std::vector<int>> },
+    { "vector_copy_split_1000",
+      do_rocket_vector_copy_split, do_std_vector_copy_split },
+    { "vector_push_back",
+      do_vector_push_back<::rocket::cow_vector<int>>, do_vector_push_back<::std::vector<int>> },
+    { "static_vector_fill_16",
+      do_vector_fill_16<::rocket::static_vector<int, 16>>, do_vector_fill_16<::std::vector<int>> },
+
+    { "hashmap_insert_16",
+      do_rocket_map_insert<16>, do_std_map_insert<16> },
+    { "hashmap_insert_1024",
+      do_rocket_map_insert<1024>, do_std_map_insert<1024> },
+    { "hashmap_insert_65536",
+      do_rocket_map_insert<65536>, do_std_map_insert<65536> },
+    { "hashmap_find_hit_16",
+      do_rocket_map_find_hit<16>, do_std_map_find_hit<16> },
+    { "hashmap_find_hit_1024",
+      do_rocket_map_find_hit<1024>, do_std_map_find_hit<1024> },
+    { "hashmap_find_hit_65536",
+      do_rocket_map_find_hit<65536>, do_std_map_find_hit<65536> },
+    { "hashmap_find_hit_16384_sparse",
+      do_rocket_map_find_hit<16384, 65536>, do_std_map_find_hit<16384, 65536> },
+    { "hashmap_find_miss_16",
+      do_rocket_map_find_miss<16>, do_std_map_find_miss<16> },
+    { "hashmap_find_miss_1024",
+      do_rocket_map_find_miss<1024>, do_std_map_find_miss<1024> },
+    { "hashmap_find_miss_65536",
+      do_rocket_map_find_miss<65536>, do_std_map_find_miss<65536> },
+    { "hashmap_erase_16",
+      do_rocket_map_erase<16>, do_std_map_erase<16> },
+    { "hashmap_erase_1024",
+      do_rocket_map_erase<1024>, do_std_map_erase<1024> },
+    { "hashmap_erase_65536",
+      do_rocket_map_erase<65536>, do_std_map_erase<65536> },
+
+    { "buffer_put_get_128",
+      do_rocket_buffer_put_get, do_std_buffer_put_get },
+
+    { "format_integer",
+      do_rocket_format_integer, do_std_format_integer },
+    { "format_real",
+      do_rocket_format_real, do_std_format_real },
+    { "stream_integer",
+      do_rocket_stream_integer, do_std_stream_integer },
+    { "parse_integer",
+      do_rocket_parse_integer, do_std_parse_integer },
+    { "parse_real",
+      do_rocket_parse_real, do_std_parse_real },
+  };
+
+double
+do_measure(Function* func)
+  {
+    // Warm up and find a number of operations that takes a while.
+    uint64_t nops = 1;
+    uint64_t time = func(nops);
+    while((time < s_min_time_ns / 10) && (nops < UINT64_MAX / 4)) {
+      nops *= 2;
+      time = func(nops);
+    }
+    nops = ::std::max(nops * s_min_time_ns / ::std::max(time, uint64_t(1)), uint64_t(1));
+    time = func(nops);
+    return static_cast<double>(time) / static_cast<double>(nops);
+  }
+
+[[noreturn]]
+void
+do_print_help_and_exit(const char* self)
+  {
+    ::printf(
+//        1         2         3         4         5         6         7     |
+// 3456789012345678901234567890123456789012345678901234567890123456789012345|
+"""""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+Usage: %s [OPTIONS] [NAME]...
+
+  -h      show help message then exit
+  -m nn   run each benchmark for about `nn` milliseconds [default = 100]
+  -o FILE write results to FILE instead of standard output
+
+If NAMEs are given, only benchmarks whose names contain any of them are run.
+Results are written as JSON, with one benchmark per line. `ratio` is the time
+of the rocket container divided by that of its standard counterpart.
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""""""""""+1,
+// 3456789012345678901234567890123456789012345678901234567890123456789012345|
+//        1         2         3         4         5         6         7     |
+      self);
+    ::exit(0);
+  }
+
+}  // namespace
+
+int main(int argc, char** argv)
+  {
+    ::rocket::unique_posix_file output(nullptr, ::fclose);
+
+    int ch;
+    while((ch = ::getopt(argc, argv, "hm:o:")) != -1) {
+      switch(ch) {
+        case 'h':
+          do_print_help_and_exit(argv[0]);
+
+        case 'm':
+          s_min_time_ns = ::std::strtoull(optarg, nullptr, 10) * 1000000;
+          continue;
+
+        case 'o':
+          output.reset(::fopen(optarg, "w"));
+          if(!output) {
+            ::fprintf(stderr, "! could not open '%s': %m\n", optarg);
+            return 2;
+          }
+          s_output = output;
+          continue;
+
+        default:
+          return 2;
+      }
+    }
+
+    do_prepare();
+    bool comma = false;
+    ::fprintf(s_output, "{\"benchmarks\":[");
+
+    for(const auto& bench : s_benchmarks) {
+      // Apply filters.
+      bool selected = optind == argc;
+      for(int i = optind;  i < argc;  ++i)
+        selected |= ::std::strstr(bench.name, argv[i]) != nullptr;
+      if(!selected)
+        continue;
+
+      double rocket_ns = do_measure(bench.rocket_func);
+      double std_ns = do_measure(bench.std_func);
+      ::fprintf(s_output,
+                "%s\n{\"name\":\"%s\",\"rocket_ns_per_op\":%.3f,\"std_ns_per_op\":%.3f,\"ratio\":%.3f}",
+                comma ? "," : "", bench.name, rocket_ns, std_ns, rocket_ns / std_ns);
+      comma = true;
+      ::fflush(s_output);
+    }
+
+    ::fprintf(s_output, "\n]}\n");
+    return 0;
+  }
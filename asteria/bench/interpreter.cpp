@@ -0,0 +1,467 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/module_cache.hpp"
+#include "../src/utilities.hpp"
+#include <chrono>
+#include <sys/resource.h>  // ::getrusage()
+#include <sys/wait.h>  // ::waitpid()
+#include <unistd.h>  // ::fork(), ::pipe()
+
+using namespace Asteria;
+
+// Allocations are counted, so they can be reported per operation.
+::std::atomic<uint64_t> s_nallocs;
+
+void* operator new(size_t cb)
+  {
+    auto ptr = ::std::malloc(cb);
+    if(!ptr)
+      throw ::std::bad_alloc();
+    s_nallocs.fetch_add(1, ::std::memory_order_relaxed);
+    return ptr;
+  }
+
+void operator delete(void* ptr) noexcept
+  {
+    ::std::free(ptr);
+  }
+
+void operator delete(void* ptr, size_t) noexcept
+  {
+    ::std::free(ptr);
+  }
+
+namespace {
+
+// Each script performs `__varg(0)` operations. The cost of the loop is included.
+// If `module` is set, it is written to a file, and every operation compiles it by
+// running `source` once with the path of that file, after the module cache is cleared.
+struct Benchmark
+  {
+    const char* name;
+    const char* source;
+    const char* module;
+  };
+
+constexpr Benchmark s_benchmarks[] =
+  {
+    { "function_call",
+      R"__(
+        func noop(x) { return x; }
+        var n = __varg(0);
+        for(var i = 0;  i < n;  ++i)
+          noop(i);
+      )__",
+      nullptr },
+
+    { "closure_creation",
+      R"__(
+        var n = __varg(0);
+        for(var i = 0;  i < n;  ++i) {
+          var f = func() { return i; };
+        }
+      )__",
+      nullptr },
+
+    { "integer_loop",
+      R"__(
+        var n = __varg(0);
+        var s = 0;
+        for(var i = 0;  i < n;  ++i)
+          s += i * 3 ^ 5;
+        return s;
+      )__",
+      nullptr },
+
+    { "string_concatenation",
+      R"__(
+        var n = __varg(0);
+        var s = "";
+        for(var i = 0;  i < n;  ++i) {
+          s += "meow";
+          if(countof s > 4096)
+            s = "";
+        }
+      )__",
+      nullptr },
+
+    { "object_member_access",
+      R"__(
+        var n = __varg(0);
+        var o = { a: 1, b: 2, c: 3 };
+        for(var i = 0;  i < n;  ++i)
+          o.b = o.a + o.c;
+      )__",
+      nullptr },
+
+    { "array_sort_100",
+      R"__(
+        var n = __varg(0);
+        var a = [];
+        for(var i = 0;  i < 100;  ++i)
+          a[i] = i * 7919 % 100;
+        for(var i = 0;  i < n;  ++i)
+          std.array.sort(a);
+      )__",
+      nullptr },
+
+    { "array_sort_100_comparator",
+      R"__(
+        var n = __varg(0);
+        var a = [];
+        for(var i = 0;  i < 100;  ++i)
+          a[i] = i * 7919 % 100;
+        var cmp = func(x, y) { return y <=> x; };
+        for(var i = 0;  i < n;  ++i)
+          std.array.sort(a, cmp);
+      )__",
+      nullptr },
+
+    { "json_format",
+      R"__(
+        var n = __varg(0);
+        var o = { name: "meow", values: [ 1, 2.5, true, null, "str" ], nested: { a: 1, b: [] } };
+        for(var i = 0;  i < n;  ++i)
+          std.json.format(o);
+      )__",
+      nullptr },
+
+    { "json_parse",
+      R"__(
+        var n = __varg(0);
+        var o = { name: "meow", values: [ 1, 2.5, true, null, "str" ], nested: { a: 1, b: [] } };
+        var text = std.json.format(o);
+        for(var i = 0;  i < n;  ++i)
+          std.json.parse(text);
+      )__",
+      nullptr },
+
+    { "gc_churn",
+      R"__(
+        var n = __varg(0);
+        var g;
+        func leak() {
+          var f;
+          f = func() { return f; };
+          g = f;
+        }
+        for(var i = 0;  i < n;  ++i)
+          leak();
+      )__",
+      nullptr },
+
+    { "exception_throw_catch",
+      R"__(
+        var n = __varg(0);
+        for(var i = 0;  i < n;  ++i)
+          try
+            throw i;
+          catch(e)
+            ;
+      )__",
+      nullptr },
+
+    { "import_compile",
+      R"__(
+        return import(__varg(0));
+      )__",
+      R"__(
+        func fib(n) {
+          if(n < 2)
+            return n;
+          return fib(n - 1) + fib(n - 2);
+        }
+        func join(a, sep) {
+          var s = "";
+          for(each k, v : a) {
+            if(k != 0)
+              s += sep;
+            s += std.string.format("$1", v);
+          }
+          return s;
+        }
+        const table = { one: 1, two: 2, three: 3, four: 4, five: 5 };
+        var r = [];
+        for(var i = 0;  i < 10;  ++i)
+          r[i] = fib(i) + table.three;
+        switch(countof r) {
+          case 0:
+            return "";
+          default:
+            return join(r, ", ");
+        }
+      )__" },
+  };
+
+struct Result
+  {
+    uint64_t nops;
+    double ns_per_op;
+    double allocs_per_op;
+    long peak_rss_kib;
+  };
+
+struct Baseline
+  {
+    char name[64];
+    double ns_per_op;
+  };
+
+// These are set from the command line.
+uint64_t s_min_time_ns = 200000000;
+double s_threshold = 10;
+::FILE* s_output = stdout;
+cow_vector<Baseline> s_baselines;
+
+uint64_t
+do_get_nanoseconds()
+noexcept
+  {
+    auto dur = ::std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(dur).count());
+  }
+
+uint64_t
+do_run_once(const Benchmark& bench, Simple_Script& code, Global_Context& global, const cow_string& path,
+            uint64_t nops)
+  {
+    auto start = do_get_nanoseconds();
+    if(bench.module) {
+      auto modcache = global.module_cache();
+      for(uint64_t i = 0;  i < nops;  ++i) {
+        modcache->clear();
+        code.execute(global, { Value(path) });
+      }
+    }
+    else
+      code.execute(global, { Value(static_cast<int64_t>(nops)) });
+    return do_get_nanoseconds() - start;
+  }
+
+Result
+do_measure(const Benchmark& bench)
+  {
+    cow_string path;
+    if(bench.module) {
+      char tname[] = "/tmp/asteria-bench-XXXXXX";
+      int fd = ::mkstemp(tname);
+      if(fd == -1)
+        ASTERIA_THROW_SYSTEM_ERROR("mkstemp");
+      path = cow_string(tname);
+      ::rocket::unique_posix_file file(::fdopen(fd, "wb"), ::fclose);
+      if(!file || (::fputs(bench.module, file) < 0))
+        ASTERIA_THROW_SYSTEM_ERROR("fputs");
+    }
+
+    Simple_Script code;
+    code.reload_string(::rocket::sref(bench.source), ::rocket::sref(bench.name));
+    Global_Context global;
+
+    // Warm up and find a number of operations that takes a while.
+    uint64_t nops = 1;
+    uint64_t time = do_run_once(bench, code, global, path, nops);
+    while((time < s_min_time_ns / 10) && (nops < UINT64_MAX / 4)) {
+      nops *= 2;
+      time = do_run_once(bench, code, global, path, nops);
+    }
+    nops = ::rocket::max(nops * s_min_time_ns / ::rocket::max(time, uint64_t(1)), uint64_t(1));
+
+    Result res;
+    res.nops = nops;
+    auto nallocs = s_nallocs.load(::std::memory_order_relaxed);
+    time = do_run_once(bench, code, global, path, nops);
+    nallocs = s_nallocs.load(::std::memory_order_relaxed) - nallocs;
+    res.ns_per_op = static_cast<double>(time) / static_cast<double>(nops);
+    res.allocs_per_op = static_cast<double>(nallocs) / static_cast<double>(nops);
+
+    struct ::rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    res.peak_rss_kib = usage.ru_maxrss;
+
+    if(bench.module)
+      ::unlink(path.c_str());
+    return res;
+  }
+
+bool
+do_run_isolated(Result& res, const Benchmark& bench)
+  {
+    // Each benchmark runs in its own process, so peak memory usage can be told apart.
+    // Buffered output must not be inherited by the child.
+    ::fflush(nullptr);
+    int fds[2];
+    if(::pipe(fds) != 0)
+      return false;
+
+    ::pid_t pid = ::fork();
+    if(pid == -1) {
+      ::close(fds[0]);
+      ::close(fds[1]);
+      return false;
+    }
+
+    if(pid == 0) {
+      ::close(fds[0]);
+      try {
+        res = do_measure(bench);
+      }
+      catch(exception& stdex) {
+        ::fprintf(stderr, "! benchmark `%s` failed: %s\n", bench.name, stdex.what());
+        ::_exit(1);
+      }
+      bool ok = ::write(fds[1], &res, sizeof(res)) == static_cast<::ssize_t>(sizeof(res));
+      ::_exit(ok ? 0 : 1);
+    }
+
+    ::close(fds[1]);
+    bool ok = ::read(fds[0], &res, sizeof(res)) == static_cast<::ssize_t>(sizeof(res));
+    ::close(fds[0]);
+
+    int status;
+    if(::waitpid(pid, &status, 0) != pid)
+      return false;
+    return ok && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+  }
+
+void
+do_load_baselines(const char* path)
+  {
+    ::rocket::unique_posix_file file(::fopen(path, "r"), ::fclose);
+    if(!file) {
+      ::fprintf(stderr, "! could not open baseline '%s': %m\n", path);
+      ::exit(2);
+    }
+
+    // Only files written by this program are accepted, which have one benchmark per line.
+    char line[1024];
+    while(::fgets(line, sizeof(line), file)) {
+      Baseline base;
+      if(::sscanf(line, "{\"name\":\"%63[^\"]\",\"iterations\":%*u,\"ns_per_op\":%lf",
+                  base.name, &(base.ns_per_op)) == 2)
+        s_baselines.emplace_back(base);
+    }
+  }
+
+const Baseline*
+do_find_baseline(const char* name)
+  {
+    for(const auto& base : s_baselines)
+      if(::strcmp(base.name, name) == 0)
+        return &base;
+    return nullptr;
+  }
+
+[[noreturn]]
+void
+do_print_help_and_exit(const char* self)
+  {
+    ::printf(
+//        1         2         3         4         5         6         7     |
+// 3456789012345678901234567890123456789012345678901234567890123456789012345|
+"""""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+Usage: %s [OPTIONS] [NAME]...
+
+  -b BASE compare results with BASE, which was written by this program
+  -h      show help message then exit
+  -m nn   run each benchmark for about `nn` milliseconds [default = 200]
+  -o FILE write results to FILE instead of standard output
+  -t nn   fail if any benchmark is `nn` percent slower than BASE
+          [default = 10]
+
+If NAMEs are given, only benchmarks whose names contain any of them are run.
+Results are written as JSON, with one benchmark per line.
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""""""""""+1,
+// 3456789012345678901234567890123456789012345678901234567890123456789012345|
+//        1         2         3         4         5         6         7     |
+      self);
+    ::exit(0);
+  }
+
+}  // namespace
+
+int main(int argc, char** argv)
+  try {
+    ::rocket::unique_posix_file output(nullptr, ::fclose);
+
+    int ch;
+    while((ch = ::getopt(argc, argv, "b:hm:o:t:")) != -1) {
+      switch(ch) {
+        case 'b':
+          do_load_baselines(optarg);
+          continue;
+
+        case 'h':
+          do_print_help_and_exit(argv[0]);
+
+        case 'm':
+          s_min_time_ns = ::strtoull(optarg, nullptr, 10) * 1000000;
+          continue;
+
+        case 'o':
+          output.reset(::fopen(optarg, "w"));
+          if(!output) {
+            ::fprintf(stderr, "! could not open '%s': %m\n", optarg);
+            return 2;
+          }
+          s_output = output;
+          continue;
+
+        case 't':
+          s_threshold = ::strtod(optarg, nullptr);
+          continue;
+
+        default:
+          return 2;
+      }
+    }
+
+    int status = 0;
+    bool comma = false;
+    ::fprintf(s_output, "{\"benchmarks\":[");
+
+    for(const auto& bench : s_benchmarks) {
+      // Apply filters.
+      bool selected = optind == argc;
+      for(int i = optind;  i < argc;  ++i)
+        selected |= ::strstr(bench.name, argv[i]) != nullptr;
+      if(!selected)
+        continue;
+
+      Result res;
+      if(!do_run_isolated(res, bench)) {
+        ::fprintf(stderr, "! benchmark `%s` did not complete\n", bench.name);
+        status = 1;
+        continue;
+      }
+
+      ::fprintf(s_output,
+                "%s\n{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.3f,\"allocs_per_op\":%.3f,"
+                "\"peak_rss_kib\":%ld",
+                comma ? "," : "", bench.name, static_cast<unsigned long long>(res.nops),
+                res.ns_per_op, res.allocs_per_op, res.peak_rss_kib);
+      comma = true;
+
+      // Compare with the baseline if any.
+      if(auto qbase = do_find_baseline(bench.name)) {
+        double change = (res.ns_per_op / qbase->ns_per_op - 1) * 100;
+        ::fprintf(s_output, ",\"baseline_ns_per_op\":%.3f,\"change_percent\":%.1f",
+                  qbase->ns_per_op, change);
+        if(change > s_threshold) {
+          ::fprintf(stderr, "! benchmark `%s` is %.1f%% slower than baseline\n", bench.name, change);
+          status = 1;
+        }
+      }
+      ::fprintf(s_output, "}");
+      ::fflush(s_output);
+    }
+
+    ::fprintf(s_output, "\n]}\n");
+    return status;
+  }
+  catch(exception& stdex) {
+    ::fprintf(stderr, "! unhandled exception: %s\n", stdex.what());
+    return 1;
+  }
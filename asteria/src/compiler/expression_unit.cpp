@@ -102,7 +102,10 @@ const
           qref = qctx->get_named_reference_opt(altr.name);
           if(qref) {
             // A reference declared later has been found. Record the context depth for later lookups.
-            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, altr.name };
+            // Its slot is recorded too, so it can be located at runtime without hashing.
+            auto slot = ::rocket::min(qctx->find_named_reference_slot(altr.name), UINT32_MAX);
+            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, static_cast<uint32_t>(slot),
+                                                       altr.name };
             code.emplace_back(::std::move(xnode));
             return code;
           }
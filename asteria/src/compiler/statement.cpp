@@ -119,13 +119,32 @@ do_generate_statement_list(cow_vector<phsh_string>* names_opt, Analytic_Context&
     return code;
   }
 
+bool
+do_block_declares_names(const Statement::S_block& block)
+  {
+    return ::std::any_of(block.stmts.begin(), block.stmts.end(),
+                         [&](const Statement& stmt) { return stmt.declares_names();  });
+  }
+
 cow_vector<AIR_Node>
-do_generate_block(const Compiler_Options& opts, PTC_Aware ptc, const Analytic_Context& ctx,
+do_generate_block(const Compiler_Options& opts, PTC_Aware ptc, Analytic_Context& ctx,
                   const Statement::S_block& block)
   {
     cow_vector<AIR_Node> code;
+
+    // If the block declares nothing, it is generated in the enclosing scope, so no context
+    // has to be created at runtime.
+    if(!do_block_declares_names(block)) {
+      do_generate_statement_list(code, nullptr, ctx, opts, ptc, block);
+      return code;
+    }
+
+    // Otherwise, wrap it in a scope.
     Analytic_Context ctx_stmts(::rocket::ref(ctx));
-    do_generate_statement_list(code, nullptr, ctx_stmts, opts, ptc, block);
+    auto code_body = do_generate_statement_list(nullptr, ctx_stmts, opts, ptc, block);
+
+    AIR_Node::S_execute_block xnode = { ::std::move(code_body) };
+    code.emplace_back(::std::move(xnode));
     return code;
   }
 
@@ -151,10 +170,7 @@ const
 
         // Generate code for the body. This can be PTC'd.
         auto code_body = do_generate_block(opts, ptc, ctx, altr);
-
-        // Encode arguments.
-        AIR_Node::S_execute_block xnode = { ::std::move(code_body) };
-        code.emplace_back(::std::move(xnode));
+        code.append(code_body.begin(), code_body.end());
         return code;
       }
 
@@ -301,9 +317,11 @@ const
         ROCKET_ASSERT(nclauses == altr.bodies.size());
 
         for(size_t i = 0;  i < nclauses;  ++i) {
-          // Generate code for the label.
+          // Generate code for the label. The label of a `default` clause is empty.
           // Note labels are not part of the body.
-          do_generate_expression(code_labels.emplace_back(), opts, ptc_aware_none, ctx, altr.labels[i]);
+          auto& code_label = code_labels.emplace_back();
+          if(!altr.labels[i].units.empty())
+            do_generate_expression(code_label, opts, ptc_aware_none, ctx, altr.labels[i]);
           // Generate code for the clause and accumulate names.
           // This cannot be PTC'd.
           do_generate_statement_list(code_bodies.emplace_back(), &names, ctx_body, opts, ptc_aware_none,
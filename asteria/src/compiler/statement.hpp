@@ -206,6 +206,15 @@ class Statement
           return this->m_stor.as<index_return>().expr.units.empty();
       }
 
+    // Does this statement declare names in the enclosing scope?
+    bool
+    declares_names()
+    const noexcept
+      {
+        return ::rocket::is_any_of(this->index(), { index_variables, index_function,
+                                                    index_defer });
+      }
+
     Statement&
     swap(Statement& other)
     noexcept
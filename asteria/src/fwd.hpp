@@ -163,9 +163,14 @@ class Global_Context;
 class Genius_Collector;
 class Random_Engine;
 class Loader_Lock;
+class Module_Cache;
+class Sampling_Profiler;
 class Variadic_Arguer;
+class Function_Template;
 class Instantiated_Function;
 class AIR_Node;
+class AIR_Serializer;
+class AIR_Deserializer;
 class Backtrace_Frame;
 class Argument_Reader;
 
@@ -715,6 +720,10 @@ struct Compiler_Options_fragment<1>
 template<>
 struct Compiler_Options_fragment<2>
   {
+    // Load compiled code of script files from cache files if they are up to date, and
+    // write cache files after compiling. [useful for scripts that are loaded repeatedly]
+    bool cache_compiled_code = false;
+
     // Note: Please keep this struct as compact as possible.
   };
 
@@ -4,6 +4,7 @@
 #include "../precompiled.hpp"
 #include "numeric.hpp"
 #include "../runtime/argument_reader.hpp"
+#include "../runtime/native_binding.hpp"
 #include "../runtime/global_context.hpp"
 #include "../runtime/random_engine.hpp"
 #include "../utilities.hpp"
@@ -756,7 +757,9 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     // `std.numeric.abs()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("abs"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_abs>,
+                  Native_Overload<V_real, V_real>::Target<std_numeric_abs>>(
+        "std.numeric.abs",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.abs(value)`
 
@@ -769,31 +772,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Return the absolute value.
 
   * Throws an exception if `value` is the integer `-0x1p63`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.abs"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_abs(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_abs(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.sign()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("sign"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_sign>,
+                  Native_Overload<V_integer, V_real>::Target<std_numeric_sign>>(
+        "std.numeric.sign",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.sign(value)`
 
@@ -802,31 +790,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     `-0.0` is distinct from `0.0` despite the equality.
 
   * Returns `-1` if `value` is negative, or `0` otherwise.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.sign"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_sign(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_sign(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.is_finite()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("is_finite"),
-      V_function(
+      bind_native<Native_Overload<V_boolean, V_integer>::Target<std_numeric_is_finite>,
+                  Native_Overload<V_boolean, V_real>::Target<std_numeric_is_finite>>(
+        "std.numeric.is_finite",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.is_finite(value)`
 
@@ -837,31 +810,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Returns `true` if `value` is an integer or is a real that
     is neither an infinity or a NaN, or `false` otherwise.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.is_finite"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_finite(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_finite(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.is_infinity()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("is_infinity"),
-      V_function(
+      bind_native<Native_Overload<V_boolean, V_integer>::Target<std_numeric_is_infinity>,
+                  Native_Overload<V_boolean, V_real>::Target<std_numeric_is_infinity>>(
+        "std.numeric.is_infinity",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.is_infinity(value)`
 
@@ -872,31 +830,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Returns `true` if `value` is a real that denotes an infinity;
     or `false` otherwise.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.is_infinity"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_infinity(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_infinity(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.is_nan()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("is_nan"),
-      V_function(
+      bind_native<Native_Overload<V_boolean, V_integer>::Target<std_numeric_is_nan>,
+                  Native_Overload<V_boolean, V_real>::Target<std_numeric_is_nan>>(
+        "std.numeric.is_nan",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.is_nan(value)`
 
@@ -906,31 +849,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Returns `true` if `value` is a real denoting a NaN, or
     `false` otherwise.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.is_nan"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_nan(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_is_nan(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.clamp()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("clamp"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer, V_integer>::Target<std_numeric_clamp>,
+                  Native_Overload<V_real, V_real, V_real, V_real>::Target<std_numeric_clamp>>(
+        "std.numeric.clamp",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.clamp(value, lower, upper)`
 
@@ -943,37 +871,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Throws an exception if `lower` is not less than or equal to
     `upper`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.clamp"));
-    // Parse arguments.
-    V_integer ivalue;
-    V_integer ilower;
-    V_integer iupper;
-    if(reader.I().v(ivalue).v(ilower).v(iupper).F()) {
-      Reference_root::S_temporary xref = { std_numeric_clamp(::std::move(ivalue), ::std::move(ilower),
-                                                             ::std::move(iupper)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    V_real flower;
-    V_real fupper;
-    if(reader.I().v(rvalue).v(flower).v(fupper).F()) {
-      Reference_root::S_temporary xref = { std_numeric_clamp(::std::move(rvalue), ::std::move(flower),
-                                                             ::std::move(fupper)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.round()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("round"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_round>,
+                  Native_Overload<V_real, V_real>::Target<std_numeric_round>>(
+        "std.numeric.round",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.round(value)`
 
@@ -982,31 +889,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     is an integer, it is returned intact.
 
   * Returns the rounded value.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.round"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_round(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_round(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.roundi()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("roundi"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_roundi>,
+                  Native_Overload<V_integer, V_real>::Target<std_numeric_roundi>>(
+        "std.numeric.roundi",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.roundi(value)`
 
@@ -1019,31 +911,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Throws an exception if the result cannot be represented as an
     integer.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.roundi"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_roundi(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_roundi(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.floor()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("floor"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_floor>,
+                  Native_Overload<V_real, V_real>::Target<std_numeric_floor>>(
+        "std.numeric.floor",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.floor(value)`
 
@@ -1052,31 +929,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     is returned intact.
 
   * Returns the rounded value.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.floor"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_floor(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_floor(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.floori()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("floori"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_floori>,
+                  Native_Overload<V_integer, V_real>::Target<std_numeric_floori>>(
+        "std.numeric.floori",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.floori(value)`
 
@@ -1089,31 +951,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Throws an exception if the result cannot be represented as an
     integer.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.floori"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_floori(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_floori(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.ceil()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("ceil"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_ceil>,
+                  Native_Overload<V_real, V_real>::Target<std_numeric_ceil>>(
+        "std.numeric.ceil",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.ceil(value)`
 
@@ -1122,31 +969,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     it is returned intact.
 
   * Returns the rounded value.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.ceil"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_ceil(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_ceil(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.ceili()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("ceili"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_ceili>,
+                  Native_Overload<V_integer, V_real>::Target<std_numeric_ceili>>(
+        "std.numeric.ceili",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.ceili(value)`
 
@@ -1159,31 +991,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Throws an exception if the result cannot be represented as an
     integer.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.ceili"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_ceili(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_ceili(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.trunc()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("trunc"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_trunc>,
+                  Native_Overload<V_real, V_real>::Target<std_numeric_trunc>>(
+        "std.numeric.trunc",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.trunc(value)`
 
@@ -1192,31 +1009,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     intact.
 
   * Returns the rounded value.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.trunc"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_trunc(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_trunc(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.trunci()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("trunci"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_trunci>,
+                  Native_Overload<V_integer, V_real>::Target<std_numeric_trunci>>(
+        "std.numeric.trunci",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.trunci(value)`
 
@@ -1228,31 +1030,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Throws an exception if the result cannot be represented as an
     integer.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.trunci"));
-    // Parse arguments.
-    V_integer ivalue;
-    if(reader.I().v(ivalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_trunci(::std::move(ivalue)) };
-      return self = ::std::move(xref);
-    }
-    V_real rvalue;
-    if(reader.I().v(rvalue).F()) {
-      Reference_root::S_temporary xref = { std_numeric_trunci(::std::move(rvalue)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.random()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("random"),
-      V_function(
+      bind_native<Native_Overload<V_real, Global_Context&, optV_real>::Target<std_numeric_random>>(
+        "std.numeric.random",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.random([limit])`
 
@@ -1263,26 +1049,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Returns a random real value.
 
   * Throws an exception if `limit` is zero or non-finite.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.random"));
-    // Parse arguments.
-    optV_real limit;
-    if(reader.I().o(limit).F()) {
-      Reference_root::S_temporary xref = { std_numeric_random(global, ::std::move(limit)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.sqrt()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("sqrt"),
-      V_function(
+      bind_native<Native_Overload<V_real, V_real>::Target<std_numeric_sqrt>>(
+        "std.numeric.sqrt",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.sqrt(x)`
 
@@ -1290,26 +1065,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     integer or the real type. The result is always a real.
 
   * Returns the square root of `x` as a real.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.sqrt"));
-    // Parse arguments.
-    V_real x;
-    if(reader.I().v(x).F()) {
-      Reference_root::S_temporary xref = { std_numeric_sqrt(::std::move(x)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.fma()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("fma"),
-      V_function(
+      bind_native<Native_Overload<V_real, V_real, V_real, V_real>::Target<std_numeric_fma>>(
+        "std.numeric.fma",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.fma(x, y, z)`
 
@@ -1318,28 +1082,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     operations.
 
   * Returns the value of `x * y + z` as a real.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.fma"));
-    // Parse arguments.
-    V_real x;
-    V_real y;
-    V_real z;
-    if(reader.I().v(x).v(y).v(z).F()) {
-      Reference_root::S_temporary xref = { std_numeric_fma(::std::move(x), ::std::move(y), ::std::move(z)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.remainder()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("remainder"),
-      V_function(
+      bind_native<Native_Overload<V_real, V_real, V_real>::Target<std_numeric_remainder>>(
+        "std.numeric.remainder",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.remainder(x, y)`
 
@@ -1348,20 +1099,7 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     the quotient of division of `x` by `y` rounding to nearest.
 
   * Returns the remainder as a real.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.remainder"));
-    // Parse arguments.
-    V_real x;
-    V_real y;
-    if(reader.I().v(x).v(y).F()) {
-      Reference_root::S_temporary xref = { std_numeric_remainder(::std::move(x), ::std::move(y)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
@@ -1402,7 +1140,8 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     // `std.numeric.ldexp()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("ldexp"),
-      V_function(
+      bind_native<Native_Overload<V_real, V_real, V_integer>::Target<std_numeric_ldexp>>(
+        "std.numeric.ldexp",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.ldexp(frac, exp)`
 
@@ -1411,27 +1150,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     integer. This function is the inverse of `frexp()`.
 
   * Returns the product as a real.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.ldexp"));
-    // Parse arguments.
-    V_real frac;
-    V_integer exp;
-    if(reader.I().v(frac).v(exp).F()) {
-      Reference_root::S_temporary xref = { std_numeric_ldexp(::std::move(frac), ::std::move(exp)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.addm()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("addm"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_addm>>(
+        "std.numeric.addm",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.addm(x, y)`
 
@@ -1441,27 +1168,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     This function will not cause overflow exceptions to be thrown.
 
   * Returns the reduced sum of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.addm"));
-    // Parse arguments.
-    V_integer x;
-    V_integer y;
-    if(reader.I().v(x).v(y).F()) {
-      Reference_root::S_temporary xref = { std_numeric_addm(::std::move(x), ::std::move(y)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.subm()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("subm"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_subm>>(
+        "std.numeric.subm",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.subm(x, y)`
 
@@ -1472,27 +1187,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     exceptions to be thrown.
 
   * Returns the reduced difference of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.subm"));
-    // Parse arguments.
-    V_integer x;
-    V_integer y;
-    if(reader.I().v(x).v(y).F()) {
-      Reference_root::S_temporary xref = { std_numeric_subm(::std::move(x), ::std::move(y)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.mulm()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("mulm"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_mulm>>(
+        "std.numeric.mulm",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.mulm(x, y)`
 
@@ -1503,27 +1206,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     exceptions to be thrown.
 
   * Returns the reduced product of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.mulm"));
-    // Parse arguments.
-    V_integer x;
-    V_integer y;
-    if(reader.I().v(x).v(y).F()) {
-      Reference_root::S_temporary xref = { std_numeric_mulm(::std::move(x), ::std::move(y)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.adds()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("adds"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_adds>,
+                  Native_Overload<V_real, V_real, V_real>::Target<std_numeric_adds>>(
+        "std.numeric.adds",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.adds(x, y)`
 
@@ -1535,33 +1227,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     equivalent to the built-in addition operator.
 
   * Returns the saturated sum of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.adds"));
-    // Parse arguments.
-    V_integer ix;
-    V_integer iy;
-    if(reader.I().v(ix).v(iy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_adds(::std::move(ix), ::std::move(iy)) };
-      return self = ::std::move(xref);
-    }
-    V_real fx;
-    V_real fy;
-    if(reader.I().v(fx).v(fy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_adds(::std::move(fx), ::std::move(fy)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.subs()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("subs"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_subs>,
+                  Native_Overload<V_real, V_real, V_real>::Target<std_numeric_subs>>(
+        "std.numeric.subs",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.subs(x, y)`
 
@@ -1573,33 +1248,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     equivalent to the built-in subtraction operator.
 
   * Returns the saturated difference of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.subs"));
-    // Parse arguments.
-    V_integer ix;
-    V_integer iy;
-    if(reader.I().v(ix).v(iy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_subs(::std::move(ix), ::std::move(iy)) };
-      return self = ::std::move(xref);
-    }
-    V_real fx;
-    V_real fy;
-    if(reader.I().v(fx).v(fy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_subs(::std::move(fx), ::std::move(fy)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.muls()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("muls"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer>::Target<std_numeric_muls>,
+                  Native_Overload<V_real, V_real, V_real>::Target<std_numeric_muls>>(
+        "std.numeric.muls",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.muls(x, y)`
 
@@ -1611,33 +1269,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     equivalent to the built-in multiplication operator.
 
   * Returns the saturated product of `x` and `y`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.muls"));
-    // Parse arguments.
-    V_integer ix;
-    V_integer iy;
-    if(reader.I().v(ix).v(iy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_muls(::std::move(ix), ::std::move(iy)) };
-      return self = ::std::move(xref);
-    }
-    V_real fx;
-    V_real fy;
-    if(reader.I().v(fx).v(fy).F()) {
-      Reference_root::S_temporary xref = { std_numeric_muls(::std::move(fx), ::std::move(fy)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.lzcnt()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("lzcnt"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_lzcnt>>(
+        "std.numeric.lzcnt",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.lzcnt(x)`
 
@@ -1646,26 +1286,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Returns the bit count as an integer. If `x` is zero, `64` is
     returned.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.lzcnt"));
-    // Parse arguments.
-    V_integer x;
-    if(reader.I().v(x).F()) {
-      Reference_root::S_temporary xref = { std_numeric_lzcnt(::std::move(x)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.tzcnt()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("tzcnt"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_tzcnt>>(
+        "std.numeric.tzcnt",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.tzcnt(x)`
 
@@ -1674,26 +1303,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
 
   * Returns the bit count as an integer. If `x` is zero, `64` is
     returned.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.tzcnt"));
-    // Parse arguments.
-    V_integer x;
-    if(reader.I().v(x).F()) {
-      Reference_root::S_temporary xref = { std_numeric_tzcnt(::std::move(x)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.popcnt()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("popcnt"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_popcnt>>(
+        "std.numeric.popcnt",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.popcnt(x)`
 
@@ -1701,26 +1319,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
     integer.
 
   * Returns the bit count as an integer.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.popcnt"));
-    // Parse arguments.
-    V_integer x;
-    if(reader.I().v(x).F()) {
-      Reference_root::S_temporary xref = { std_numeric_popcnt(::std::move(x)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.rotl()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("rotl"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer, V_integer>::Target<std_numeric_rotl>>(
+        "std.numeric.rotl",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.rotl(m, x, n)`
 
@@ -1736,28 +1343,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Returns the rotated value as an integer.
 
   * Throws an exception if `m` is negative or greater than `64`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.rotl"));
-    // Parse arguments.
-    V_integer m;
-    V_integer x;
-    V_integer n;
-    if(reader.I().v(m).v(x).v(n).F()) {
-      Reference_root::S_temporary xref = { std_numeric_rotl(::std::move(m), ::std::move(x), ::std::move(n)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.rotr()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("rotr"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_integer, V_integer, V_integer>::Target<std_numeric_rotr>>(
+        "std.numeric.rotr",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.rotr(m, x, n)`
 
@@ -1773,28 +1367,16 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Returns the rotated value as an integer.
 
   * Throws an exception if `m` is negative or greater than `64`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.rotr"));
-    // Parse arguments.
-    V_integer m;
-    V_integer x;
-    V_integer n;
-    if(reader.I().v(m).v(x).v(n).F()) {
-      Reference_root::S_temporary xref = { std_numeric_rotr(::std::move(m), ::std::move(x), ::std::move(n)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.format()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("format"),
-      V_function(
+      bind_native<Native_Overload<V_string, V_integer, optV_integer, optV_integer>::Target<std_numeric_format>,
+                  Native_Overload<V_string, V_real, optV_integer, optV_integer>::Target<std_numeric_format>>(
+        "std.numeric.format",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.format(value, [base], [ebase])`
 
@@ -1815,35 +1397,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Throws an exception if `base` is neither `2` nor `10` nor `16`,
     or if `ebase` is neither `2` nor `10`, or if `base` is not `10`
     but `ebase` is `10`.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.format"));
-    // Parse arguments.
-    V_integer ivalue;
-    optV_integer base;
-    optV_integer ebase;
-    if(reader.I().v(ivalue).o(base).o(ebase).F()) {
-      Reference_root::S_temporary xref = { std_numeric_format(::std::move(ivalue), ::std::move(base),
-                                                              ::std::move(ebase)) };
-      return self = ::std::move(xref);
-    }
-    V_real fvalue;
-    if(reader.I().v(fvalue).o(base).o(ebase).F()) {
-      Reference_root::S_temporary xref = { std_numeric_format(::std::move(fvalue), ::std::move(base),
-                                                              ::std::move(ebase)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.parse_integer()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("parse_integer"),
-      V_function(
+      bind_native<Native_Overload<V_integer, V_string>::Target<std_numeric_parse_integer>>(
+        "std.numeric.parse_integer",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.parse_integer(text)`
 
@@ -1866,26 +1428,15 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Returns the integer value converted from `text`.
 
   * Throws an exception on failure.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.parse_integer"));
-    // Parse arguments.
-    V_string text;
-    if(reader.I().v(text).F()) {
-      Reference_root::S_temporary xref = { std_numeric_parse_integer(::std::move(text)) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
 
     //===================================================================
     // `std.numeric.parse_real()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("parse_real"),
-      V_function(
+      bind_native<Native_Overload<V_real, V_string, optV_boolean>::Target<std_numeric_parse_real>>(
+        "std.numeric.parse_real",
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 `std.numeric.parse_real(text, [saturating])`
 
@@ -1914,20 +1465,7 @@ create_bindings_numeric(V_object& result, API_Version /*version*/)
   * Returns the real value converted from `text`.
 
   * Throws an exception on failure.
-)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
-  {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.numeric.parse_real"));
-    // Parse arguments.
-    V_string text;
-    optV_boolean saturating;
-    if(reader.I().v(text).o(saturating).F()) {
-      Reference_root::S_temporary xref = { std_numeric_parse_real(::std::move(text), saturating) };
-      return self = ::std::move(xref);
-    }
-    // Fail.
-    reader.throw_no_matching_function_call();
-  }
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""
       ));
   }
 
@@ -6,7 +6,29 @@
 #include "../runtime/air_node.hpp"
 #include "../runtime/variable_callback.hpp"
 #include "../runtime/runtime_error.hpp"
+#include "../runtime/executive_context.hpp"
+#include "../runtime/global_context.hpp"
 #include "../utilities.hpp"
+#include <mutex>
+#include <chrono>
+#include <cxxabi.h>  // ::abi::__cxa_demangle()
+
+#if defined(__x86_64__) && defined(__linux__)
+#  define ASTERIA_AVMC_NATIVE_CODE  1
+#  include <sys/mman.h>
+#  include <unistd.h>  // ::sysconf(), ::ftruncate()
+#  include <errno.h>
+
+// This is not defined by old kernel headers.
+#  ifndef MFD_EXEC
+#    define MFD_EXEC  0x0010U
+#  endif
+
+// This is provided by the unwinder in libgcc.
+extern "C" void __register_frame(void* begin);
+#else
+#  define ASTERIA_AVMC_NATIVE_CODE  0
+#endif
 
 namespace Asteria {
 
@@ -81,6 +103,404 @@ struct AVMC_Queue::Header
       { return 1 + this->symbol_size_in_headers() + this->nphdrs;  }
   };
 
+namespace {
+
+// Generated code is called through the trampoline at the beginning of its chunk, with the
+// address of the code as the third argument.
+using JIT_Entry = AIR_Status (Executive_Context& ctx, const void** qcur, const void* code);
+
+struct JIT_Block
+  {
+    unsigned char* text;  // executable view
+    unsigned char* wtext;  // writable view of the same memory
+    JIT_Entry* entry;  // trampoline of the chunk
+  };
+
+// All statistics are linked into a circular list.
+struct Stats_Link
+  {
+    Stats_Link* prev;
+    Stats_Link* next;
+  };
+
+struct Node_Stats
+  {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t self_ns;
+  };
+
+// These are protected by `s_diag_mutex`. It is recursive, as executor names are looked
+// up while statistics are being printed.
+::std::recursive_mutex s_diag_mutex;
+Stats_Link s_stats_list = { &s_stats_list, &s_stats_list };
+AVMC_Queue::Executor_Name* s_exec_names;
+
+// This is the time spent in nested nodes, which is subtracted from self time.
+thread_local uint64_t s_nested_ns;
+
+inline
+uint64_t
+do_get_nanoseconds()
+noexcept
+  {
+    auto dur = ::std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(dur).count());
+  }
+
+cow_string
+do_get_executor_name(AVMC_Queue::Executor* exec)
+  {
+    const ::std::type_info* traits = nullptr;
+    {
+      ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+      for(auto qname = s_exec_names;  qname && !traits;  qname = qname->next)
+        if(qname->exec == exec)
+          traits = qname->traits;
+    }
+    if(!traits) {
+      ::rocket::tinyfmt_str fmt;
+      fmt << "executor " << reinterpret_cast<const void*>(exec);
+      return fmt.extract_string();
+    }
+
+    // Demangle the name of the traits class, then remove noise from it.
+    int status;
+    uptr<char, void (&)(void*)> str(::abi::__cxa_demangle(traits->name(), nullptr, nullptr, &status),
+                                    ::free);
+    cow_string name(str ? str.get() : traits->name());
+    for(const char* noise : { "Asteria::", "(anonymous namespace)::", "AIR_Node::" })
+      for(size_t pos;  (pos = name.find(noise)) != cow_string::npos;  )
+        name.erase(pos, ::std::strlen(noise));
+
+    if(name.starts_with("AIR_Traits<") && name.ends_with(">"))
+      name = name.substr(11, name.size() - 12);
+    return name;
+  }
+
+void
+do_put_hex(tinyfmt& fmt, const void* data, size_t size)
+  {
+    static constexpr char s_xdigits[] = "0123456789ABCDEF";
+    for(size_t i = 0;  i < size;  ++i) {
+      auto byte = static_cast<const unsigned char*>(data)[i];
+      fmt << s_xdigits[byte / 16] << s_xdigits[byte % 16];
+    }
+  }
+
+#if ASTERIA_AVMC_NATIVE_CODE
+
+inline
+void
+do_put_bytes(unsigned char*& ip, ::std::initializer_list<unsigned char> bytes)
+noexcept
+  {
+    for(auto byte : bytes)
+      *(ip++) = byte;
+  }
+
+template<typename IntegerT>
+inline
+void
+do_put_integer(unsigned char*& ip, IntegerT value)
+noexcept
+  {
+    ::std::memcpy(ip, &value, sizeof(value));
+    ip += sizeof(value);
+  }
+
+// These are the sizes of code that is generated for each part of a queue.
+// The trampoline is fixed, as it is described by unwind information.
+constexpr size_t s_size_trampoline = 15;
+constexpr size_t s_size_node_max = 48;
+constexpr size_t s_size_epilogue = 8;
+
+// Queues with fewer nodes than this are not compiled. They are mostly loop bodies,
+// branches and deferred expressions, for which the dispatch loop costs little, and
+// calls through the trampoline would eat up most of the gain.
+constexpr size_t s_min_jit_nodes = 8;
+
+// Code is allocated from chunks, which are shared by all queues. Blocks are powers of
+// two in size, starting from `s_jit_block_min`. Freed blocks are linked into lists by
+// size, through their first bytes. Chunks are never unmapped.
+constexpr size_t s_jit_chunk_size = 0x100000;
+constexpr size_t s_jit_block_min = 64;
+constexpr uint32_t s_jit_nclasses = 14;  // up to half a chunk
+
+// Each chunk begins with the trampoline, followed by unwind information.
+constexpr size_t s_jit_eh_frame_offset = 64;
+constexpr size_t s_jit_header_size = 256;
+
+// These are protected by `s_jit_mutex`.
+::std::mutex s_jit_mutex;
+JIT_Block s_jit_chunk;  // the chunk that blocks are being taken from
+size_t s_jit_used = s_jit_chunk_size;
+JIT_Block s_jit_free[s_jit_nclasses];
+
+// The trampoline saves registers and then jumps to code of a queue, so all code after
+// it in the same chunk shares the same stack frame layout.
+void
+do_emit_trampoline(unsigned char*& ip)
+noexcept
+  {
+    do_put_bytes(ip, { 0x53 });  // push rbx
+    do_put_bytes(ip, { 0x41, 0x54 });  // push r12
+    do_put_bytes(ip, { 0x48, 0x83, 0xEC, 0x08 });  // sub rsp, 8
+    do_put_bytes(ip, { 0x48, 0x89, 0xFB });  // mov rbx, rdi  ; `ctx`
+    do_put_bytes(ip, { 0x49, 0x89, 0xF4 });  // mov r12, rsi  ; `qcur`
+    do_put_bytes(ip, { 0xFF, 0xE2 });  // jmp rdx  ; `code`
+  }
+
+// If `pexec_opt` is not null, the executor is loaded from it, which is in the header
+// of the node, so nodes that are rebound later are not affected. Otherwise, `exec` is
+// called directly. Code is written at `ip`, and executed at `ip + xoff`.
+// The return value is the location of the displacement of the jump to the
+// epilogue, which is to be filled later, or a null pointer if this is the last node.
+unsigned char*
+do_emit_node(unsigned char*& ip, ptrdiff_t xoff, const void* uparam, const void* sparam,
+             const void* pexec_opt, void* exec, bool last)
+noexcept
+  {
+    do_put_bytes(ip, { 0x48, 0x89, 0xDF });  // mov rdi, rbx
+    do_put_bytes(ip, { 0x48, 0xBE });  // movabs rsi, `uparam`
+    do_put_integer(ip, reinterpret_cast<uint64_t>(uparam));
+    do_put_bytes(ip, { 0x49, 0x89, 0x34, 0x24 });  // mov [r12], rsi
+    do_put_bytes(ip, { 0x48, 0xBA });  // movabs rdx, `sparam`
+    do_put_integer(ip, reinterpret_cast<uint64_t>(sparam));
+
+    // Make a direct call if the target is reachable. It should be in most cases, as
+    // we try to map code near this library.
+    auto disp = reinterpret_cast<intptr_t>(exec) - reinterpret_cast<intptr_t>(ip + xoff + 5);
+    if(pexec_opt) {
+      auto off = static_cast<const char*>(pexec_opt) - static_cast<const char*>(uparam);
+      ROCKET_ASSERT((off > 0) && (off < 128));
+      do_put_bytes(ip, { 0xFF, 0x56 });  // call [rsi + `off`]
+      do_put_integer(ip, static_cast<int8_t>(off));
+    }
+    else if((disp >= INT32_MIN) && (disp <= INT32_MAX)) {
+      do_put_bytes(ip, { 0xE8 });  // call `exec`
+      do_put_integer(ip, static_cast<int32_t>(disp));
+    }
+    else {
+      do_put_bytes(ip, { 0x48, 0xB8 });  // movabs rax, `exec`
+      do_put_integer(ip, reinterpret_cast<uint64_t>(exec));
+      do_put_bytes(ip, { 0xFF, 0xD0 });  // call rax
+    }
+    if(last)
+      return nullptr;
+
+    do_put_bytes(ip, { 0x84, 0xC0 });  // test al, al
+    do_put_bytes(ip, { 0x0F, 0x85 });  // jnz `epilogue`
+    auto qdisp = ip;
+    do_put_integer(ip, int32_t(0));
+    return qdisp;
+  }
+
+void
+do_emit_epilogue(unsigned char*& ip)
+noexcept
+  {
+    do_put_bytes(ip, { 0x48, 0x83, 0xC4, 0x08 });  // add rsp, 8
+    do_put_bytes(ip, { 0x41, 0x5C });  // pop r12
+    do_put_bytes(ip, { 0x5B });  // pop rbx
+    do_put_bytes(ip, { 0xC3 });  // ret
+  }
+
+// Compose an `.eh_frame` section with a CIE and an FDE for a chunk, so exceptions can be
+// propagated through generated code. The FDE describes the trampoline, and applies to
+// all code after it.
+cow_string
+do_compose_eh_frame(const void* text, size_t size)
+  {
+    cow_string frame;
+    auto put_u32 = [&](uint32_t val) { frame.append(reinterpret_cast<const char*>(&val), 4);  };
+    auto put_u64 = [&](uint64_t val) { frame.append(reinterpret_cast<const char*>(&val), 8);  };
+    auto put_bytes = [&](::std::initializer_list<unsigned char> bytes) {
+      for(auto byte : bytes)
+        frame.push_back(static_cast<char>(byte));
+    };
+    auto finish_entry = [&](size_t offset) {
+      // Pad the entry with `DW_CFA_nop`s, then fill in its length.
+      while(frame.size() % 8 != 0)
+        frame.push_back('\0');
+      uint32_t length = static_cast<uint32_t>(frame.size() - offset - 4);
+      ::std::memcpy(frame.mut_data() + offset, &length, 4);
+    };
+
+    // CIE
+    put_u32(0);  // length
+    put_u32(0);  // CIE ID
+    put_bytes({ 1, 'z', 'R', 0 });  // version, augmentation
+    put_bytes({ 1, 0x78, 16 });  // code alignment (1), data alignment (-8), return address (rip)
+    put_bytes({ 1, 0x00 });  // augmentation data: FDE pointers are absolute
+    put_bytes({ 0x0C, 7, 8 });  // DW_CFA_def_cfa: rsp + 8
+    put_bytes({ 0x90, 1 });  // DW_CFA_offset: rip at CFA - 8
+    finish_entry(0);
+
+    // FDE
+    size_t offset = frame.size();
+    put_u32(0);  // length
+    put_u32(static_cast<uint32_t>(frame.size()));  // distance to CIE
+    put_u64(reinterpret_cast<uint64_t>(text));
+    put_u64(size);
+    put_bytes({ 0 });  // augmentation data
+    put_bytes({ 0x41, 0x0E, 16, 0x83, 2 });  // push rbx
+    put_bytes({ 0x42, 0x0E, 24, 0x8C, 3 });  // push r12
+    put_bytes({ 0x44, 0x0E, 32 });  // sub rsp, 8
+    finish_entry(offset);
+
+    // terminator
+    put_u32(0);
+    return frame;
+  }
+
+bool
+do_map_jit_chunk(JIT_Block& chunk)
+  {
+    // Executable memory is only mapped from a file that is never written through
+    // that mapping. Kernels that seal memory files against execution by default
+    // require `MFD_EXEC`, which older ones reject.
+    int fd = ::memfd_create("asteria-jit", MFD_CLOEXEC | MFD_EXEC);
+    if((fd == -1) && (errno == EINVAL))
+      fd = ::memfd_create("asteria-jit", MFD_CLOEXEC);
+    if(fd == -1)
+      return false;
+
+    if(::ftruncate(fd, s_jit_chunk_size) != 0) {
+      ::close(fd);
+      return false;
+    }
+
+    // Try mapping code near this library, so executors can be called directly.
+    size_t pgsize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    uintptr_t hint = reinterpret_cast<uintptr_t>(do_emit_node);
+    hint = (hint - (uintptr_t(1) << 30)) / pgsize * pgsize;
+    void* text = ::mmap(reinterpret_cast<void*>(hint), s_jit_chunk_size, PROT_READ | PROT_EXEC,
+                        MAP_SHARED, fd, 0);
+    void* wtext = ::mmap(nullptr, s_jit_chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if((text == MAP_FAILED) || (wtext == MAP_FAILED)) {
+      if(text != MAP_FAILED)
+        ::munmap(text, s_jit_chunk_size);
+      if(wtext != MAP_FAILED)
+        ::munmap(wtext, s_jit_chunk_size);
+      return false;
+    }
+
+    // Generate the trampoline, then register unwind information. Neither is ever
+    // released.
+    chunk.text = static_cast<unsigned char*>(text);
+    chunk.wtext = static_cast<unsigned char*>(wtext);
+    chunk.entry = reinterpret_cast<JIT_Entry*>(text);
+
+    auto ip = chunk.wtext;
+    do_emit_trampoline(ip);
+    ROCKET_ASSERT(ip - chunk.wtext == s_size_trampoline);
+
+    auto eh = do_compose_eh_frame(text, s_jit_chunk_size);
+    ROCKET_ASSERT(eh.size() <= s_jit_header_size - s_jit_eh_frame_offset);
+    ::std::memcpy(chunk.wtext + s_jit_eh_frame_offset, eh.data(), eh.size());
+    __register_frame(chunk.text + s_jit_eh_frame_offset);
+    return true;
+  }
+
+bool
+do_allocate_jit_block(JIT_Block& block, uint32_t sclass)
+  {
+    ::std::lock_guard<::std::mutex> lock(s_jit_mutex);
+
+    // Reuse a free block if any.
+    auto& head = s_jit_free[sclass];
+    if(head.text) {
+      block = head;
+      ::std::memcpy(&head, block.wtext, sizeof(head));
+      return true;
+    }
+
+    size_t size = s_jit_block_min << sclass;
+    if(s_jit_chunk_size - s_jit_used < size) {
+      JIT_Block chunk;
+      if(!do_map_jit_chunk(chunk))
+        return false;
+
+      // Put the rest of the old chunk into free lists.
+      while(s_jit_chunk_size - s_jit_used >= s_jit_block_min) {
+        uint32_t k = s_jit_nclasses - 1;
+        while((s_jit_block_min << k) > s_jit_chunk_size - s_jit_used)
+          k--;
+
+        JIT_Block rest = { s_jit_chunk.text + s_jit_used, s_jit_chunk.wtext + s_jit_used,
+                           s_jit_chunk.entry };
+        ::std::memcpy(rest.wtext, &(s_jit_free[k]), sizeof(rest));
+        s_jit_free[k] = rest;
+        s_jit_used += s_jit_block_min << k;
+      }
+
+      s_jit_chunk = chunk;
+      s_jit_used = s_jit_header_size;
+    }
+
+    block = { s_jit_chunk.text + s_jit_used, s_jit_chunk.wtext + s_jit_used, s_jit_chunk.entry };
+    s_jit_used += size;
+    return true;
+  }
+
+void
+do_free_jit_block(const JIT_Block& block, uint32_t sclass)
+noexcept
+  {
+    ::std::lock_guard<::std::mutex> lock(s_jit_mutex);
+
+    auto& head = s_jit_free[sclass];
+    ::std::memcpy(block.wtext, &head, sizeof(head));
+    head = block;
+  }
+
+#endif  // ASTERIA_AVMC_NATIVE_CODE
+
+}  // namespace
+
+struct AVMC_Queue::JIT_Code
+  : JIT_Block
+  {
+    uint32_t sclass;  // size of the block is `s_jit_block_min << sclass`
+  };
+
+struct AVMC_Queue::Statistics
+  : Stats_Link
+  {
+    const Header* bptr;  // first node
+    size_t nnodes;
+    Node_Stats nodes[0];
+
+    static
+    tinyfmt&
+    dump_nodes(tinyfmt& fmt, const Header* bptr, const Header* eptr, const Node_Stats* stats_opt)
+      {
+        size_t index = 0;
+        auto next = bptr;
+        while(next != eptr) {
+          auto qnode = next;
+          next += qnode->total_size_in_headers();
+
+          // Print the node. The first two bytes of `uparam` belong to the header.
+          fmt << "  #" << index << "  " << do_get_executor_name(qnode->executor()) << "  up ";
+          do_put_hex(fmt, reinterpret_cast<const char*>(::std::addressof(qnode->uparam())) + 2,
+                     sizeof(Uparam) - 2);
+          fmt << "  sp " << (qnode->nphdrs * sizeof(Header)) << "B";
+          if(auto qsyms = qnode->syms_opt())
+            fmt << "  @ " << qsyms->sloc;
+          if(stats_opt) {
+            const auto& r = stats_opt[index];
+            fmt << "  count " << r.count << "  total " << r.total_ns << "ns  self " << r.self_ns << "ns";
+          }
+          fmt << '\n';
+          index++;
+        }
+        return fmt;
+      }
+  };
+
 void
 AVMC_Queue::
 do_destroy_nodes()
@@ -110,6 +530,13 @@ void
 AVMC_Queue::
 do_reallocate(uint32_t nadd)
   {
+    // Native code and statistics refer to nodes by address.
+    if(this->m_jit)
+      this->do_release_native_code();
+
+    if(this->m_stats)
+      this->do_release_statistics();
+
     constexpr size_t nhdrs_max = UINT32_MAX / sizeof(Header);
     if(nhdrs_max - this->m_used < nadd)
       throw ::std::bad_array_new_length();
@@ -235,11 +662,220 @@ do_append_nontrivial(const Vtable* vtbl, Uparam uparam, opt<Symbols>&& syms_opt,
     this->m_used += qnode->total_size_in_headers();
   }
 
+void
+AVMC_Queue::
+rebind_executor(const Uparam& uparam, Executor& exec)
+noexcept
+  {
+    // `uparam` is the first member of the header of the node.
+    auto qnode = reinterpret_cast<Header*>(const_cast<Uparam*>(::std::addressof(uparam)));
+    ROCKET_ASSERT(!qnode->has_vtbl);
+    qnode->exec = exec;
+  }
+
+bool
+AVMC_Queue::
+do_generate_native_code()
+const
+  {
+#if ASTERIA_AVMC_NATIVE_CODE
+    ROCKET_ASSERT(!this->m_jit);
+
+    // Count nodes to estimate the size of code.
+    size_t nnodes = 0;
+    auto eptr = this->m_bptr + this->m_used;
+    auto next = this->m_bptr;
+    while(ROCKET_EXPECT(next != eptr)) {
+      next += next->total_size_in_headers();
+      nnodes++;
+    }
+    if(nnodes < s_min_jit_nodes)
+      return false;
+
+    // Allocate a block that is large enough.
+    size_t size = nnodes * s_size_node_max + s_size_epilogue;
+    uint32_t sclass = 0;
+    while((s_jit_block_min << sclass) < size)
+      if(++sclass == s_jit_nclasses)
+        return false;
+
+    JIT_Block block;
+    if(!do_allocate_jit_block(block, sclass))
+      return false;
+
+    // Generate code through the writable view.
+    auto bptr = block.wtext;
+    auto ip = bptr;
+    auto xoff = block.text - block.wtext;
+
+    cow_vector<unsigned char*> jumps;
+    next = this->m_bptr;
+    while(ROCKET_EXPECT(next != eptr)) {
+      auto qnode = next;
+      next += qnode->total_size_in_headers();
+
+      auto qdisp = do_emit_node(ip, xoff, ::std::addressof(qnode->uparam()), qnode->sparam(),
+                                qnode->has_vtbl ? nullptr : ::std::addressof(qnode->exec),
+                                reinterpret_cast<void*>(qnode->executor()), next == eptr);
+      if(qdisp)
+        jumps.emplace_back(qdisp);
+    }
+
+    // All nodes jump to the epilogue if they return a status other than `air_status_next`.
+    // The last one falls through with its status.
+    for(auto qdisp : jumps)
+      do_put_integer(qdisp, static_cast<int32_t>(ip - (qdisp + 4)));
+    do_emit_epilogue(ip);
+    ROCKET_ASSERT(static_cast<size_t>(ip - bptr) <= size);
+
+    auto qjit = new JIT_Code;
+    static_cast<JIT_Block&>(*qjit) = block;
+    qjit->sclass = sclass;
+    this->m_jit = qjit;
+    return true;
+#else
+    return false;
+#endif
+  }
+
+void
+AVMC_Queue::
+do_release_native_code()
+const noexcept
+  {
+    auto qjit = ::std::exchange(this->m_jit, nullptr);
+    ROCKET_ASSERT(qjit);
+#if ASTERIA_AVMC_NATIVE_CODE
+    do_free_jit_block(*qjit, qjit->sclass);
+#endif
+    delete qjit;
+
+    // Start counting again.
+    this->m_nexec = 0;
+  }
+
+AIR_Status
+AVMC_Queue::
+do_execute_native_code(Executive_Context& ctx)
+const
+  {
+    // Generated code stores the address of each node into `qnode` before calling its
+    // executor, so we know where an exception was thrown.
+    const void* qnode = nullptr;
+    ASTERIA_RUNTIME_TRY {
+      return this->m_jit->entry(ctx, &qnode, this->m_jit->text);
+    }
+    ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
+      ROCKET_ASSERT(qnode);
+      if(auto qsyms = static_cast<const Header*>(qnode)->syms_opt())
+        except.push_frame_plain(qsyms->sloc, ::rocket::sref(""));
+      throw;
+    }
+  }
+
+void
+AVMC_Queue::
+do_release_statistics()
+const noexcept
+  {
+    auto qstats = ::std::exchange(this->m_stats, nullptr);
+    ROCKET_ASSERT(qstats);
+    {
+      ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+      qstats->prev->next = qstats->next;
+      qstats->next->prev = qstats->prev;
+    }
+    qstats->~Statistics();
+    ::operator delete(qstats);
+  }
+
+AIR_Status
+AVMC_Queue::
+do_execute_with_statistics(Executive_Context& ctx)
+const
+  {
+    auto eptr = this->m_bptr + this->m_used;
+    auto next = this->m_bptr;
+
+    if(!this->m_stats) {
+      // Allocate statistics for all nodes.
+      size_t nnodes = 0;
+      while(next != eptr) {
+        next += next->total_size_in_headers();
+        nnodes++;
+      }
+      next = this->m_bptr;
+
+      auto qstats = ::new(::operator new(sizeof(Statistics) + nnodes * sizeof(Node_Stats))) Statistics();
+      qstats->bptr = this->m_bptr;
+      qstats->nnodes = nnodes;
+      ::std::memset(qstats->nodes, 0, nnodes * sizeof(Node_Stats));
+      {
+        ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+        qstats->prev = s_stats_list.prev;
+        qstats->next = &s_stats_list;
+        qstats->prev->next = qstats;
+        s_stats_list.prev = qstats;
+      }
+      this->m_stats = qstats;
+    }
+
+    auto qstat = this->m_stats->nodes;
+    while(ROCKET_EXPECT(next != eptr)) {
+      auto qnode = next;
+      next += qnode->total_size_in_headers();
+
+      // Time spent in nodes that are executed by this one is accumulated into `s_nested_ns`,
+      // which is then subtracted from its own time.
+      uint64_t outer_ns = ::std::exchange(s_nested_ns, 0);
+      uint64_t start_ns = do_get_nanoseconds();
+      auto record = [&] {
+        uint64_t total_ns = do_get_nanoseconds() - start_ns;
+        qstat->count++;
+        qstat->total_ns += total_ns;
+        qstat->self_ns += total_ns - s_nested_ns;
+        s_nested_ns = outer_ns + total_ns;
+        qstat++;
+      };
+
+      // Call the executor function for this node.
+      AIR_Status status;
+      ASTERIA_RUNTIME_TRY {
+        status = qnode->executor()(ctx, qnode->uparam(), qnode->sparam());
+      }
+      ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
+        record();
+        if(auto qsyms = qnode->syms_opt())
+          except.push_frame_plain(qsyms->sloc, ::rocket::sref(""));
+        throw;
+      }
+      record();
+      if(ROCKET_UNEXPECT(status != air_status_next))
+        return status;
+    }
+    return air_status_next;
+  }
+
 AIR_Status
 AVMC_Queue::
 execute(Executive_Context& ctx)
 const
   {
+    auto& global = ctx.global();
+    if(ROCKET_UNEXPECT(global.is_node_statistics_enabled()))
+      return this->do_execute_with_statistics(ctx);
+
+    // Generate native code for queues that are executed frequently. If this fails,
+    // don't try again.
+    if(ROCKET_UNEXPECT(!this->m_jit)) {
+      uint32_t threshold = global.get_jit_threshold();
+      if(threshold && (this->m_nexec != UINT32_MAX) && (++(this->m_nexec) >= threshold))
+        if(!this->do_generate_native_code())
+          this->m_nexec = UINT32_MAX;
+    }
+    if(this->m_jit)
+      return this->do_execute_native_code(ctx);
+
     auto eptr = this->m_bptr + this->m_used;
     auto next = this->m_bptr;
     while(ROCKET_EXPECT(next != eptr)) {
@@ -280,4 +916,90 @@ const
     return callback;
   }
 
+void
+AVMC_Queue::
+register_executor(Executor_Name& name)
+noexcept
+  {
+    ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+    name.next = s_exec_names;
+    s_exec_names = &name;
+  }
+
+tinyfmt&
+AVMC_Queue::
+dump(tinyfmt& fmt)
+const
+  {
+    return Statistics::dump_nodes(fmt, this->m_bptr, this->m_bptr + this->m_used,
+                                  this->m_stats ? this->m_stats->nodes : nullptr);
+  }
+
+tinyfmt&
+AVMC_Queue::
+print_statistics(tinyfmt& fmt)
+  {
+    struct Line_Stats
+      {
+        cow_string line;
+        uint64_t count;
+        uint64_t self_ns;
+      };
+
+    cow_dictionary<size_t> line_indices;
+    cow_vector<Line_Stats> lines;
+
+    ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+    for(auto qlink = s_stats_list.next;  qlink != &s_stats_list;  qlink = qlink->next) {
+      auto qstats = static_cast<const Statistics*>(qlink);
+      fmt << "queue " << static_cast<const void*>(qstats->bptr) << " (" << qstats->nnodes << " nodes)\n";
+      auto next = qstats->bptr;
+      for(size_t i = 0;  i < qstats->nnodes;  ++i)
+        next += next->total_size_in_headers();
+      Statistics::dump_nodes(fmt, qstats->bptr, next, qstats->nodes);
+
+      // Accumulate self time by source line.
+      next = qstats->bptr;
+      for(size_t i = 0;  i < qstats->nnodes;  ++i) {
+        auto qnode = next;
+        next += qnode->total_size_in_headers();
+
+        ::rocket::tinyfmt_str lfmt;
+        if(auto qsyms = qnode->syms_opt())
+          lfmt << qsyms->sloc.file() << ':' << qsyms->sloc.line();
+        else
+          lfmt << "<unknown>";
+        auto line = lfmt.extract_string();
+
+        auto pair = line_indices.try_emplace(line, lines.size());
+        if(pair.second) {
+          Line_Stats r = { line, 0, 0 };
+          lines.emplace_back(::std::move(r));
+        }
+        auto& r = lines.mut(pair.first->second);
+        r.count += qstats->nodes[i].count;
+        r.self_ns += qstats->nodes[i].self_ns;
+      }
+    }
+
+    ::std::sort(lines.mut_begin(), lines.mut_end(),
+                [](const Line_Stats& x, const Line_Stats& y) { return x.self_ns > y.self_ns;  });
+    fmt << "self time by line\n";
+    for(const auto& r : lines)
+      fmt << "  " << r.line << "  count " << r.count << "  self " << r.self_ns << "ns\n";
+    return fmt;
+  }
+
+void
+AVMC_Queue::
+clear_statistics()
+noexcept
+  {
+    ::std::lock_guard<::std::recursive_mutex> lock(s_diag_mutex);
+    for(auto qlink = s_stats_list.next;  qlink != &s_stats_list;  qlink = qlink->next) {
+      auto qstats = static_cast<Statistics*>(qlink);
+      ::std::memset(qstats->nodes, 0, qstats->nnodes * sizeof(Node_Stats));
+    }
+  }
+
 }  // namespace Asteria
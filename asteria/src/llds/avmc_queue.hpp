@@ -54,9 +54,17 @@ class AVMC_Queue
     using Constructor  = void (Uparam uparam, void* sparam, intptr_t ctor_arg);
     using Move_Ctor    = void (Uparam uparam, void* sparam, void* sp_old);
     using Destructor   = void (Uparam uparam, void* sparam);
-    using Executor     = AIR_Status (Executive_Context& ctx, Uparam uparam, const void* sparam);
+    using Executor     = AIR_Status (Executive_Context& ctx, const Uparam& uparam, const void* sparam);
     using Enumerator   = Variable_Callback& (Variable_Callback& callback, Uparam uparam, const void* sparam);
 
+    // This names an executor in dumps.
+    struct Executor_Name
+      {
+        Executor* exec;
+        const ::std::type_info* traits;
+        Executor_Name* next;
+      };
+
   private:
     struct Vtable
       {
@@ -67,12 +75,18 @@ class AVMC_Queue
       };
 
     struct Header;
+    struct JIT_Code;
+    struct Statistics;
 
   private:
     Header* m_bptr = nullptr;  // beginning of raw storage
     uint32_t m_rsrv = 0;  // size of raw storage, in number of `Header`s [!]
     uint32_t m_used = 0;  // size of used storage, in number of `Header`s [!]
 
+    mutable uint32_t m_nexec = 0;  // number of executions before native code is generated
+    mutable JIT_Code* m_jit = nullptr;  // native code, if any
+    mutable Statistics* m_stats = nullptr;  // per-node statistics, if any
+
   public:
     constexpr
     AVMC_Queue()
@@ -90,6 +104,12 @@ class AVMC_Queue
 
     ~AVMC_Queue()
       {
+        if(this->m_jit)
+          this->do_release_native_code();
+
+        if(this->m_stats)
+          this->do_release_statistics();
+
         if(this->m_used)
           this->do_destroy_nodes();
 
@@ -106,6 +126,32 @@ class AVMC_Queue
     do_destroy_nodes()
     noexcept;
 
+    // Native code is generated for queues that are executed frequently. It calls
+    // executors in the same way as `execute()`, but without the dispatch loop. Its
+    // memory is taken from an arena which is shared by all queues.
+    // Native code refers to nodes by address, so it has to be released before nodes
+    // are relocated or destroyed.
+    bool
+    do_generate_native_code()
+    const;
+
+    void
+    do_release_native_code()
+    const noexcept;
+
+    AIR_Status
+    do_execute_native_code(Executive_Context& ctx)
+    const;
+
+    // Statistics are collected by node and refer to nodes by address, too.
+    void
+    do_release_statistics()
+    const noexcept;
+
+    AIR_Status
+    do_execute_with_statistics(Executive_Context& ctx)
+    const;
+
     void
     do_reallocate(uint32_t nadd);
 
@@ -194,11 +240,18 @@ class AVMC_Queue
     clear()
     noexcept
       {
+        if(this->m_jit)
+          this->do_release_native_code();
+
+        if(this->m_stats)
+          this->do_release_statistics();
+
         if(this->m_used)
           this->do_destroy_nodes();
 
         // Clean invalid data up.
         this->m_used = 0;
+        this->m_nexec = 0;
         return *this;
       }
 
@@ -219,6 +272,9 @@ class AVMC_Queue
         ::std::swap(this->m_bptr, other.m_bptr);
         ::std::swap(this->m_rsrv, other.m_rsrv);
         ::std::swap(this->m_used, other.m_used);
+        ::std::swap(this->m_nexec, other.m_nexec);
+        ::std::swap(this->m_jit, other.m_jit);
+        ::std::swap(this->m_stats, other.m_stats);
         return *this;
       }
 
@@ -323,6 +379,14 @@ class AVMC_Queue
         return *this;
       }
 
+    // Replace the executor of a trivial node.
+    // This may be called by an executor to specialize the node that it belongs to, after
+    // observing its operands. `uparam` shall be the argument that has been passed to it.
+    static
+    void
+    rebind_executor(const Uparam& uparam, Executor& exec)
+    noexcept;
+
     // These are interfaces called by the runtime.
     AIR_Status
     execute(Executive_Context& ctx)
@@ -331,6 +395,33 @@ class AVMC_Queue
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
     const;
+
+    // Name an executor after the traits class that implements it, which is printed by
+    // `dump()`. This is called once for each executor. `name` is linked into a global list
+    // and must have static storage duration, so no memory is allocated.
+    static
+    void
+    register_executor(Executor_Name& name)
+    noexcept;
+
+    // Print all nodes, one per line, with their kinds, parameters, source locations and
+    // statistics if any.
+    tinyfmt&
+    dump(tinyfmt& fmt)
+    const;
+
+    // If `Global_Context::is_node_statistics_enabled()`, the number of executions and
+    // the time spent in each node are collected. Total time includes nested nodes, such
+    // as loop bodies, while self time excludes them. This prints all queues that have
+    // statistics, followed by self time by source line, in descending order.
+    static
+    tinyfmt&
+    print_statistics(tinyfmt& fmt);
+
+    static
+    void
+    clear_statistics()
+    noexcept;
   };
 
 inline
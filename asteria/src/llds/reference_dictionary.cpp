@@ -13,20 +13,15 @@ Reference_Dictionary::
 do_destroy_buckets()
 noexcept
   {
-    auto next = this->m_head;
-    while(ROCKET_EXPECT(next)) {
-      auto qbkt = next;
-      next = qbkt->next;
+    for(size_t i = 0;  i != this->m_size;  ++i) {
+      auto qbkt = this->m_sptr[i];
 
       // Destroy this bucket.
       ROCKET_ASSERT(*qbkt);
       ::rocket::destroy_at(qbkt->kstor);
       ::rocket::destroy_at(qbkt->vstor);
-      qbkt->next = nullptr;
+      qbkt->slot = SIZE_MAX;
     }
-#ifdef ROCKET_DEBUG
-    this->m_head = reinterpret_cast<Bucket*>(0xDEADBEEF);
-#endif
   }
 
 Reference_Dictionary::Bucket*
@@ -47,6 +42,21 @@ noexcept
     return qbkt;
   }
 
+Reference_Dictionary::Bucket*
+Reference_Dictionary::
+do_xfind_unhashed(const phsh_string& name)
+const
+noexcept
+  {
+    // Search backwards, so the last one of duplicate parameters is found.
+    for(size_t i = this->m_usize - 1;  i != SIZE_MAX;  --i) {
+      auto qbkt = this->m_ubptr + i;
+      if(qbkt->kstor[0] == name)
+        return qbkt;
+    }
+    return nullptr;
+  }
+
 void
 Reference_Dictionary::
 do_xrelocate_but(Bucket* qxcld)
@@ -65,11 +75,11 @@ noexcept
 
         // Move the old name and reference out, then destroy the bucket.
         ROCKET_ASSERT(*qbkt);
+        auto slot = ::std::exchange(qbkt->slot, SIZE_MAX);
         auto name = ::std::move(qbkt->kstor[0]);
         ::rocket::destroy_at(qbkt->kstor);
         auto refr = ::std::move(qbkt->vstor[0]);
         ::rocket::destroy_at(qbkt->vstor);
-        this->do_list_detach(qbkt);
 
         // Find a new bucket for the name using linear probing.
         // Uniqueness has already been implied for all elements, so there is no need to check for collisions.
@@ -77,9 +87,10 @@ noexcept
         qbkt = ::rocket::linear_probe(bptr, mptr, mptr, eptr, [&](const Bucket&) { return false;  });
         ROCKET_ASSERT(qbkt);
 
-        // Insert the reference into the new bucket.
+        // Insert the reference into the new bucket, keeping its slot.
         ROCKET_ASSERT(!*qbkt);
-        this->do_list_attach(qbkt);
+        qbkt->slot = slot;
+        this->m_sptr[slot] = qbkt;
         ::rocket::construct_at(qbkt->kstor, ::std::move(name));
         ::rocket::construct_at(qbkt->vstor, ::std::move(refr));
         // Keep probing until an empty bucket is found.
@@ -87,77 +98,57 @@ noexcept
       });
   }
 
-void
-Reference_Dictionary::
-do_list_attach(Bucket* qbkt)
-noexcept
-  {
-    // Insert the bucket before `head`.
-    auto next = ::std::exchange(this->m_head, qbkt);
-    // Update the forward list, which is non-circular.
-    qbkt->next = next;
-    // Update the backward list, which is circular.
-    qbkt->prev = next ? ::std::exchange(next->prev, qbkt) : qbkt;
-  }
-
-void
-Reference_Dictionary::
-do_list_detach(Bucket* qbkt)
-noexcept
-  {
-    auto next = qbkt->next;
-    auto prev = qbkt->prev;
-    auto head = this->m_head;
-
-    // Update the forward list, which is non-circular.
-    ((qbkt == head) ? this->m_head : prev->next) = next;
-    // Update the backward list, which is circular.
-    (next ? next : head)->prev = prev;
-    // Mark the bucket empty.
-    qbkt->prev = nullptr;
-  }
-
 void
 Reference_Dictionary::
 do_rehash(size_t nbkt)
   {
     ROCKET_ASSERT(nbkt / 2 > this->m_size);
-    // Allocate a new table.
-    if(nbkt > PTRDIFF_MAX / sizeof(Bucket))
+    // Allocate a new table. The slot table follows buckets.
+    if(nbkt > PTRDIFF_MAX / (sizeof(Bucket) + sizeof(Bucket*)))
       throw ::std::bad_array_new_length();
-    auto bptr = static_cast<Bucket*>(::operator new(nbkt * sizeof(Bucket)));
+    auto bptr = static_cast<Bucket*>(::operator new(nbkt * (sizeof(Bucket) + sizeof(Bucket*))));
     auto eptr = bptr + nbkt;
+    auto sptr = reinterpret_cast<Bucket**>(eptr);
 
     // Initialize an empty table.
     for(auto qbkt = bptr;  qbkt != eptr;  ++qbkt)
-      qbkt->prev = nullptr;
+      qbkt->slot = SIZE_MAX;
     auto bold = ::std::exchange(this->m_bptr, bptr);
-    this->m_eptr = eptr;
+    auto eold = ::std::exchange(this->m_eptr, eptr);
+    this->m_sptr = sptr;
 
-    // Move buckets into the new table.
+    // Unhashed buckets are not moved.
+    for(size_t i = 0;  i != this->m_usize;  ++i) {
+      auto qbkt = this->m_ubptr + i;
+      ROCKET_ASSERT(*qbkt);
+      sptr[qbkt->slot] = qbkt;
+    }
+
+    // Move buckets into the new table, preserving their slots.
     // Warning: No exception shall be thrown from the code below.
-    auto next = ::std::exchange(this->m_head, nullptr);
-    while(ROCKET_EXPECT(next)) {
-      auto qbkt = next;
-      next = qbkt->next;
+    for(auto qold = bold;  qold != eold;  ++qold) {
+      if(!*qold)
+        continue;
 
       // Move the old name and reference out, then destroy the bucket.
-      ROCKET_ASSERT(*qbkt);
-      auto name = ::std::move(qbkt->kstor[0]);
-      ::rocket::destroy_at(qbkt->kstor);
-      auto refr = ::std::move(qbkt->vstor[0]);
-      ::rocket::destroy_at(qbkt->vstor);
-      qbkt->prev = nullptr;
+      auto slot = qold->slot;
+      ROCKET_ASSERT(slot < this->m_size);
+      auto name = ::std::move(qold->kstor[0]);
+      ::rocket::destroy_at(qold->kstor);
+      auto refr = ::std::move(qold->vstor[0]);
+      ::rocket::destroy_at(qold->vstor);
+      qold->slot = SIZE_MAX;
 
       // Find a new bucket for the name using linear probing.
       // Uniqueness has already been implied for all elements, so there is no need to check for collisions.
       auto mptr = ::rocket::get_probing_origin(bptr, eptr, name.rdhash());
-      qbkt = ::rocket::linear_probe(bptr, mptr, mptr, eptr, [&](const Bucket&) { return false;  });
+      auto qbkt = ::rocket::linear_probe(bptr, mptr, mptr, eptr, [&](const Bucket&) { return false;  });
       ROCKET_ASSERT(qbkt);
 
       // Insert the reference into the new bucket.
       ROCKET_ASSERT(!*qbkt);
-      this->do_list_attach(qbkt);
+      qbkt->slot = slot;
+      sptr[slot] = qbkt;
       ::rocket::construct_at(qbkt->kstor, ::std::move(name));
       ::rocket::construct_at(qbkt->vstor, ::std::move(refr));
     }
@@ -166,18 +157,56 @@ do_rehash(size_t nbkt)
       ::operator delete(bold);
   }
 
+void
+Reference_Dictionary::
+do_reserve_unhashed(size_t ucap)
+  {
+    ROCKET_ASSERT(ucap > this->m_usize);
+    // Allocate new storage.
+    if(ucap > PTRDIFF_MAX / sizeof(Bucket))
+      throw ::std::bad_array_new_length();
+    auto ubptr = static_cast<Bucket*>(::operator new(ucap * sizeof(Bucket)));
+
+    // Initialize empty buckets.
+    for(auto qbkt = ubptr;  qbkt != ubptr + ucap;  ++qbkt)
+      qbkt->slot = SIZE_MAX;
+    auto ubold = ::std::exchange(this->m_ubptr, ubptr);
+    this->m_ucap = ucap;
+
+    // Move buckets into the new storage, preserving their slots.
+    // Warning: No exception shall be thrown from the code below.
+    for(size_t i = 0;  i != this->m_usize;  ++i) {
+      auto qold = ubold + i;
+      auto qbkt = ubptr + i;
+
+      // Move the old name and reference into the new bucket, then destroy the old one.
+      ROCKET_ASSERT(*qold);
+      qbkt->slot = ::std::exchange(qold->slot, SIZE_MAX);
+      this->m_sptr[qbkt->slot] = qbkt;
+      ::rocket::construct_at(qbkt->kstor, ::std::move(qold->kstor[0]));
+      ::rocket::destroy_at(qold->kstor);
+      ::rocket::construct_at(qbkt->vstor, ::std::move(qold->vstor[0]));
+      ::rocket::destroy_at(qold->vstor);
+    }
+    // Deallocate the old storage.
+    if(ubold)
+      ::operator delete(ubold);
+  }
+
 void
 Reference_Dictionary::
 do_attach(Bucket* qbkt, const phsh_string& name)
 noexcept
   {
-    // Construct the node, then attach it.
+    // Construct the node, then attach it to the next slot.
     ROCKET_ASSERT(!*qbkt);
-    this->do_list_attach(qbkt);
+    size_t slot = this->m_size;
     ::rocket::construct_at(qbkt->kstor, name);
     ::rocket::construct_at(qbkt->vstor, Reference_root::S_void());
+    qbkt->slot = slot;
+    this->m_sptr[slot] = qbkt;
     ROCKET_ASSERT(*qbkt);
-    this->m_size++;
+    this->m_size = slot + 1;
   }
 
 void
@@ -186,26 +215,63 @@ do_detach(Bucket* qbkt)
 noexcept
   {
     // Destroy the old name and reference, then detach the bucket.
-    this->m_size--;
     ROCKET_ASSERT(*qbkt);
+    auto slot = ::std::exchange(qbkt->slot, SIZE_MAX);
     ::rocket::destroy_at(qbkt->kstor);
     ::rocket::destroy_at(qbkt->vstor);
-    this->do_list_detach(qbkt);
     ROCKET_ASSERT(!*qbkt);
 
+    // Fill the hole in the slot table with the last element.
+    size_t last = --(this->m_size);
+    if(slot != last) {
+      auto qlast = this->m_sptr[last];
+      qlast->slot = slot;
+      this->m_sptr[slot] = qlast;
+    }
+
     // Relocate nodes that follow `qbkt`, if any.
     this->do_xrelocate_but(qbkt);
   }
 
+void
+Reference_Dictionary::
+do_detach_unhashed(Bucket* qbkt)
+noexcept
+  {
+    // Destroy the old name and reference, then detach the bucket.
+    ROCKET_ASSERT(*qbkt);
+    auto slot = ::std::exchange(qbkt->slot, SIZE_MAX);
+    ::rocket::destroy_at(qbkt->kstor);
+    ::rocket::destroy_at(qbkt->vstor);
+    ROCKET_ASSERT(!*qbkt);
+
+    // Fill the hole in the slot table with the last element.
+    size_t last = --(this->m_size);
+    if(slot != last) {
+      auto qlast = this->m_sptr[last];
+      qlast->slot = slot;
+      this->m_sptr[slot] = qlast;
+    }
+
+    // Fill the hole in unhashed buckets with the last one.
+    auto qlast = this->m_ubptr + --(this->m_usize);
+    if(qbkt != qlast) {
+      qbkt->slot = ::std::exchange(qlast->slot, SIZE_MAX);
+      this->m_sptr[qbkt->slot] = qbkt;
+      ::rocket::construct_at(qbkt->kstor, ::std::move(qlast->kstor[0]));
+      ::rocket::destroy_at(qlast->kstor);
+      ::rocket::construct_at(qbkt->vstor, ::std::move(qlast->vstor[0]));
+      ::rocket::destroy_at(qlast->vstor);
+    }
+  }
+
 Variable_Callback&
 Reference_Dictionary::
 enumerate_variables(Variable_Callback& callback)
 const
   {
-    auto next = this->m_head;
-    while(ROCKET_EXPECT(next)) {
-      auto qbkt = next;
-      next = qbkt->next;
+    for(size_t i = 0;  i != this->m_size;  ++i) {
+      auto qbkt = this->m_sptr[i];
 
       // Enumerate child variables.
       ROCKET_ASSERT(*qbkt);
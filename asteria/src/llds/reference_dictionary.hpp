@@ -14,10 +14,9 @@ class Reference_Dictionary
   private:
     struct Bucket
       {
-        Bucket* next;  // the next bucket in the [non-circular] list
-        Bucket* prev;  // the previous bucket in the [circular] list
-        union { phsh_string kstor[1];  };  // initialized iff `prev` is non-null
-        union { Reference vstor[1];  };  // initialized iff `prev` is non-null
+        size_t slot;  // index into the slot table; `SIZE_MAX` iff empty
+        union { phsh_string kstor[1];  };  // initialized iff `slot` is valid
+        union { Reference vstor[1];  };  // initialized iff `slot` is valid
 
         Bucket()
         { }
@@ -28,13 +27,17 @@ class Reference_Dictionary
         explicit operator
         bool()
         const noexcept
-          { return this->prev != nullptr;  }
+          { return this->slot != SIZE_MAX;  }
       };
 
     Bucket* m_bptr = nullptr;  // beginning of bucket storage
     Bucket* m_eptr = nullptr;  // end of bucket storage
-    Bucket* m_head = nullptr;  // the first initialized bucket
-    size_t m_size = 0;         // number of initialized buckets
+    Bucket** m_sptr = nullptr;  // slot table, in order of insertion
+    size_t m_size = 0;         // number of initialized buckets, including unhashed ones
+
+    Bucket* m_ubptr = nullptr;  // beginning of unhashed bucket storage
+    size_t m_ucap = 0;          // capacity of unhashed bucket storage
+    size_t m_usize = 0;         // number of initialized unhashed buckets
 
   public:
     constexpr
@@ -53,12 +56,15 @@ class Reference_Dictionary
 
     ~Reference_Dictionary()
       {
-        if(this->m_head)
+        if(this->m_size)
           this->do_destroy_buckets();
 
         if(this->m_bptr)
           ::operator delete(this->m_bptr);
 
+        if(this->m_ubptr)
+          ::operator delete(this->m_ubptr);
+
 #ifdef ROCKET_DEBUG
         ::std::memset(static_cast<void*>(this), 0xA6, sizeof(*this));
 #endif
@@ -75,27 +81,26 @@ class Reference_Dictionary
     do_xprobe(const phsh_string& name)
     const noexcept;
 
+    // This function searches unhashed buckets for `name`, starting from the last one.
+    // A null pointer is returned if none is found.
+    Bucket*
+    do_xfind_unhashed(const phsh_string& name)
+    const noexcept;
+
     // This function is used for relocation after an element is erased.
     inline
     void
     do_xrelocate_but(Bucket* qxcld)
     noexcept;
 
-    // Valid buckets are linked altogether for efficient iteration.
-    inline
-    void
-    do_list_attach(Bucket* qbkt)
-    noexcept;
-
-    inline
-    void
-    do_list_detach(Bucket* qbkt)
-    noexcept;
-
     // This function is primarily used to reallocate a larger table.
     void
     do_rehash(size_t nbkt);
 
+    // This function reallocates storage for unhashed buckets.
+    void
+    do_reserve_unhashed(size_t ucap);
+
     // This functions stores `var` in the bucket `*qbkt`.
     // `*qbkt` must be empty.
     void
@@ -108,27 +113,38 @@ class Reference_Dictionary
     do_detach(Bucket* qbkt)
     noexcept;
 
+    // This functions clears the unhashed bucket `*qbkt`
+    // `*qbkt` must not be empty.
+    void
+    do_detach_unhashed(Bucket* qbkt)
+    noexcept;
+
   public:
     bool
     empty()
     const noexcept
-      { return this->m_head == nullptr;  }
+      { return this->m_size == 0;  }
 
     size_t
     size()
     const noexcept
       { return this->m_size;  }
 
+    size_t
+    bucket_count()
+    const noexcept
+      { return static_cast<size_t>(this->m_eptr - this->m_bptr);  }
+
     Reference_Dictionary&
     clear()
     noexcept
       {
-        if(this->m_head)
+        if(this->m_size)
           this->do_destroy_buckets();
 
         // Clean invalid data up.
-        this->m_head = nullptr;
         this->m_size = 0;
+        this->m_usize = 0;
         return *this;
       }
 
@@ -138,8 +154,11 @@ class Reference_Dictionary
       {
         ::std::swap(this->m_bptr, other.m_bptr);
         ::std::swap(this->m_eptr, other.m_eptr);
-        ::std::swap(this->m_head, other.m_head);
+        ::std::swap(this->m_sptr, other.m_sptr);
         ::std::swap(this->m_size, other.m_size);
+        ::std::swap(this->m_ubptr, other.m_ubptr);
+        ::std::swap(this->m_ucap, other.m_ucap);
+        ::std::swap(this->m_usize, other.m_usize);
         return *this;
       }
 
@@ -154,12 +173,49 @@ class Reference_Dictionary
         // Find the bucket for the name.
         auto qbkt = this->do_xprobe(name);
         if(!*qbkt)
+          qbkt = this->do_xfind_unhashed(name);
+        if(!qbkt)
           return nullptr;
 
         ROCKET_ASSERT(qbkt->kstor[0].rdhash() == name.rdhash());
         return qbkt->vstor;
       }
 
+    // Slots are assigned in the order of insertion, so contexts that declare the same
+    // names in the same order have the same slots. `slot` is merely a hint: if it does
+    // not designate `name`, a null pointer is returned and the name has to be looked up.
+    const Reference*
+    get_opt(size_t slot, const phsh_string& name)
+    const noexcept
+      {
+        if(ROCKET_UNEXPECT(slot >= this->m_size))
+          return nullptr;
+
+        auto qbkt = this->m_sptr[slot];
+        if(ROCKET_UNEXPECT(qbkt->kstor[0] != name))
+          return nullptr;
+
+        return qbkt->vstor;
+      }
+
+    size_t
+    find_slot(const phsh_string& name)
+    const noexcept
+      {
+        // Be advised that `do_xprobe()` shall not be called when the table has not been allocated.
+        if(!this->m_bptr)
+          return SIZE_MAX;
+
+        // Find the bucket for the name.
+        auto qbkt = this->do_xprobe(name);
+        if(!*qbkt)
+          qbkt = this->do_xfind_unhashed(name);
+        if(!qbkt)
+          return SIZE_MAX;
+
+        return qbkt->slot;
+      }
+
     Reference&
     open(const phsh_string& name)
       {
@@ -174,11 +230,40 @@ class Reference_Dictionary
         if(*qbkt)
           return qbkt->vstor[0];
 
+        // The name may have been appended without being hashed.
+        auto qubkt = this->do_xfind_unhashed(name);
+        if(qubkt)
+          return qubkt->vstor[0];
+
         // Construct a null reference and return it.
         this->do_attach(qbkt, name);
         return qbkt->vstor[0];
       }
 
+    // This function appends a reference to the next slot without hashing `name`, so
+    // references that are bound by position don't pay for hashing. Such references are
+    // found by name with a linear search, so there shall be only a few of them, such as
+    // parameters of a function. If `name` is empty, the slot is merely reserved.
+    Reference&
+    append_unhashed(const phsh_string& name)
+      {
+        // Reserve more room by rehashing if the load factor would exceed 0.5.
+        // The slot table is allocated along with buckets.
+        auto nbkt = static_cast<size_t>(this->m_eptr - this->m_bptr);
+        if(ROCKET_UNEXPECT(this->m_size >= nbkt / 2))
+          // Ensure the number of buckets is an odd number.
+          this->do_rehash(this->m_size * 3 | 17);
+
+        if(ROCKET_UNEXPECT(this->m_usize >= this->m_ucap))
+          this->do_reserve_unhashed(this->m_usize * 2 | 7);
+
+        // Construct a null reference and return it.
+        auto qbkt = this->m_ubptr + this->m_usize;
+        this->do_attach(qbkt, name);
+        this->m_usize++;
+        return qbkt->vstor[0];
+      }
+
     bool
     erase(const phsh_string& name)
     noexcept
@@ -189,12 +274,19 @@ class Reference_Dictionary
 
         // Find the bucket for the name.
         auto qbkt = this->do_xprobe(name);
-        if(!*qbkt)
-          return false;
-
-        // Detach this reference.
-        this->do_detach(qbkt);
-        return true;
+        if(*qbkt) {
+          // Detach this reference.
+          this->do_detach(qbkt);
+          return true;
+        }
+
+        qbkt = this->do_xfind_unhashed(name);
+        if(qbkt) {
+          // Detach this reference.
+          this->do_detach_unhashed(qbkt);
+          return true;
+        }
+        return false;
       }
 
     Variable_Callback&
@@ -7,6 +7,10 @@
 #include "runtime/global_context.hpp"
 #include "runtime/runtime_error.hpp"
 #include "runtime/abstract_hooks.hpp"
+#include "runtime/script_cache.hpp"
+#include "runtime/sampling_profiler.hpp"
+#include "runtime/tracing_hooks.hpp"
+#include "llds/avmc_queue.hpp"
 #include "compiler/parser_error.hpp"
 #include "simple_script.hpp"
 #include "utilities.hpp"
@@ -32,11 +36,18 @@ do_print_help_and_exit(const char* self)
 """""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
 Usage: %s [OPTIONS] [[--] FILE [ARGUMENTS]...]
 
+  -C      cache compiled code of FILE and scripts it imports
+  -c      compile FILE and write its cache file, without executing it
   -h      show help message then exit
   -I      suppress interactive mode [default = auto]
   -i      force interactive mode [default = auto]
   -O      equivalent to `-O1`
+  -N STAT write execution statistics of nodes of FILE to STAT
   -O[nn]  set optimization level to `nn` [default = 2]
+  -P PROF write a profile of FILE to PROF
+  -R EVNT write trace events of calls, imports and garbage collection of
+          FILE to EVNT, which Chrome and Perfetto accept
+  -S nn   allow `nn` MiB of heap memory for deep recursion [default = 0]
   -V      show version information then exit
   -v      enable verbose mode
 
@@ -56,6 +67,14 @@ returns no value, the exit status is zero. If the script returns a value
 that is neither an integer nor null, or throws an exception, the status is
 non-zero.
 
+Compiled code is cached in a file whose name is FILE with `.astc` appended.
+A cache file is used only if FILE has not changed since it was written, and
+is overwritten otherwise.
+
+A profile consists of collapsed stacks of script functions, which are
+sampled every millisecond of CPU time. It can be rendered by `flamegraph.pl`.
+Statistics of nodes slow execution down significantly.
+
 In verbose mode, execution details are printed to standard error. It also
 prevents quick termination, which enables some tools such as valgrind to
 discover memory leaks upon exit.
@@ -113,6 +132,10 @@ struct Command_Line_Options
     // options
     bool verbose = false;
     bool interactive = false;
+    bool precompile = false;
+    cow_string profile;  // path to profile
+    cow_string stats;  // path to statistics of nodes
+    cow_string trace;  // path to trace events
 
     // non-options
     cow_string path;
@@ -123,6 +146,8 @@ struct Command_Line_Options
 Command_Line_Options cmdline;
 Global_Context global;
 Simple_Script script;
+Sampling_Profiler profiler;
+rcptr<Tracing_Hooks> tracer;
 
 // These are process exit status codes.
 enum Exit_Code : uint8_t
@@ -147,6 +172,48 @@ noexcept
       va_end(ap);
     }
 
+    // Write the profile if any. Errors are ignored.
+    if(profiler.is_running()) {
+      profiler.stop();
+      try {
+        ::rocket::tinyfmt_file file;
+        file.open(cmdline.profile.c_str(),
+                  tinybuf::open_write | tinybuf::open_create | tinybuf::open_truncate);
+        profiler.print_collapsed(file);
+      }
+      catch(exception& stdex) {
+        ::fprintf(stderr, "! could not write profile: %s\n", stdex.what());
+      }
+    }
+
+    // Write statistics of nodes if any. Errors are ignored.
+    if(global.is_node_statistics_enabled()) {
+      global.enable_node_statistics(false);
+      try {
+        ::rocket::tinyfmt_file file;
+        file.open(cmdline.stats.c_str(),
+                  tinybuf::open_write | tinybuf::open_create | tinybuf::open_truncate);
+        AVMC_Queue::print_statistics(file);
+      }
+      catch(exception& stdex) {
+        ::fprintf(stderr, "! could not write statistics: %s\n", stdex.what());
+      }
+    }
+
+    // Write trace events if any. Errors are ignored.
+    if(tracer) {
+      try {
+        ::rocket::tinyfmt_file file;
+        file.open(cmdline.trace.c_str(),
+                  tinybuf::open_write | tinybuf::open_create | tinybuf::open_truncate);
+        tracer->flush(file);
+      }
+      catch(exception& stdex) {
+        ::fprintf(stderr, "! could not write trace events: %s\n", stdex.what());
+      }
+      tracer = nullptr;
+    }
+
     if(ROCKET_EXPECT(!cmdline.verbose)) {
       // Perform fast exit by default.
       ::fflush(nullptr);
@@ -232,8 +299,14 @@ do_parse_command_line(int argc, char** argv)
     bool version = false;
 
     opt<int8_t> optimize;
+    opt<size_t> heap_stack;
     opt<bool> verbose;
     opt<bool> interactive;
+    opt<bool> cache;
+    opt<bool> precompile;
+    opt<cow_string> profile;
+    opt<cow_string> stats;
+    opt<cow_string> trace;
     opt<cow_string> path;
     cow_vector<Value> args;
 
@@ -248,9 +321,17 @@ do_parse_command_line(int argc, char** argv)
 
     // Parse command-line options.
     int ch;
-    while((ch = ::getopt(argc, argv, "+hIiO::Vv")) != -1) {
+    while((ch = ::getopt(argc, argv, "+CchIiN:O::P:R:S:Vv")) != -1) {
       // Identify a single option.
       switch(ch) {
+        case 'C':
+          cache = true;
+          continue;
+
+        case 'c':
+          precompile = true;
+          continue;
+
         case 'h':
           help = true;
           continue;
@@ -263,6 +344,10 @@ do_parse_command_line(int argc, char** argv)
           interactive = true;
           continue;
 
+        case 'N':
+          stats = cow_string(optarg);
+          continue;
+
         case 'O': {
           // If `-O` is specified without an argument, it is equivalent to `-O1`.
           optimize = int8_t(1);
@@ -280,6 +365,26 @@ do_parse_command_line(int argc, char** argv)
           continue;
         }
 
+        case 'P':
+          profile = cow_string(optarg);
+          continue;
+
+        case 'R':
+          trace = cow_string(optarg);
+          continue;
+
+        case 'S': {
+          char* ep;
+          long val = ::strtol(optarg, &ep, 10);
+          if((*ep != 0) || (val < 0) || (val > 0xFFFF))
+            do_bail_out(exit_invalid_argument,
+                        "%s: invalid heap stack size -- '%s'\n",
+                        argv[0], optarg);
+
+          heap_stack = static_cast<size_t>(val);
+          continue;
+        }
+
         case 'V':
           version = true;
           continue;
@@ -323,6 +428,52 @@ do_parse_command_line(int argc, char** argv)
     else
       cmdline.interactive = !path && ::isatty(STDIN_FILENO);
 
+    // Precompilation requires a FILE, and implies non-interactive mode.
+    if(precompile) {
+      if(!path || (*path == "-"))
+        do_bail_out(exit_invalid_argument,
+                    "%s: `-c` requires a FILE\n",
+                    argv[0]);
+
+      cmdline.precompile = *precompile;
+      cmdline.interactive = false;
+    }
+
+    // Profiling requires non-interactive mode.
+    if(profile) {
+      if(cmdline.interactive)
+        do_bail_out(exit_invalid_argument,
+                    "%s: `-P` is not supported in interactive mode\n",
+                    argv[0]);
+
+      cmdline.profile = ::std::move(*profile);
+    }
+
+    // So do statistics of nodes.
+    if(stats) {
+      if(cmdline.interactive)
+        do_bail_out(exit_invalid_argument,
+                    "%s: `-N` is not supported in interactive mode\n",
+                    argv[0]);
+
+      cmdline.stats = ::std::move(*stats);
+    }
+
+    // So does tracing, which replaces hooks for verbose mode.
+    if(trace) {
+      if(cmdline.interactive)
+        do_bail_out(exit_invalid_argument,
+                    "%s: `-R` is not supported in interactive mode\n",
+                    argv[0]);
+
+      if(cmdline.verbose)
+        do_bail_out(exit_invalid_argument,
+                    "%s: `-R` cannot be used with `-v`\n",
+                    argv[0]);
+
+      cmdline.trace = ::std::move(*trace);
+    }
+
     // These arguments are always overwritten.
     cmdline.path = path.move_value_or(::rocket::sref("-"));
     cmdline.args = ::std::move(args);
@@ -332,6 +483,14 @@ do_parse_command_line(int argc, char** argv)
     // optimization in comparison to when it wasn't specified.
     if(optimize)
       script.open_options().optimization_level = *optimize;
+
+    // Compiled code is not cached by default.
+    if(cache)
+      script.open_options().cache_compiled_code = *cache;
+
+    // Deep recursion on the heap is disabled by default.
+    if(heap_stack)
+      global.set_heap_stack_limit(*heap_stack << 20);
   }
 
 int
@@ -551,6 +710,16 @@ do_single_noreturn()
 
     // Consume all data from standard input.
     try {
+      if(cmdline.precompile) {
+        // Write the cache file and exit.
+        uptr<char, void (&)(void*)> abspath(::realpath(cmdline.path.c_str(), nullptr), ::free);
+        if(!abspath)
+          do_bail_out(exit_system_error, "! could not open '%s': %m\n", cmdline.path.c_str());
+
+        precompile_script_file(script.get_options(), cow_string(abspath));
+        do_bail_out(exit_success);
+      }
+
       if(cmdline.path == "-")
         script.reload_stdin();
       else
@@ -562,6 +731,17 @@ do_single_noreturn()
 
     // Execute the script.
     ASTERIA_RUNTIME_TRY {
+      if(!cmdline.profile.empty())
+        profiler.start(1000);
+
+      if(!cmdline.stats.empty())
+        global.enable_node_statistics(true);
+
+      if(!cmdline.trace.empty()) {
+        tracer = ::rocket::make_refcnt<Tracing_Hooks>();
+        global.set_hooks(tracer);
+      }
+
       const auto ref = script.execute(global, ::std::move(cmdline.args));
 
       if(ref.is_void())
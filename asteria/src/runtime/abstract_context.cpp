@@ -6,10 +6,28 @@
 #include "../utilities.hpp"
 
 namespace Asteria {
+namespace {
+
+// These are hashed only once.
+const phsh_string s_name_varg = ::rocket::sref("__varg");
+const phsh_string s_name_this = ::rocket::sref("__this");
+const phsh_string s_name_func = ::rocket::sref("__func");
+
+}  // namespace
 
 Abstract_Context::
 ~Abstract_Context()
   {
   }
 
+Reference&
+Abstract_Context::
+do_append_predefined_references()
+  {
+    this->append_unhashed_reference(s_name_varg) /*= Reference_root::S_void()*/;
+    auto& ref_this = this->append_unhashed_reference(s_name_this) /*= Reference_root::S_void()*/;
+    this->append_unhashed_reference(s_name_func) /*= Reference_root::S_void()*/;
+    return ref_this;
+  }
+
 }  // namespace Asteria
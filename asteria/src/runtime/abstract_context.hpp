@@ -44,6 +44,22 @@ class Abstract_Context
     do_lazy_lookup_opt(const phsh_string& name)
       = 0;
 
+    // Function contexts have pre-defined references following parameters. They occupy
+    // fixed slots and are not hashed, as most functions never use them. They are
+    // initialized lazily, except `__this`, which is returned.
+    Reference&
+    do_append_predefined_references();
+
+  private:
+    const Reference*
+    do_lazy_lookup_fallback(const Reference* qref, const phsh_string& name)
+    const
+      {
+        // Builtins may have been declared without being initialized.
+        auto qlazy = const_cast<Abstract_Context*>(this)->do_lazy_lookup_opt(name);
+        return qlazy ? qlazy : qref;
+      }
+
   public:
     bool
     is_analytic()
@@ -61,19 +77,49 @@ class Abstract_Context
       {
         auto qref = this->m_named_refs.get_opt(name);
         // Initialize builtins only when needed.
-        if(ROCKET_UNEXPECT(!qref))
-          qref = const_cast<Abstract_Context*>(this)->do_lazy_lookup_opt(name);
+        if(ROCKET_UNEXPECT(!qref || qref->is_void()))
+          qref = this->do_lazy_lookup_fallback(qref, name);
+        return qref;
+      }
+
+    // This is the same as above, but only `slot` is tried. If it does not designate
+    // `name`, a null pointer is returned and the name has to be looked up.
+    const Reference*
+    get_named_reference_opt(size_t slot, const phsh_string& name)
+    const
+      {
+        auto qref = this->m_named_refs.get_opt(slot, name);
+        // Initialize builtins only when needed.
+        if(ROCKET_UNEXPECT(qref && qref->is_void()))
+          qref = this->do_lazy_lookup_fallback(qref, name);
         return qref;
       }
 
+    size_t
+    find_named_reference_slot(const phsh_string& name)
+    const noexcept
+      { return this->m_named_refs.find_slot(name);  }
+
     Reference&
     open_named_reference(const phsh_string& name)
       { return this->m_named_refs.open(name);  }
 
+    // This appends a reference to the next slot without hashing `name`. See
+    // `Reference_Dictionary::append_unhashed()` for details.
+    Reference&
+    append_unhashed_reference(const phsh_string& name)
+      { return this->m_named_refs.append_unhashed(name);  }
+
     Abstract_Context&
     clear_named_references()
     noexcept
       { return this->m_named_refs.clear(), *this;  }
+
+    // This exchanges all named references, as well as their storage, with `other`.
+    Abstract_Context&
+    swap_named_references(Reference_Dictionary& other)
+    noexcept
+      { return this->m_named_refs.swap(other), *this;  }
   };
 
 }  // namespace Asteria
@@ -61,6 +61,45 @@ class Abstract_Hooks
         (void)except;
       }
 
+    // This hook is called before a script file is compiled for `import`. It is not called if
+    // the file is found in the module cache.
+    virtual
+    void
+    on_module_compile_begin(const Source_Location& sloc, const cow_string& path)
+      {
+        (void)sloc;
+        (void)path;
+      }
+
+    // This hook is called after a script file has been compiled for `import`, whether it has
+    // succeeded or not.
+    virtual
+    void
+    on_module_compile_end(const Source_Location& sloc, const cow_string& path)
+      {
+        (void)sloc;
+        (void)path;
+      }
+
+    // This hook is called before garbage collection, whether it has been requested explicitly
+    // or triggered by allocation. `gc_limit` is the oldest generation to be collected.
+    virtual
+    void
+    on_garbage_collect_begin(GC_Generation gc_limit)
+      {
+        (void)gc_limit;
+      }
+
+    // This hook is called after garbage collection. `nvars` is the number of variables that
+    // have been collected.
+    virtual
+    void
+    on_garbage_collect_end(GC_Generation gc_limit, size_t nvars)
+      {
+        (void)gc_limit;
+        (void)nvars;
+      }
+
     // This hook is called before every statement, condition, etc.
     // Be advised that single-step traps require code generation support, which must be enabled by
     // setting `verbose_single_step_traps` in `Compiler_Options`.
@@ -14,9 +14,11 @@
 #include "variable.hpp"
 #include "ptc_arguments.hpp"
 #include "loader_lock.hpp"
+#include "module_cache.hpp"
 #include "air_optimizer.hpp"
-#include "../compiler/token_stream.hpp"
-#include "../compiler/statement_sequence.hpp"
+#include "instantiated_function.hpp"
+#include "air_serializer.hpp"
+#include "script_cache.hpp"
 #include "../llds/avmc_queue.hpp"
 #include "../utilities.hpp"
 
@@ -24,10 +26,11 @@ namespace Asteria {
 namespace {
 
 bool&
-do_rebind_nodes(bool& dirty, cow_vector<AIR_Node>& code, const Abstract_Context& ctx)
+do_rebind_nodes(bool& dirty, cow_vector<AIR_Node>& code, const Abstract_Context& ctx,
+                cow_vector<AIR_Node::S_push_local_reference>* captures_opt = nullptr)
   {
     for(size_t i = 0;  i < code.size();  ++i) {
-      auto qnode = code[i].rebind_opt(ctx);
+      auto qnode = code[i].rebind_opt(ctx, captures_opt);
       if(!qnode)
         continue;
       dirty |= true;
@@ -37,11 +40,12 @@ do_rebind_nodes(bool& dirty, cow_vector<AIR_Node>& code, const Abstract_Context&
   }
 
 bool&
-do_rebind_nodes(bool& dirty, cow_vector<cow_vector<AIR_Node>>& seqs, const Abstract_Context& ctx)
+do_rebind_nodes(bool& dirty, cow_vector<cow_vector<AIR_Node>>& seqs, const Abstract_Context& ctx,
+                cow_vector<AIR_Node::S_push_local_reference>* captures_opt = nullptr)
   {
     for(size_t k = 0;  k < seqs.size();  ++k) {
       for(size_t i = 0;  i < seqs[k].size();  ++i) {
-        auto qnode = seqs[k][i].rebind_opt(ctx);
+        auto qnode = seqs[k][i].rebind_opt(ctx, captures_opt);
         if(!qnode)
           continue;
         dirty |= true;
@@ -111,6 +115,74 @@ do_declare(Executive_Context& ctx, const phsh_string& name)
     return ctx.open_named_reference(name) = Reference_root::S_void();
   }
 
+const Reference*
+do_get_named_reference_opt(const Executive_Context& ctx, size_t slot, const phsh_string& name)
+  {
+    // The slot that was resolved at compile time is tried first.
+    auto qref = ctx.get_named_reference_opt(slot, name);
+    if(ROCKET_EXPECT(qref))
+      return qref;
+
+    // Look for the name instead.
+    ctx.global().note_slot_miss();
+    return ctx.get_named_reference_opt(name);
+  }
+
+const Reference&
+do_get_local_reference(const Executive_Context& ctx, uint32_t depth, size_t slot, const phsh_string& name)
+  {
+    // Get the context.
+    const Executive_Context* qctx = &ctx;
+    ::rocket::ranged_for(UINT32_C(0), depth, [&](uint32_t) { qctx = qctx->get_parent_opt();  });
+    ROCKET_ASSERT(qctx);
+
+    // Look for the name in the context.
+    auto qref = do_get_named_reference_opt(*qctx, slot, name);
+    if(!qref)
+      ASTERIA_THROW("undeclared identifier `$1`", name);
+
+    // Check if control flow has bypassed its initialization.
+    if(qref->is_void())
+      ASTERIA_THROW("use of bypassed variable `$1`", name);
+
+    return *qref;
+  }
+
+uint32_t
+do_add_capture(cow_vector<AIR_Node::S_push_local_reference>& captures, uint32_t depth, uint32_t slot,
+               const phsh_string& name)
+  {
+    // Reuse an existing capture if any.
+    for(size_t i = 0;  i < captures.size();  ++i)
+      if((captures[i].depth == depth) && (captures[i].name == name))
+        return static_cast<uint32_t>(i);
+
+    // Append a new one.
+    AIR_Node::S_push_local_reference xcap = { Source_Location(), depth, slot, name };
+    captures.emplace_back(::std::move(xcap));
+    return static_cast<uint32_t>(captures.size() - 1);
+  }
+
+const Reference*
+do_find_reference_opt(const Executive_Context& ctx, uint32_t depth, size_t slot, const phsh_string& name)
+  {
+    // Get the context.
+    // If the reference goes beyond the enclosing function, it must have been captured by it.
+    const Executive_Context* qctx = &ctx;
+    while(depth != 0) {
+      auto qnext = qctx->get_parent_opt();
+      if(!qnext) {
+        auto qclosure = qctx->get_closure_opt();
+        return qclosure ? qclosure->get_capture_opt(depth, name) : nullptr;
+      }
+      qctx = qnext;
+      depth--;
+    }
+
+    // Look for the name in the context.
+    return do_get_named_reference_opt(*qctx, slot, name);
+  }
+
 AIR_Status
 do_execute_block(const AVMC_Queue& queue, const Executive_Context& ctx)
   {
@@ -128,6 +200,30 @@ do_execute_block(const AVMC_Queue& queue, const Executive_Context& ctx)
     return status;
   }
 
+AIR_Status
+do_execute_loop_body(const AVMC_Queue& queue, bool scoped, Executive_Context& ctx,
+                     Executive_Context& ctx_body)
+  {
+    // If the body declares nothing, execute it on the enclosing context.
+    if(!scoped)
+      return queue.execute(ctx);
+
+    // Execute the body on `ctx_body`, which is shared by all iterations.
+    AIR_Status status;
+    ASTERIA_RUNTIME_TRY {
+      status = queue.execute(ctx_body);
+    }
+    ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
+      ctx_body.on_scope_exit(except);
+      throw;
+    }
+    ctx_body.on_scope_exit(status);
+
+    // Reset the context for the next iteration. Its storage is retained.
+    ctx_body.clear_named_references();
+    return status;
+  }
+
 // These are user-defined parameter types for AVMC nodes.
 // The `enumerate_variables()` callback is optional.
 
@@ -167,12 +263,24 @@ using Sparam_queues_2 = Sparam_queues<2>;
 using Sparam_queues_3 = Sparam_queues<3>;
 using Sparam_queues_4 = Sparam_queues<4>;
 
+struct Switch_Integer_Label
+  {
+    V_integer value;
+    size_t clause;
+  };
+
 struct Sparam_switch
   {
     cow_vector<AVMC_Queue> queues_labels;
     cow_vector<AVMC_Queue> queues_bodies;
     cow_vector<cow_vector<phsh_string>> names_added;
 
+    // If all labels are integer or string constants, these map them to clauses.
+    bool tabled = false;
+    size_t clause_default = SIZE_MAX;
+    cow_vector<Switch_Integer_Label> table_integers;  // sorted
+    cow_dictionary<size_t> table_strings;
+
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
     const
@@ -220,18 +328,13 @@ struct Sparam_try_catch
 
 struct Sparam_func
   {
-    Compiler_Options opts;
-    Source_Location sloc;
-    cow_string func;
-    cow_vector<phsh_string> params;
-    cow_vector<AIR_Node> code_body;
+    rcptr<Function_Template> templ;
 
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
     const
       {
-        ::rocket::for_each(this->code_body, callback);
-        return callback;
+        return this->templ->enumerate_variables(callback);
       }
   };
 
@@ -259,6 +362,9 @@ struct AIR_Traits;
 template<Xop xopT>
 struct AIR_Traits_Xop;
 
+template<typename TraitsT, typename UparamT, typename SparamT>
+struct executor_of;
+
 template<>
 struct AIR_Traits<AIR_Node::S_clear_stack>
   {
@@ -277,7 +383,24 @@ struct AIR_Traits<AIR_Node::S_clear_stack>
 bool
 do_solidify_code(AVMC_Queue& queue, const cow_vector<AIR_Node>& code)
   {
-    return ::rocket::all_of(code, [&](const AIR_Node& node) { return node.solidify(queue);  });
+    return AIR_Node::solidify_code(queue, code);
+  }
+
+bool
+do_is_scoped_body(const cow_vector<AIR_Node>& code)
+  {
+    return (code.size() == 1) && code[0].get_block_body_opt();
+  }
+
+bool
+do_solidify_loop_body(AVMC_Queue& queue, const cow_vector<AIR_Node>& code)
+  {
+    // If the body is a single block, solidify its contents instead, which will be executed
+    // on a context that is reused across iterations. See `do_execute_loop_body()`.
+    if(do_is_scoped_body(code))
+      return do_solidify_code(queue, *(code[0].get_block_body_opt()));
+
+    return do_solidify_code(queue, code);
   }
 
 template<>
@@ -341,8 +464,8 @@ struct AIR_Traits<AIR_Node::S_declare_variable>
         ctx.open_named_reference(sp.name) = xref;  // it'll be used later so don't move!
 
         // Call the hook function if any.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_variable_declare(sp.sloc, sp.name);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_variable_declare(sp.sloc, sp.name);
 
         // Push a copy of the reference onto the stack.
         ctx.stack().push(::std::move(xref));
@@ -425,12 +548,14 @@ struct AIR_Traits<AIR_Node::S_if_statement>
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_queues_2& sp)
       {
         // Check the value of the condition.
+        // Branches that declare names have been wrapped in blocks, so they can be executed
+        // on this context directly.
         if(ctx.stack().get_top().read().test() != up.v8s[0])
           // Execute the true branch and forward the status verbatim.
-          return do_execute_block(sp.queues[0], ctx);
+          return sp.queues[0].execute(ctx);
 
         // Execute the false branch and forward the status verbatim.
-        return do_execute_block(sp.queues[1], ctx);
+        return sp.queues[1].execute(ctx);
       }
   };
 
@@ -449,6 +574,42 @@ struct AIR_Traits<AIR_Node::S_switch_statement>
         ::rocket::for_each(seqs, [&](const auto& code) { do_solidify_code(queues.emplace_back(), code);  });
       }
 
+    static
+    bool
+    do_make_table(Sparam_switch& sp, const cow_vector<cow_vector<AIR_Node>>& seqs)
+      {
+        for(size_t i = 0;  i < seqs.size();  ++i) {
+          // This is a `default` clause if the label is empty.
+          const auto& code = seqs[i];
+          if(code.empty()) {
+            if(sp.clause_default != SIZE_MAX)
+              return false;
+            sp.clause_default = i;
+            continue;
+          }
+
+          // Otherwise, the label shall be a single constant.
+          if((code.size() != 2) || (code[0].index() != AIR_Node::index_clear_stack))
+            return false;
+          auto qval = code[1].get_constant_opt();
+          if(!qval)
+            return false;
+
+          // If there are duplicate labels, only the first one is effective.
+          if(qval->is_integer())
+            sp.table_integers.push_back({ qval->as_integer(), i });
+          else if(qval->is_string())
+            sp.table_strings.try_emplace(phsh_string(qval->as_string()), i);
+          else
+            return false;
+        }
+
+        // Sort integers for binary search. Stability is required for duplicates.
+        ::std::stable_sort(sp.table_integers.mut_begin(), sp.table_integers.mut_end(),
+                           [](const auto& x, const auto& y) { return x.value < y.value;  });
+        return true;
+      }
+
     static
     Sparam_switch
     make_sparam(bool& /*reachable*/, const AIR_Node::S_switch_statement& altr)
@@ -457,26 +618,55 @@ struct AIR_Traits<AIR_Node::S_switch_statement>
         do_xsolidify_code(sp.queues_labels, altr.code_labels);
         do_xsolidify_code(sp.queues_bodies, altr.code_bodies);
         sp.names_added = altr.names_added;
+
+        // Build a dispatch table if possible.
+        sp.tabled = do_make_table(sp, altr.code_labels);
+        if(!sp.tabled) {
+          sp.clause_default = SIZE_MAX;
+          sp.table_integers.clear();
+          sp.table_strings.clear();
+        }
         return sp;
       }
 
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const Sparam_switch& sp)
-      {
-        // Get the number of clauses.
-        auto nclauses = sp.queues_labels.size();
-        ROCKET_ASSERT(nclauses == sp.queues_bodies.size());
-        ROCKET_ASSERT(nclauses == sp.names_added.size());
+    bool
+    do_find_in_table(size_t& bp, const Sparam_switch& sp, const Value& cond)
+      {
+        switch(weaken_enum(cond.vtype())) {
+          case vtype_integer: {
+            auto pos = ::std::lower_bound(sp.table_integers.begin(), sp.table_integers.end(),
+                                          cond.as_integer(),
+                                          [](const auto& x, V_integer y) { return x.value < y;  });
+            bp = sp.clause_default;
+            if((pos != sp.table_integers.end()) && (pos->value == cond.as_integer()))
+              bp = pos->clause;
+            return true;
+          }
 
-        // Read the value of the condition.
-        auto cond = ctx.stack().get_top().read();
+          case vtype_string: {
+            auto qbp = sp.table_strings.get_ptr(phsh_string(cond.as_string()));
+            bp = qbp ? *qbp : sp.clause_default;
+            return true;
+          }
 
-        // Find a target clause.
-        size_t bp = SIZE_MAX;
+          case vtype_real:
+            // Reals may compare equal to integers. Don't bother.
+            return false;
+
+          default:
+            // Values of other types never compare equal to integers or strings.
+            bp = sp.clause_default;
+            return true;
+        }
+      }
 
+    static
+    void
+    do_find_by_comparison(size_t& bp, Executive_Context& ctx, const Sparam_switch& sp, const Value& cond)
+      {
         // This is different from the `switch` statement in C, where `case` labels must have constant operands.
-        for(size_t i = 0;  i < nclauses;  ++i) {
+        for(size_t i = 0;  i < sp.queues_labels.size();  ++i) {
           // This is a `default` clause if the condition is empty, and a `case` clause otherwise.
           if(sp.queues_labels[i].empty()) {
             if(bp != SIZE_MAX)
@@ -492,6 +682,24 @@ struct AIR_Traits<AIR_Node::S_switch_statement>
             break;
           }
         }
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, const Sparam_switch& sp)
+      {
+        // Get the number of clauses.
+        auto nclauses = sp.queues_labels.size();
+        ROCKET_ASSERT(nclauses == sp.queues_bodies.size());
+        ROCKET_ASSERT(nclauses == sp.names_added.size());
+
+        // Read the value of the condition.
+        auto cond = ctx.stack().get_top().read();
+
+        // Find a target clause. Use the dispatch table if possible.
+        size_t bp = SIZE_MAX;
+        if(!sp.tabled || !do_find_in_table(bp, sp, cond))
+          do_find_by_comparison(bp, ctx, sp, cond);
 
         // Skip this statement if no matching clause has been found.
         if(bp != SIZE_MAX) {
@@ -536,6 +744,7 @@ struct AIR_Traits<AIR_Node::S_do_while_statement>
       {
         AVMC_Queue::Uparam up;
         up.v8s[0] = altr.negative;
+        up.v8s[1] = do_is_scoped_body(altr.code_body);
         return up;
       }
 
@@ -544,7 +753,7 @@ struct AIR_Traits<AIR_Node::S_do_while_statement>
     make_sparam(bool& /*reachable*/, const AIR_Node::S_do_while_statement& altr)
       {
         Sparam_queues_2 sp;
-        do_solidify_code(sp.queues[0], altr.code_body);
+        do_solidify_loop_body(sp.queues[0], altr.code_body);
         do_solidify_code(sp.queues[1], altr.code_cond);
         return sp;
       }
@@ -554,9 +763,10 @@ struct AIR_Traits<AIR_Node::S_do_while_statement>
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_queues_2& sp)
       {
         // This is the same as the `do...while` statement in C.
+        Executive_Context ctx_body(::rocket::ref(ctx));
         for(;;) {
           // Execute the body.
-          auto status = do_execute_block(sp.queues[0], ctx);
+          auto status = do_execute_loop_body(sp.queues[0], up.v8s[1], ctx, ctx_body);
           if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while }))
             break;
           if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
@@ -585,6 +795,7 @@ struct AIR_Traits<AIR_Node::S_while_statement>
       {
         AVMC_Queue::Uparam up;
         up.v8s[0] = altr.negative;
+        up.v8s[1] = do_is_scoped_body(altr.code_body);
         return up;
       }
 
@@ -594,7 +805,7 @@ struct AIR_Traits<AIR_Node::S_while_statement>
       {
         Sparam_queues_2 sp;
         do_solidify_code(sp.queues[0], altr.code_cond);
-        do_solidify_code(sp.queues[1], altr.code_body);
+        do_solidify_loop_body(sp.queues[1], altr.code_body);
         return sp;
       }
 
@@ -603,6 +814,7 @@ struct AIR_Traits<AIR_Node::S_while_statement>
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_queues_2& sp)
       {
         // This is the same as the `while` statement in C.
+        Executive_Context ctx_body(::rocket::ref(ctx));
         for(;;) {
           // Check the condition.
           auto status = sp.queues[0].execute(ctx);
@@ -611,7 +823,7 @@ struct AIR_Traits<AIR_Node::S_while_statement>
             break;
 
           // Execute the body.
-          status = do_execute_block(sp.queues[1], ctx);
+          status = do_execute_loop_body(sp.queues[1], up.v8s[1], ctx, ctx_body);
           if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while }))
             break;
           if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
@@ -625,9 +837,18 @@ struct AIR_Traits<AIR_Node::S_while_statement>
 template<>
 struct AIR_Traits<AIR_Node::S_for_each_statement>
   {
-    // `Uparam` is unused.
+    // `Uparam` is whether the body has its own scope.
     // `Sparam` is ... everything.
 
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_for_each_statement& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.v8s[0] = do_is_scoped_body(altr.code_body);
+        return up;
+      }
+
     static
     Sparam_for_each
     make_sparam(bool& /*reachable*/, const AIR_Node::S_for_each_statement& altr)
@@ -636,13 +857,13 @@ struct AIR_Traits<AIR_Node::S_for_each_statement>
         sp.name_key = altr.name_key;
         sp.name_mapped = altr.name_mapped;
         do_solidify_code(sp.queue_init, altr.code_init);
-        do_solidify_code(sp.queue_body, altr.code_body);
+        do_solidify_loop_body(sp.queue_body, altr.code_body);
         return sp;
       }
 
     static
     AIR_Status
-    execute(Executive_Context& ctx, const Sparam_for_each& sp)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_for_each& sp)
       {
         // Get global interfaces.
         auto gcoll = ctx.global().genius_collector();
@@ -664,6 +885,7 @@ struct AIR_Traits<AIR_Node::S_for_each_statement>
         ROCKET_ASSERT(status == air_status_next);
         // Set the range up, which isn't going to change for the entire loop.
         mapped = ::std::move(ctx_for.stack().open_top());
+        Executive_Context ctx_body(::rocket::ref(ctx_for));
 
         const auto range = mapped.read();
         switch(weaken_enum(range.vtype())) {
@@ -681,7 +903,7 @@ struct AIR_Traits<AIR_Node::S_for_each_statement>
               mapped.zoom_in(::std::move(xmod));
 
               // Execute the loop body.
-              status = do_execute_block(sp.queue_body, ctx_for);
+              status = do_execute_loop_body(sp.queue_body, up.v8s[0], ctx_for, ctx_body);
               if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for }))
                 break;
               if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
@@ -704,7 +926,7 @@ struct AIR_Traits<AIR_Node::S_for_each_statement>
               mapped.zoom_in(::std::move(xmod));
 
               // Execute the loop body.
-              status = do_execute_block(sp.queue_body, ctx_for);
+              status = do_execute_loop_body(sp.queue_body, up.v8s[0], ctx_for, ctx_body);
               if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for }))
                 break;
               if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
@@ -726,9 +948,18 @@ struct AIR_Traits<AIR_Node::S_for_each_statement>
 template<>
 struct AIR_Traits<AIR_Node::S_for_statement>
   {
-    // `Uparam` is unused.
+    // `Uparam` is whether the body has its own scope.
     // `Sparam` is ... everything.
 
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_for_statement& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.v8s[0] = do_is_scoped_body(altr.code_body);
+        return up;
+      }
+
     static
     Sparam_queues_4
     make_sparam(bool& /*reachable*/, const AIR_Node::S_for_statement& altr)
@@ -737,13 +968,13 @@ struct AIR_Traits<AIR_Node::S_for_statement>
         do_solidify_code(sp.queues[0], altr.code_init);
         do_solidify_code(sp.queues[1], altr.code_cond);
         do_solidify_code(sp.queues[2], altr.code_step);
-        do_solidify_code(sp.queues[3], altr.code_body);
+        do_solidify_loop_body(sp.queues[3], altr.code_body);
         return sp;
       }
 
     static
     AIR_Status
-    execute(Executive_Context& ctx, const Sparam_queues_4& sp)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_queues_4& sp)
       {
         // This is the same as the `for` statement in C.
         // We have to create an outer context due to the fact that names declared in the first segment
@@ -753,6 +984,7 @@ struct AIR_Traits<AIR_Node::S_for_statement>
         // Execute the loop initializer, which shall only be a definition or an expression statement.
         auto status = sp.queues[0].execute(ctx_for);
         ROCKET_ASSERT(status == air_status_next);
+        Executive_Context ctx_body(::rocket::ref(ctx_for));
         for(;;) {
           // Check the condition.
           status = sp.queues[1].execute(ctx_for);
@@ -762,7 +994,7 @@ struct AIR_Traits<AIR_Node::S_for_statement>
             break;
 
           // Execute the body.
-          status = do_execute_block(sp.queues[3], ctx_for);
+          status = do_execute_loop_body(sp.queues[3], up.v8s[0], ctx_for, ctx_body);
           if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for }))
             break;
           if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
@@ -804,7 +1036,7 @@ struct AIR_Traits<AIR_Node::S_try_statement>
         // This is almost identical to JavaScript.
         // Execute the `try` block. If no exception is thrown, this will have little overhead.
         // This must not be PTC'd, otherwise exceptions thrown from tail calls won't be caught.
-        auto status = do_execute_block(sp.queue_try, ctx);
+        auto status = sp.queue_try.execute(ctx);
         if(status == air_status_return_ref)
           ctx.stack().open_top().finish_call(ctx.global());
         return status;
@@ -1042,7 +1274,7 @@ struct AIR_Traits<AIR_Node::S_push_global_reference>
 template<>
 struct AIR_Traits<AIR_Node::S_push_local_reference>
   {
-    // `Uparam` is the depth.
+    // `Uparam` is the depth and slot.
     // `Sparam` is the source location and name;
 
     static
@@ -1050,6 +1282,7 @@ struct AIR_Traits<AIR_Node::S_push_local_reference>
     make_uparam(bool& /*reachable*/, const AIR_Node::S_push_local_reference& altr)
       {
         AVMC_Queue::Uparam up;
+        up.x16 = static_cast<uint16_t>(::rocket::min(altr.slot, uint32_t(UINT16_MAX)));
         up.x32 = altr.depth;
         return up;
       }
@@ -1077,22 +1310,8 @@ struct AIR_Traits<AIR_Node::S_push_local_reference>
     AIR_Status
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_sloc_name& sp)
       {
-        // Get the context.
-        const Executive_Context* qctx = &ctx;
-        ::rocket::ranged_for(UINT32_C(0), up.x32, [&](uint32_t) { qctx = qctx->get_parent_opt();  });
-        ROCKET_ASSERT(qctx);
-
-        // Look for the name in the context.
-        auto qref = qctx->get_named_reference_opt(sp.name);
-        if(!qref)
-          ASTERIA_THROW("undeclared identifier `$1`", sp.name);
-
-        // Check if control flow has bypassed its initialization.
-        if(qref->is_void())
-          ASTERIA_THROW("use of bypassed variable `$1`", sp.name);
-
-        // Push a copy of it.
-        ctx.stack().push(*qref);
+        // Push a copy of the reference.
+        ctx.stack().push(do_get_local_reference(ctx, up.x32, up.x16, sp.name));
         return air_status_next;
       }
   };
@@ -1120,6 +1339,47 @@ struct AIR_Traits<AIR_Node::S_push_bound_reference>
       }
   };
 
+template<>
+struct AIR_Traits<AIR_Node::S_push_captured_reference>
+  {
+    // `Uparam` is the index.
+    // `Sparam` is the name.
+
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const AIR_Node::S_push_captured_reference& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.x32 = altr.index;
+        return up;
+      }
+
+    static
+    phsh_string
+    make_sparam(bool& /*reachable*/, const AIR_Node::S_push_captured_reference& altr)
+      {
+        return altr.name;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const phsh_string& name)
+      {
+        // Get the closure, which is always available in a function.
+        auto qclosure = ctx.get_closure_opt();
+        ROCKET_ASSERT(qclosure);
+        const auto& ref = qclosure->get_capture(up.x32);
+
+        // Check if control flow has bypassed its initialization.
+        if(ref.is_void())
+          ASTERIA_THROW("use of bypassed variable `$1`", name);
+
+        // Push a copy of the captured reference.
+        ctx.stack().push(ref);
+        return air_status_next;
+      }
+  };
+
 template<>
 struct AIR_Traits<AIR_Node::S_define_function>
   {
@@ -1130,12 +1390,13 @@ struct AIR_Traits<AIR_Node::S_define_function>
     Sparam_func
     make_sparam(bool& /*reachable*/, const AIR_Node::S_define_function& altr)
       {
+        // Rewrite references to enclosing functions in the body, which is shared by all
+        // closures that are created from this node.
+        AIR_Optimizer optmz(altr.opts);
+        optmz.capture(altr.params, altr.code_body);
+
         Sparam_func sp;
-        sp.opts = altr.opts;
-        sp.sloc = altr.sloc;
-        sp.func = altr.func;
-        sp.params = altr.params;
-        sp.code_body = altr.code_body;
+        sp.templ = optmz.create_template(altr.sloc, altr.func);
         return sp;
       }
 
@@ -1143,10 +1404,20 @@ struct AIR_Traits<AIR_Node::S_define_function>
     AIR_Status
     execute(Executive_Context& ctx, const Sparam_func& sp)
       {
-        // Rewrite nodes in the body as necessary.
-        AIR_Optimizer optmz(sp.opts);
-        optmz.rebind(&ctx, sp.params, sp.code_body);
-        auto qtarget = optmz.create_function(sp.sloc, sp.func);
+        // Look up captured references. The body will not be solidified until the closure
+        // is called.
+        const auto& captures = sp.templ->get_captures();
+        cow_vector<Reference> refs;
+        refs.reserve(captures.size());
+        for(const auto& cap : captures) {
+          // Note that `depth` is counted from the function context.
+          auto qref = do_find_reference_opt(ctx, cap.depth - 1, cap.slot, cap.name);
+          if(qref)
+            refs.emplace_back(*qref);
+          else
+            refs.emplace_back(Reference_root::S_void());
+        }
+        auto qtarget = ::rocket::make_refcnt<Instantiated_Function>(sp.templ, ::std::move(refs));
 
         // Push the function as a temporary.
         Reference_root::S_temporary xref = { ::std::move(qtarget) };
@@ -1251,26 +1522,68 @@ struct AIR_Traits<AIR_Node::S_coalescence>
       }
   };
 
+struct Heap_Stack_Call
+  {
+    Reference& self;
+    Global_Context& global;
+    const cow_function& target;
+    cow_vector<Reference>& args;
+  };
+
+ROCKET_NOINLINE
+void
+do_invoke_on_heap_stack(Reference& self, Global_Context& global, const cow_function& target,
+                        cow_vector<Reference>&& args)
+  {
+    Heap_Stack_Call call = { self, global, target, args };
+    global.call_on_heap_stack(
+      [](void* param) {
+        auto& r = *static_cast<Heap_Stack_Call*>(param);
+        r.target.invoke(r.self, r.global, ::std::move(r.args));
+      },
+      &call);
+  }
+
 ROCKET_NOINLINE
 Reference&
-do_invoke_nontail(Reference& self, const Source_Location& sloc, Executive_Context& ctx,
-                  const cow_function& target, cow_vector<Reference>&& args)
+do_invoke_nontail_with_hooks(Reference& self, const Source_Location& sloc, Executive_Context& ctx,
+                             const cow_function& target, cow_vector<Reference>&& args)
   {
     // Note exceptions thrown here are not caught.
-    if(auto qhooks = ctx.global().get_hooks_opt())
-      qhooks->on_function_call(sloc, target);
+    auto qhooks = ctx.global().get_hooks_opt();
+    qhooks->on_function_call(sloc, target);
 
-    // Execute the target function
+    // Execute the target function.
+    // If the native stack is running out, continue on a heap-allocated segment.
     ASTERIA_RUNTIME_TRY {
-      target.invoke(self, ctx.global(), ::std::move(args));
+      if(ROCKET_EXPECT(!ctx.global().is_stack_low()))
+        target.invoke(self, ctx.global(), ::std::move(args));
+      else
+        do_invoke_on_heap_stack(self, ctx.global(), target, ::std::move(args));
     }
     ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
-      if(auto qhooks = ctx.global().get_hooks_opt())
-        qhooks->on_function_except(sloc, target, except);
+      qhooks->on_function_except(sloc, target, except);
       throw;
     }
-    if(auto qhooks = ctx.global().get_hooks_opt())
-      qhooks->on_function_return(sloc, target, self);
+    qhooks->on_function_return(sloc, target, self);
+    return self;
+  }
+
+ROCKET_NOINLINE
+Reference&
+do_invoke_nontail(Reference& self, const Source_Location& sloc, Executive_Context& ctx,
+                  const cow_function& target, cow_vector<Reference>&& args)
+  {
+    // Hooks are checked only once, so calls do not pay for them if none is installed.
+    if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+      return do_invoke_nontail_with_hooks(self, sloc, ctx, target, ::std::move(args));
+
+    // Execute the target function.
+    // If the native stack is running out, continue on a heap-allocated segment.
+    if(ROCKET_EXPECT(!ctx.global().is_stack_low()))
+      target.invoke(self, ctx.global(), ::std::move(args));
+    else
+      do_invoke_on_heap_stack(self, ctx.global(), target, ::std::move(args));
     return self;
   }
 
@@ -1281,6 +1594,9 @@ do_function_call_common(Reference& self, const Source_Location& sloc, Executive_
     if(ROCKET_EXPECT(ptc == ptc_aware_none)) {
       // Perform plain calls.
       do_invoke_nontail(self, sloc, ctx, target, ::std::move(args));
+      // If the storage of `args` hasn't been taken by the target, return it to the pool.
+      if(args.unique())
+        ctx.global().release_stack_storage(::std::move(args));
       // The result will have been stored into `self`
       return air_status_next;
     }
@@ -1301,7 +1617,9 @@ do_function_call_common(Reference& self, const Source_Location& sloc, Executive_
 cow_vector<Reference>
 do_pop_positional_arguments(Executive_Context& ctx, size_t nargs)
   {
-    cow_vector<Reference> args;
+    // Take storage from the pool in `global`. If the target is a script function, it is
+    // reused for its evaluation stack; otherwise it is returned after the call.
+    auto args = ctx.global().acquire_stack_storage();
     args.resize(nargs, Reference_root::S_void());
     for(size_t i = args.size() - 1;  i != SIZE_MAX;  --i) {
       // Get an argument. Ensure it is dereferenceable.
@@ -1356,8 +1674,8 @@ struct AIR_Traits<AIR_Node::S_function_call>
         const auto sentry = ctx.global().copy_recursion_sentry();
 
         // Generate a single-step trap before unpacking arguments.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_single_step_trap(sloc);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_single_step_trap(sloc);
 
         // Pop arguments off the stack backwards.
         auto args = do_pop_positional_arguments(ctx, up.y32);
@@ -2065,637 +2383,893 @@ struct AIR_Traits<AIR_Node::S_apply_operator>
       }
   };
 
-template<>
-struct AIR_Traits_Xop<xop_inc_post> : AIR_Traits<AIR_Node::S_apply_operator>
+// Operators that take values rather than references share executors.
+// The traits struct for each of them must contain the `operate()` function, which
+// takes operands and stores the result into the last one.
+
+template<Xop xopT>
+struct AIR_Traits_Xop_unary : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
         // This operator is unary.
-        auto& lhs = ctx.stack().get_top().open();
-        Reference_root::S_temporary xref = { lhs };
-
-        // Increment the operand and return the old value. `assign` is ignored.
-        if(lhs.is_integer()) {
-          auto& reg = lhs.open_integer();
-          reg = do_operator_ADD(reg, V_integer(1));
-        }
-        else if(lhs.is_real()) {
-          auto& reg = lhs.open_real();
-          reg = do_operator_ADD(reg, V_real(1));
-        }
-        else
-          ASTERIA_THROW("postfix increment not applicable (operand was `$1`)", lhs);
+        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
+        AIR_Traits_Xop<xopT>::operate(xref.val);
 
-        ctx.stack().open_top() = ::std::move(xref);
+        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
-template<>
-struct AIR_Traits_Xop<xop_dec_post> : AIR_Traits<AIR_Node::S_apply_operator>
+template<Xop xopT>
+struct AIR_Traits_Xop_binary : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
-        // This operator is unary.
-        auto& lhs = ctx.stack().get_top().open();
-        Reference_root::S_temporary xref = { lhs };
-
-        // Decrement the operand and return the old value. `assign` is ignored.
-        if(lhs.is_integer()) {
-          auto& reg = lhs.open_integer();
-          reg = do_operator_SUB(reg, V_integer(1));
-        }
-        else if(lhs.is_real()) {
-          auto& reg = lhs.open_real();
-          reg = do_operator_SUB(reg, V_real(1));
-        }
-        else
-          ASTERIA_THROW("postfix decrement not applicable (operand was `$1`)", lhs);
+        // This operator is binary.
+        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
+        ctx.stack().pop();
+        AIR_Traits_Xop<xopT>::operate(ctx.stack().get_top().read(), xref.val);
 
-        ctx.stack().open_top() = ::std::move(xref);
+        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
-template<>
-struct AIR_Traits_Xop<xop_subscr> : AIR_Traits<AIR_Node::S_apply_operator>
+// Some binary operators specialize themselves after their first execution.
+// If both operands are integers or both are reals, the executor of the node is replaced
+// with a monomorphic one, which falls back to the generic executor when its guard fails.
+// The traits struct for each of them must contain the `integer()` and `real()` functions,
+// which store the result into the first argument, or return `false` to request the
+// generic path for the other operands.
+
+template<Xop xopT>
+struct AIR_Quick_Xop;
+
+template<typename TraitsT, typename UparamT, typename SparamT>
+inline
+AVMC_Queue::Executor&
+do_get_named_executor()
+noexcept
+  {
+    // Name the executor the first time it is used, so nodes can be told apart in dumps.
+    static AVMC_Queue::Executor_Name s_name = { executor_of<TraitsT, UparamT, SparamT>::thunk,
+                                                &typeid(TraitsT), nullptr };
+    static const bool s_named = (AVMC_Queue::register_executor(s_name), true);
+    static_cast<void>(s_named);
+    return executor_of<TraitsT, UparamT, SparamT>::thunk;
+  }
+
+template<typename TraitsT>
+inline
+void
+do_rebind_executor(const AVMC_Queue::Uparam& up)
+noexcept
+  {
+    AVMC_Queue::rebind_executor(up, do_get_named_executor<TraitsT, AVMC_Queue::Uparam, void>());
+  }
+
+template<Xop xopT>
+struct AIR_Traits_Xop_integer : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
         // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        const auto& rhs = ctx.stack().get_top().read();
+        const auto& lhs = ctx.stack().get_top(1).read();
+
+        Reference_root::S_temporary xref;
+        if(ROCKET_UNEXPECT(!lhs.is_integer() || !rhs.is_integer() ||
+                           !AIR_Quick_Xop<xopT>::integer(xref.val, lhs.as_integer(), rhs.as_integer()))) {
+          // Deoptimize this node.
+          do_rebind_executor<AIR_Traits_Xop_binary<xopT>>(up);
+          return AIR_Traits_Xop_binary<xopT>::execute(ctx, up);
+        }
         ctx.stack().pop();
-        auto& lref = ctx.stack().open_top();
-
-        // Append a reference modifier. `assign` is ignored.
-        if(rhs.is_integer()) {
-          auto& reg = rhs.open_integer();
-          Reference_modifier::S_array_index xmod = { ::std::move(reg) };
-          lref.zoom_in(::std::move(xmod));
-        }
-        else if(rhs.is_string()) {
-          auto& reg = rhs.open_string();
-          Reference_modifier::S_object_key xmod = { ::std::move(reg) };
-          lref.zoom_in(::std::move(xmod));
-        }
-        else
-          ASTERIA_THROW("subscript value not valid (subscript was `$1`)", rhs);
 
+        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
-template<>
-struct AIR_Traits_Xop<xop_pos> : AIR_Traits<AIR_Node::S_apply_operator>
+template<Xop xopT>
+struct AIR_Traits_Xop_real : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
+        // This operator is binary.
+        const auto& rhs = ctx.stack().get_top().read();
+        const auto& lhs = ctx.stack().get_top(1).read();
+
+        Reference_root::S_temporary xref;
+        if(ROCKET_UNEXPECT(!lhs.is_real() || !rhs.is_real() ||
+                           !AIR_Quick_Xop<xopT>::real(xref.val, lhs.as_real(), rhs.as_real()))) {
+          // Deoptimize this node.
+          do_rebind_executor<AIR_Traits_Xop_binary<xopT>>(up);
+          return AIR_Traits_Xop_binary<xopT>::execute(ctx, up);
+        }
+        ctx.stack().pop();
 
-        // Copy the operand to create a temporary value, then return it.
-        // N.B. This is one of the few operators that work on all types.
         do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
-template<>
-struct AIR_Traits_Xop<xop_neg> : AIR_Traits<AIR_Node::S_apply_operator>
+template<Xop xopT>
+struct AIR_Traits_Xop_quickened : AIR_Traits_Xop_binary<xopT>
   {
     static
     AIR_Status
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        // Observe the operands and specialize this node.
+        const auto& rhs = ctx.stack().get_top().read();
+        const auto& lhs = ctx.stack().get_top(1).read();
 
-        // Get the opposite of the operand as a temporary value, then return it.
-        if(rhs.is_integer()) {
-          auto& reg = rhs.open_integer();
-          reg = do_operator_NEG(reg);
-        }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_NEG(reg);
-        }
+        if(lhs.is_integer() && rhs.is_integer())
+          do_rebind_executor<AIR_Traits_Xop_integer<xopT>>(up);
+        else if(lhs.is_real() && rhs.is_real())
+          do_rebind_executor<AIR_Traits_Xop_real<xopT>>(up);
         else
-          ASTERIA_THROW("prefix negation not applicable (operand was `$1`)", rhs);
+          do_rebind_executor<AIR_Traits_Xop_binary<xopT>>(up);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+        // Take the generic path this time.
+        return AIR_Traits_Xop_binary<xopT>::execute(ctx, up);
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_notb> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_eq>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
-        // Perform bitwise NOT operation on the operand to create a temporary value, then return it.
-        if(rhs.is_boolean()) {
-          auto& reg = rhs.open_boolean();
-          reg = do_operator_NOT(reg);
-        }
-        else if(rhs.is_integer()) {
-          auto& reg = rhs.open_integer();
-          reg = do_operator_NOT(reg);
-        }
-        else if(rhs.is_string()) {
-          auto& reg = rhs.open_string();
-          reg = do_operator_NOT(::std::move(reg));
-        }
-        else
-          ASTERIA_THROW("prefix bitwise NOT not applicable (operand was `$1`)", rhs);
+        res = lhs == rhs;
+        return true;
+      }
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Unordered operands compare unequal.
+        res = lhs == rhs;
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_notl> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_ne>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
-        // Perform logical NOT operation on the operand to create a temporary value, then return it.
-        // N.B. This is one of the few operators that work on all types.
-        rhs = do_operator_NOT(rhs.test());
+        res = lhs != rhs;
+        return true;
+      }
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Unordered operands compare unequal.
+        res = lhs != rhs;
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_inc_pre> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_lt>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        auto& rhs = ctx.stack().get_top().open();
-
-        // Increment the operand and return it. `assign` is ignored.
-        if(rhs.is_integer()) {
-          auto& reg = rhs.open_integer();
-          reg = do_operator_ADD(reg, V_integer(1));
-        }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_ADD(reg, V_real(1));
-        }
-        else
-          ASTERIA_THROW("prefix increment not applicable (operand was `$1`)", rhs);
+        res = lhs < rhs;
+        return true;
+      }
 
-        return air_status_next;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Let the generic path throw an exception for unordered operands.
+        if(::std::isunordered(lhs, rhs))
+          return false;
+        res = lhs < rhs;
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_dec_pre> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_gt>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        auto& rhs = ctx.stack().get_top().open();
-
-        // Decrement the operand and return it. `assign` is ignored.
-        if(rhs.is_integer()) {
-          auto& reg = rhs.open_integer();
-          reg = do_operator_SUB(reg, V_integer(1));
-        }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_SUB(reg, V_real(1));
-        }
-        else
-          ASTERIA_THROW("prefix decrement not applicable (operand was `$1`)", rhs);
+        res = lhs > rhs;
+        return true;
+      }
 
-        return air_status_next;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Let the generic path throw an exception for unordered operands.
+        if(::std::isunordered(lhs, rhs))
+          return false;
+        res = lhs > rhs;
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_unset> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_lte>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().unset() };
+        res = lhs <= rhs;
+        return true;
+      }
 
-        // Unset the reference and return the old value.
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Let the generic path throw an exception for unordered operands.
+        if(::std::isunordered(lhs, rhs))
+          return false;
+        res = lhs <= rhs;
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_countof> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_cmp_gte>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        res = lhs >= rhs;
+        return true;
+      }
 
-        // Return the number of elements in the operand.
-        int64_t nelems;
-        switch(weaken_enum(rhs.vtype())) {
-          case vtype_null:
-            nelems = 0;
-            break;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        // Let the generic path throw an exception for unordered operands.
+        if(::std::isunordered(lhs, rhs))
+          return false;
+        res = lhs >= rhs;
+        return true;
+      }
+  };
 
-          case vtype_string:
-            nelems = rhs.as_string().ssize();
-            break;
+template<>
+struct AIR_Quick_Xop<xop_add>
+  {
+    static
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
+      {
+        res = do_operator_ADD(lhs, rhs);
+        return true;
+      }
 
-          case vtype_array:
-            nelems = rhs.as_array().ssize();
-            break;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        res = do_operator_ADD(lhs, rhs);
+        return true;
+      }
+  };
 
-          case vtype_object:
-            nelems = rhs.as_object().ssize();
-            break;
+template<>
+struct AIR_Quick_Xop<xop_sub>
+  {
+    static
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
+      {
+        res = do_operator_SUB(lhs, rhs);
+        return true;
+      }
 
-          default:
-            ASTERIA_THROW("prefix `countof` not applicable (operand was `$1`)", rhs);
-        }
-        rhs = nelems;
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        res = do_operator_SUB(lhs, rhs);
+        return true;
+      }
+  };
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+template<>
+struct AIR_Quick_Xop<xop_mul>
+  {
+    static
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
+      {
+        res = do_operator_MUL(lhs, rhs);
+        return true;
+      }
+
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        res = do_operator_MUL(lhs, rhs);
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_typeof> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Quick_Xop<xop_div>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        res = do_operator_DIV(lhs, rhs);
+        return true;
+      }
 
-        // Return the type name of the operand, which is static.
-        // N.B. This is one of the few operators that work on all types.
-        rhs = ::rocket::sref(rhs.what_vtype());
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        res = do_operator_DIV(lhs, rhs);
+        return true;
+      }
+  };
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+template<>
+struct AIR_Quick_Xop<xop_mod>
+  {
+    static
+    bool
+    integer(Value& res, int64_t lhs, int64_t rhs)
+      {
+        res = do_operator_MOD(lhs, rhs);
+        return true;
+      }
+
+    static
+    bool
+    real(Value& res, double lhs, double rhs)
+      {
+        res = do_operator_MOD(lhs, rhs);
+        return true;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sqrt> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_inc_post> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
       {
         // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        auto& lhs = ctx.stack().get_top().open();
+        Reference_root::S_temporary xref = { lhs };
 
-        // Get the square root of the operand as a temporary value, then return it.
-        if(rhs.is_integer()) {
-          // Note that `rhs` does not have type `V_real`, thus this branch can't be optimized.
-          rhs = do_operator_SQRT(rhs.as_integer());
+        // Increment the operand and return the old value. `assign` is ignored.
+        if(lhs.is_integer()) {
+          auto& reg = lhs.open_integer();
+          reg = do_operator_ADD(reg, V_integer(1));
         }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_SQRT(reg);
+        else if(lhs.is_real()) {
+          auto& reg = lhs.open_real();
+          reg = do_operator_ADD(reg, V_real(1));
         }
         else
-          ASTERIA_THROW("prefix `__sqrt` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("postfix increment not applicable (operand was `$1`)", lhs);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
+        ctx.stack().open_top() = ::std::move(xref);
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_isnan> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_dec_post> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
       {
         // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        auto& lhs = ctx.stack().get_top().open();
+        Reference_root::S_temporary xref = { lhs };
 
-        // Check whether the operand is a NaN, store the result in a temporary value, then return it.
-        if(rhs.is_integer()) {
-          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
-          rhs = do_operator_ISNAN(rhs.as_integer());
+        // Decrement the operand and return the old value. `assign` is ignored.
+        if(lhs.is_integer()) {
+          auto& reg = lhs.open_integer();
+          reg = do_operator_SUB(reg, V_integer(1));
         }
-        else if(rhs.is_real()) {
-          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
-          rhs = do_operator_ISNAN(rhs.as_real());
+        else if(lhs.is_real()) {
+          auto& reg = lhs.open_real();
+          reg = do_operator_SUB(reg, V_real(1));
         }
         else
-          ASTERIA_THROW("prefix `__isnan` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("postfix decrement not applicable (operand was `$1`)", lhs);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
+        ctx.stack().open_top() = ::std::move(xref);
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_isinf> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_subscr> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
       {
-        // This operator is unary.
+        // This operator is binary.
         Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
         auto& rhs = xref.val;
+        ctx.stack().pop();
+        auto& lref = ctx.stack().open_top();
 
-        // Check whether the operand is an infinity, store the result in a temporary value, then return it.
+        // Append a reference modifier. `assign` is ignored.
         if(rhs.is_integer()) {
-          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
-          rhs = do_operator_ISINF(rhs.as_integer());
+          auto& reg = rhs.open_integer();
+          Reference_modifier::S_array_index xmod = { ::std::move(reg) };
+          lref.zoom_in(::std::move(xmod));
         }
-        else if(rhs.is_real()) {
-          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
-          rhs = do_operator_ISINF(rhs.as_real());
+        else if(rhs.is_string()) {
+          auto& reg = rhs.open_string();
+          Reference_modifier::S_object_key xmod = { ::std::move(reg) };
+          lref.zoom_in(::std::move(xmod));
         }
         else
-          ASTERIA_THROW("prefix `__isinf` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("subscript value not valid (subscript was `$1`)", rhs);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_abs> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_pos> : AIR_Traits_Xop_unary<xop_pos>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& /*rhs*/)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        // Copy the operand to create a temporary value, then return it.
+        // N.B. This is one of the few operators that work on all types.
+      }
+  };
 
-        // Get the absolute value of the operand as a temporary value, then return it.
+template<>
+struct AIR_Traits_Xop<xop_neg> : AIR_Traits_Xop_unary<xop_neg>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Get the opposite of the operand as a temporary value, then return it.
         if(rhs.is_integer()) {
           auto& reg = rhs.open_integer();
-          reg = do_operator_ABS(reg);
+          reg = do_operator_NEG(reg);
         }
         else if(rhs.is_real()) {
           auto& reg = rhs.open_real();
-          reg = do_operator_ABS(reg);
+          reg = do_operator_NEG(reg);
         }
         else
-          ASTERIA_THROW("prefix `__abs` not applicable (operand was `$1`)", rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+          ASTERIA_THROW("prefix negation not applicable (operand was `$1`)", rhs);
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sign> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_notb> : AIR_Traits_Xop_unary<xop_notb>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
-        // Get the sign bit of the operand as a temporary value, then return it.
-        if(rhs.is_integer()) {
+        // Perform bitwise NOT operation on the operand to create a temporary value, then return it.
+        if(rhs.is_boolean()) {
+          auto& reg = rhs.open_boolean();
+          reg = do_operator_NOT(reg);
+        }
+        else if(rhs.is_integer()) {
           auto& reg = rhs.open_integer();
-          reg = do_operator_SIGN(reg);
+          reg = do_operator_NOT(reg);
         }
-        else if(rhs.is_real()) {
-          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
-          rhs = do_operator_SIGN(rhs.as_real());
+        else if(rhs.is_string()) {
+          auto& reg = rhs.open_string();
+          reg = do_operator_NOT(::std::move(reg));
         }
         else
-          ASTERIA_THROW("prefix `__sign` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("prefix bitwise NOT not applicable (operand was `$1`)", rhs);
+      }
+  };
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+template<>
+struct AIR_Traits_Xop<xop_notl> : AIR_Traits_Xop_unary<xop_notl>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Perform logical NOT operation on the operand to create a temporary value, then return it.
+        // N.B. This is one of the few operators that work on all types.
+        rhs = do_operator_NOT(rhs.test());
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_round> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_inc_pre> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
       {
         // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        auto& rhs = ctx.stack().get_top().open();
 
-        // Round the operand to the nearest integer as a temporary value, then return it.
+        // Increment the operand and return it. `assign` is ignored.
         if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
+          auto& reg = rhs.open_integer();
+          reg = do_operator_ADD(reg, V_integer(1));
         }
         else if(rhs.is_real()) {
           auto& reg = rhs.open_real();
-          reg = do_operator_ROUND(reg);
+          reg = do_operator_ADD(reg, V_real(1));
         }
         else
-          ASTERIA_THROW("prefix `__round` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("prefix increment not applicable (operand was `$1`)", rhs);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_floor> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_dec_pre> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/)
       {
         // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        auto& rhs = ctx.stack().get_top().open();
 
-        // Round the operand towards negative infinity as a temporary value, then return it.
+        // Decrement the operand and return it. `assign` is ignored.
         if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
+          auto& reg = rhs.open_integer();
+          reg = do_operator_SUB(reg, V_integer(1));
         }
         else if(rhs.is_real()) {
           auto& reg = rhs.open_real();
-          reg = do_operator_FLOOR(reg);
+          reg = do_operator_SUB(reg, V_real(1));
         }
         else
-          ASTERIA_THROW("prefix `__floor` not applicable (operand was `$1`)", rhs);
+          ASTERIA_THROW("prefix decrement not applicable (operand was `$1`)", rhs);
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_ceil> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_unset> : AIR_Traits<AIR_Node::S_apply_operator>
   {
     static
     AIR_Status
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
       {
         // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
-        // Round the operand towards negative infinity as a temporary value, then return it.
-        if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
-        }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_CEIL(reg);
-        }
-        else
-          ASTERIA_THROW("prefix `__ceil` not applicable (operand was `$1`)", rhs);
+        Reference_root::S_temporary xref = { ctx.stack().get_top().unset() };
 
+        // Unset the reference and return the old value.
         do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
         return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_trunc> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_countof> : AIR_Traits_Xop_unary<xop_countof>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        // Return the number of elements in the operand.
+        int64_t nelems;
+        switch(weaken_enum(rhs.vtype())) {
+          case vtype_null:
+            nelems = 0;
+            break;
 
-        // Round the operand towards negative infinity as a temporary value, then return it.
-        if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
-        }
-        else if(rhs.is_real()) {
-          auto& reg = rhs.open_real();
-          reg = do_operator_TRUNC(reg);
-        }
-        else
-          ASTERIA_THROW("prefix `__trunc` not applicable (operand was `$1`)", rhs);
+          case vtype_string:
+            nelems = rhs.as_string().ssize();
+            break;
 
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+          case vtype_array:
+            nelems = rhs.as_array().ssize();
+            break;
+
+          case vtype_object:
+            nelems = rhs.as_object().ssize();
+            break;
+
+          default:
+            ASTERIA_THROW("prefix `countof` not applicable (operand was `$1`)", rhs);
+        }
+        rhs = nelems;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_roundi> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_typeof> : AIR_Traits_Xop_unary<xop_typeof>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        // Return the type name of the operand, which is static.
+        // N.B. This is one of the few operators that work on all types.
+        rhs = ::rocket::sref(rhs.what_vtype());
+      }
+  };
 
-        // Round the operand to the nearest integer as a temporary value, then return it as an `integer`.
+template<>
+struct AIR_Traits_Xop<xop_sqrt> : AIR_Traits_Xop_unary<xop_sqrt>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Get the square root of the operand as a temporary value, then return it.
         if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
+          // Note that `rhs` does not have type `V_real`, thus this branch can't be optimized.
+          rhs = do_operator_SQRT(rhs.as_integer());
         }
         else if(rhs.is_real()) {
-          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
-          rhs = do_operator_ROUNDi(rhs.as_real());
+          auto& reg = rhs.open_real();
+          reg = do_operator_SQRT(reg);
         }
         else
-          ASTERIA_THROW("prefix `__roundi` not applicable (operand was `$1`)", rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+          ASTERIA_THROW("prefix `__sqrt` not applicable (operand was `$1`)", rhs);
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_floori> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_isnan> : AIR_Traits_Xop_unary<xop_isnan>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
-        // Round the operand towards negative infinity as a temporary value, then return it as an `integer`.
+        // Check whether the operand is a NaN, store the result in a temporary value, then return it.
         if(rhs.is_integer()) {
-          // No conversion is required.
-          // Return `rhs` as is.
+          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
+          rhs = do_operator_ISNAN(rhs.as_integer());
         }
         else if(rhs.is_real()) {
-          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
-          rhs = do_operator_FLOORi(rhs.as_real());
+          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
+          rhs = do_operator_ISNAN(rhs.as_real());
         }
         else
-          ASTERIA_THROW("prefix `__floori` not applicable (operand was `$1`)", rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
+          ASTERIA_THROW("prefix `__isnan` not applicable (operand was `$1`)", rhs);
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_ceili> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_isinf> : AIR_Traits_Xop_unary<xop_isinf>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
+        // Check whether the operand is an infinity, store the result in a temporary value, then return it.
+        if(rhs.is_integer()) {
+          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
+          rhs = do_operator_ISINF(rhs.as_integer());
+        }
+        else if(rhs.is_real()) {
+          // Note that `rhs` does not have type `V_boolean`, thus this branch can't be optimized.
+          rhs = do_operator_ISINF(rhs.as_real());
+        }
+        else
+          ASTERIA_THROW("prefix `__isinf` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_abs> : AIR_Traits_Xop_unary<xop_abs>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Get the absolute value of the operand as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          auto& reg = rhs.open_integer();
+          reg = do_operator_ABS(reg);
+        }
+        else if(rhs.is_real()) {
+          auto& reg = rhs.open_real();
+          reg = do_operator_ABS(reg);
+        }
+        else
+          ASTERIA_THROW("prefix `__abs` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_sign> : AIR_Traits_Xop_unary<xop_sign>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Get the sign bit of the operand as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          auto& reg = rhs.open_integer();
+          reg = do_operator_SIGN(reg);
+        }
+        else if(rhs.is_real()) {
+          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
+          rhs = do_operator_SIGN(rhs.as_real());
+        }
+        else
+          ASTERIA_THROW("prefix `__sign` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_round> : AIR_Traits_Xop_unary<xop_round>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand to the nearest integer as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          auto& reg = rhs.open_real();
+          reg = do_operator_ROUND(reg);
+        }
+        else
+          ASTERIA_THROW("prefix `__round` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_floor> : AIR_Traits_Xop_unary<xop_floor>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand towards negative infinity as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          auto& reg = rhs.open_real();
+          reg = do_operator_FLOOR(reg);
+        }
+        else
+          ASTERIA_THROW("prefix `__floor` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_ceil> : AIR_Traits_Xop_unary<xop_ceil>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand towards negative infinity as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          auto& reg = rhs.open_real();
+          reg = do_operator_CEIL(reg);
+        }
+        else
+          ASTERIA_THROW("prefix `__ceil` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_trunc> : AIR_Traits_Xop_unary<xop_trunc>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand towards negative infinity as a temporary value, then return it.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          auto& reg = rhs.open_real();
+          reg = do_operator_TRUNC(reg);
+        }
+        else
+          ASTERIA_THROW("prefix `__trunc` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_roundi> : AIR_Traits_Xop_unary<xop_roundi>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand to the nearest integer as a temporary value, then return it as an `integer`.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
+          rhs = do_operator_ROUNDi(rhs.as_real());
+        }
+        else
+          ASTERIA_THROW("prefix `__roundi` not applicable (operand was `$1`)", rhs);
+      }
+  };
+
+template<>
+struct AIR_Traits_Xop<xop_floori> : AIR_Traits_Xop_unary<xop_floori>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
+        // Round the operand towards negative infinity as a temporary value, then return it as an `integer`.
+        if(rhs.is_integer()) {
+          // No conversion is required.
+          // Return `rhs` as is.
+        }
+        else if(rhs.is_real()) {
+          // Note that `rhs` does not have type `V_integer`, thus this branch can't be optimized.
+          rhs = do_operator_FLOORi(rhs.as_real());
+        }
+        else
+          ASTERIA_THROW("prefix `__floori` not applicable (operand was `$1`)", rhs);
+      }
+  };
 
+template<>
+struct AIR_Traits_Xop<xop_ceili> : AIR_Traits_Xop_unary<xop_ceili>
+  {
+    static
+    void
+    operate(Value& rhs)
+      {
         // Round the operand towards negative infinity as a temporary value, then return it as an `integer`.
         if(rhs.is_integer()) {
           // No conversion is required.
@@ -2707,23 +3281,16 @@ struct AIR_Traits_Xop<xop_ceili> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("prefix `__ceili` not applicable (operand was `$1`)", rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_trunci> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_trunci> : AIR_Traits_Xop_unary<xop_trunci>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(Value& rhs)
       {
-        // This operator is unary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-
         // Round the operand towards negative infinity as a temporary value, then return it as an `integer`.
         if(rhs.is_integer()) {
           // No conversion is required.
@@ -2735,167 +3302,104 @@ struct AIR_Traits_Xop<xop_trunci> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("prefix `__trunci` not applicable (operand was `$1`)", rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_eq> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_eq> : AIR_Traits_Xop_quickened<xop_cmp_eq>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Report unordered operands as being unequal.
         // N.B. This is one of the few operators that work on all types.
         auto comp = lhs.compare(rhs);
         rhs = comp == compare_equal;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_ne> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_ne> : AIR_Traits_Xop_quickened<xop_cmp_ne>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Report unordered operands as being unequal.
         // N.B. This is one of the few operators that work on all types.
         auto comp = lhs.compare(rhs);
         rhs = comp != compare_equal;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_lt> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_lt> : AIR_Traits_Xop_quickened<xop_cmp_lt>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Throw an exception if the operands compare unequal.
         auto comp = lhs.compare(rhs);
         if(comp == compare_unordered)
           ASTERIA_THROW("values not comparable (operands were `$1` and `$2`)", lhs, rhs);
         rhs = comp == compare_less;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_gt> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_gt> : AIR_Traits_Xop_quickened<xop_cmp_gt>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Throw an exception if the operands compare unequal.
         auto comp = lhs.compare(rhs);
         if(comp == compare_unordered)
           ASTERIA_THROW("values not comparable (operands were `$1` and `$2`)", lhs, rhs);
         rhs = comp == compare_greater;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_lte> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_lte> : AIR_Traits_Xop_quickened<xop_cmp_lte>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Throw an exception if the operands compare unequal.
         auto comp = lhs.compare(rhs);
         if(comp == compare_unordered)
           ASTERIA_THROW("values not comparable (operands were `$1` and `$2`)", lhs, rhs);
         rhs = comp != compare_greater;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_gte> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_gte> : AIR_Traits_Xop_quickened<xop_cmp_gte>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Throw an exception if the operands compare unequal.
         auto comp = lhs.compare(rhs);
         if(comp == compare_unordered)
           ASTERIA_THROW("values not comparable (operands were `$1` and `$2`)", lhs, rhs);
         rhs = comp != compare_less;
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_cmp_3way> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_cmp_3way> : AIR_Traits_Xop_binary<xop_cmp_3way>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         // Report unordered operands as being unequal.
         // N.B. This is one of the few operators that work on all types.
         auto comp = lhs.compare(rhs);
@@ -2919,25 +3423,16 @@ struct AIR_Traits_Xop<xop_cmp_3way> : AIR_Traits<AIR_Node::S_apply_operator>
           default:
             ROCKET_ASSERT(false);
         }
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_add> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_add> : AIR_Traits_Xop_quickened<xop_add>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical OR'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -2959,25 +3454,16 @@ struct AIR_Traits_Xop<xop_add> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix addition not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sub> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_sub> : AIR_Traits_Xop_quickened<xop_sub>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical XOR'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -2994,25 +3480,16 @@ struct AIR_Traits_Xop<xop_sub> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix subtraction not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_mul> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_mul> : AIR_Traits_Xop_quickened<xop_mul>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical AND'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -3039,25 +3516,16 @@ struct AIR_Traits_Xop<xop_mul> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix multiplication not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_div> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_div> : AIR_Traits_Xop_quickened<xop_div>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // For the `integer` and `real` types, return the quotient of both operands.
           auto& reg = rhs.open_integer();
@@ -3069,25 +3537,16 @@ struct AIR_Traits_Xop<xop_div> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix division not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_mod> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_mod> : AIR_Traits_Xop_quickened<xop_mod>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // For the `integer` and `real` types, return the remainder of both operands.
           auto& reg = rhs.open_integer();
@@ -3099,25 +3558,16 @@ struct AIR_Traits_Xop<xop_mod> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix modulo not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sll> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_sll> : AIR_Traits_Xop_binary<xop_sll>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // If the LHS operand has type `integer`, shift the LHS operand to the left by the number of bits
           // specified by the RHS operand. Bits shifted out are discarded. Bits shifted in are filled with zeroes.
@@ -3132,25 +3582,16 @@ struct AIR_Traits_Xop<xop_sll> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix logical left shift not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_srl> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_srl> : AIR_Traits_Xop_binary<xop_srl>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // If the LHS operand has type `integer`, shift the LHS operand to the right by the number of bits
           // specified by the RHS operand. Bits shifted out are discarded. Bits shifted in are filled with zeroes.
@@ -3165,25 +3606,16 @@ struct AIR_Traits_Xop<xop_srl> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix logical right shift not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sla> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_sla> : AIR_Traits_Xop_binary<xop_sla>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // If the LHS operand is of type `integer`, shift the LHS operand to the left by the number of bits
           // specified by the RHS operand. Bits shifted out that are equal to the sign bit are discarded. Bits
@@ -3199,25 +3631,16 @@ struct AIR_Traits_Xop<xop_sla> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix arithmetic left shift not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_sra> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_sra> : AIR_Traits_Xop_binary<xop_sra>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_integer() && rhs.is_integer()) {
           // If the LHS operand is of type `integer`, shift the LHS operand to the right by the number of bits
           // specified by the RHS operand. Bits shifted out are discarded. Bits shifted in are filled with the
@@ -3232,25 +3655,16 @@ struct AIR_Traits_Xop<xop_sra> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix arithmetic right shift not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_andb> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_andb> : AIR_Traits_Xop_binary<xop_andb>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical AND'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -3269,25 +3683,16 @@ struct AIR_Traits_Xop<xop_andb> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix bitwise AND not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_orb> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_orb> : AIR_Traits_Xop_binary<xop_orb>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical OR'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -3306,25 +3711,16 @@ struct AIR_Traits_Xop<xop_orb> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix bitwise OR not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
 template<>
-struct AIR_Traits_Xop<xop_xorb> : AIR_Traits<AIR_Node::S_apply_operator>
+struct AIR_Traits_Xop<xop_xorb> : AIR_Traits_Xop_binary<xop_xorb>
   {
     static
-    AIR_Status
-    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up)
+    void
+    operate(const Value& lhs, Value& rhs)
       {
-        // This operator is binary.
-        Reference_root::S_temporary xref = { ctx.stack().get_top().read() };
-        auto& rhs = xref.val;
-        ctx.stack().pop();
-        const auto& lhs = ctx.stack().get_top().read();
-
         if(lhs.is_boolean() && rhs.is_boolean()) {
           // For the `boolean` type, return the logical XOR'd result of both operands.
           auto& reg = rhs.open_boolean();
@@ -3343,9 +3739,6 @@ struct AIR_Traits_Xop<xop_xorb> : AIR_Traits<AIR_Node::S_apply_operator>
         }
         else
           ASTERIA_THROW("infix bitwise XOR not applicable (operands were `$1` and `$2`)", lhs, rhs);
-
-        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
-        return air_status_next;
       }
   };
 
@@ -3586,6 +3979,13 @@ struct AIR_Traits<AIR_Node::S_define_null_variable>
     AIR_Status
     execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_sloc_name& sp)
       {
+        // If the variable is never referenced, only its slot is reserved, so slots of
+        // subsequent variables match those resolved at compile time.
+        if(ROCKET_UNEXPECT(sp.name.empty())) {
+          ctx.append_unhashed_reference(sp.name);
+          return air_status_next;
+        }
+
         // Allocate an uninitialized variable.
         auto gcoll = ctx.global().genius_collector();
         auto var = gcoll->create_variable();
@@ -3595,8 +3995,8 @@ struct AIR_Traits<AIR_Node::S_define_null_variable>
         ctx.open_named_reference(sp.name) = ::std::move(xref);
 
         // Call the hook function if any.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_variable_declare(sp.sloc, sp.name);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_variable_declare(sp.sloc, sp.name);
 
         // Initialize the variable to `null`.
         var->initialize(V_null(), up.v8s[0]);
@@ -3631,8 +4031,8 @@ struct AIR_Traits<AIR_Node::S_single_step_trap>
     execute(Executive_Context& ctx, const Source_Location& sloc)
       {
         // Call the hook function if any.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_single_step_trap(sloc);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_single_step_trap(sloc);
 
         return air_status_next;
       }
@@ -3677,8 +4077,8 @@ struct AIR_Traits<AIR_Node::S_variadic_call>
         const auto sentry = ctx.global().copy_recursion_sentry();
 
         // Generate a single-step trap.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_single_step_trap(sloc);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_single_step_trap(sloc);
 
         // Pop the argument generator.
         cow_vector<Reference> args;
@@ -3835,8 +4235,8 @@ struct AIR_Traits<AIR_Node::S_import_call>
         const auto sentry = ctx.global().copy_recursion_sentry();
 
         // Generate a single-step trap.
-        if(auto qhooks = ctx.global().get_hooks_opt())
-          qhooks->on_single_step_trap(sp.sloc);
+        if(ROCKET_UNEXPECT(ctx.global().has_hooks()))
+          ctx.global().get_hooks_opt()->on_single_step_trap(sp.sloc);
 
         // Pop arguments off the stack backwards.
         ROCKET_ASSERT(up.y32 != 0);
@@ -3871,17 +4271,30 @@ struct AIR_Traits<AIR_Node::S_import_call>
         Loader_Lock::Unique_Stream strm;
         strm.reset(ctx.global().loader_lock(), path.safe_c_str());
 
-        // Parse source code.
-        Token_Stream tstrm(sp.opts);
-        tstrm.reload(strm, path);
-
-        Statement_Sequence stmtq(sp.opts);
-        stmtq.reload(tstrm);
+        // Reuse the function if this file has been compiled with the same options.
+        // The stream is locked nevertheless, so recursive imports can be detected.
+        auto modcache = ctx.global().module_cache();
+        auto stamp = Module_Cache::get_stamp(strm.get().get_handle());
+        auto qtarget = modcache->get_opt(path, stamp, sp.opts);
+        if(!qtarget) {
+          // The cache file is used if requested.
+          auto qhooks = ctx.global().get_hooks_opt();
+          if(qhooks)
+            qhooks->on_module_compile_begin(sp.sloc, path);
+
+          try {
+            qtarget = compile_script_file(sp.opts, strm, path);
+          }
+          catch(...) {
+            if(qhooks)
+              qhooks->on_module_compile_end(sp.sloc, path);
+            throw;
+          }
+          if(qhooks)
+            qhooks->on_module_compile_end(sp.sloc, path);
 
-        // Instantiate the function.
-        AIR_Optimizer optmz(sp.opts);
-        optmz.reload(nullptr, cow_vector<phsh_string>(1, ::rocket::sref("...")), stmtq);
-        auto qtarget = optmz.create_function(Source_Location(path, 0, 0), ::rocket::sref("<file scope>"));
+          modcache->insert(path, stamp, sp.opts, qtarget);
+        }
 
         // Update the first argument to `import` if it was passed by reference.
         // `this` is null for imported scripts.
@@ -4080,246 +4493,613 @@ struct AIR_Traits<AIR_Node::S_break_or_continue>
       }
   };
 
-// These are helper type traits.
-// Depending on the existence of Uparam, Sparam and Symbols, the code will look very different.
-
-// check for `make_uparam`
-template<typename TraitsT, typename XaNodeT, typename = void>
-struct Uparam_of
-  : ::std::enable_if<true>  // `::type` is void
-  { };
-
-template<typename TraitsT, typename XaNodeT>
-struct Uparam_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_uparam))>
-  : ::std::decay<decltype(TraitsT::make_uparam(::std::declval<bool&>(), ::std::declval<const XaNodeT&>()))>
-  { };
-
-// check for `make_sparam`
-template<typename TraitsT, typename XaNodeT, typename = void>
-struct Sparam_of
-  : ::std::enable_if<true>  // `::type` is void
-  { };
-
-template<typename TraitsT, typename XaNodeT>
-struct Sparam_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_sparam))>
-  : ::std::decay<decltype(TraitsT::make_sparam(::std::declval<bool&>(), ::std::declval<const XaNodeT&>()))>
-  { };
-
-// check for `make_symbols`
-template<typename TraitsT, typename XaNodeT, typename = void>
-struct Symbols_of
-  : ::std::enable_if<true>  // `::type` is void
-  { };
-
-template<typename TraitsT, typename XaNodeT>
-struct Symbols_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_symbols))>
-  : ::std::decay<decltype(TraitsT::make_symbols(::std::declval<const XaNodeT&>()))>
-  { };
+// These are pseudo AIR nodes, which are fused from common sequences of real ones.
+// They only exist during solidification.
 
-// executor thunk
-template<typename TraitsT, typename UparamT, typename SparamT>
-struct executor_of
+// immediate, binary operator
+struct Fused_xop_immediate
   {
-    static
-    AIR_Status
-    thunk(Executive_Context& ctx, AVMC_Queue::Uparam up, const void* sp)
-      { return TraitsT::execute(ctx, UparamT(up), *(const SparamT*)sp);  }
+    Source_Location sloc;
+    bool assign;
+    Value value;
   };
 
-template<typename TraitsT, typename UparamT>
-struct executor_of<TraitsT, UparamT, void>
+// local reference, immediate, binary operator
+struct Fused_local_xop_immediate
   {
-    static
-    AIR_Status
-    thunk(Executive_Context& ctx, AVMC_Queue::Uparam up, const void* /*sp*/)
-      { return TraitsT::execute(ctx, UparamT(up));  }
+    Source_Location sloc;
+    bool assign;
+    uint32_t depth;
+    uint32_t slot;
+    phsh_string name;
+    Value value;
   };
 
-template<typename TraitsT, typename SparamT>
-struct executor_of<TraitsT, void, SparamT>
+// [immediate], comparison operator, `if` statement
+struct Fused_compare_branch
   {
-    static
-    AIR_Status
-    thunk(Executive_Context& ctx, AVMC_Queue::Uparam /*up*/, const void* sp)
-      { return TraitsT::execute(ctx, *(const SparamT*)sp);  }
+    Source_Location sloc;
+    bool negative;
+    opt<Value> value_opt;
+    cow_vector<AIR_Node> code_true;
+    cow_vector<AIR_Node> code_false;
   };
 
-template<typename TraitsT>
-struct executor_of<TraitsT, void, void>
+// `for` statement with an integer induction variable, such as `for(var i = a; i < b; ++i)`
+struct Counted_for
   {
-    static
-    AIR_Status
-    thunk(Executive_Context& ctx, AVMC_Queue::Uparam /*up*/, const void* /*sp*/)
-      { return TraitsT::execute(ctx);  }
+    bool inclusive;
+    uint32_t slot;
+    phsh_string name;
+    cow_vector<AIR_Node> code_init;
+    cow_vector<AIR_Node> code_bound;
+    cow_vector<AIR_Node> code_cond;
+    cow_vector<AIR_Node> code_step;
+    cow_vector<AIR_Node> code_body;
   };
 
-// enumerator thunk
-template<typename SparamT, typename = void>
-struct enumerator_of
+struct Sparam_local_immediate
   {
-    static constexpr AVMC_Queue::Enumerator* thunk = nullptr;
+    bool assign;
+    phsh_string name;
+    Value value;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const
+      {
+        return this->value.enumerate_variables(callback);
+      }
   };
 
-template<typename SparamT>
-struct enumerator_of<SparamT, ROCKET_VOID_T(decltype(&SparamT::enumerate_variables))>
+struct Sparam_compare_branch
   {
-    static
+    array<AVMC_Queue, 2> queues;
+    Value value;
+
     Variable_Callback&
-    thunk(Variable_Callback& callback, AVMC_Queue::Uparam /*up*/, const void* sp)
-      { return ((const SparamT*)sp)->enumerate_variables(callback);  }
+    enumerate_variables(Variable_Callback& callback)
+    const
+      {
+        ::rocket::for_each(this->queues, callback);
+        return this->value.enumerate_variables(callback);
+      }
   };
 
-// Finally...
-template<typename TraitsT, typename XaNodeT, typename UparamT, typename SparamT, typename SymbolT>
-struct AVMC_Appender
+struct Sparam_counted_for
   {
-    static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
-      {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, UparamT, SparamT>::thunk,
-                              enumerator_of<SparamT>::thunk>(
-                              TraitsT::make_symbols(altr),
-                              TraitsT::make_uparam(reachable, altr),
-                              TraitsT::make_sparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+    phsh_string name;
+    AVMC_Queue queue_init;
+    AVMC_Queue queue_bound;
+    AVMC_Queue queue_cond;
+    AVMC_Queue queue_step;
+    AVMC_Queue queue_body;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const
+      {
+        this->queue_init.enumerate_variables(callback);
+        this->queue_bound.enumerate_variables(callback);
+        this->queue_cond.enumerate_variables(callback);
+        this->queue_step.enumerate_variables(callback);
+        this->queue_body.enumerate_variables(callback);
+        return callback;
       }
   };
 
-template<typename TraitsT, typename XaNodeT, typename UparamT, typename SparamT>
-struct AVMC_Appender<TraitsT, XaNodeT, UparamT, SparamT, void>
+template<Xop xopT>
+struct AIR_Traits_Fused_xop_immediate
   {
+    // `Uparam` is `assign`.
+    // `Sparam` is the right-hand operand.
+
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const Fused_xop_immediate& altr)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, UparamT, SparamT>::thunk,
-                              enumerator_of<SparamT>::thunk>(
-                              TraitsT::make_uparam(reachable, altr),
-                              TraitsT::make_sparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+        AVMC_Queue::Uparam up;
+        up.v8s[0] = altr.assign;
+        return up;
       }
-  };
 
-template<typename TraitsT, typename XaNodeT, typename UparamT, typename SymbolT>
-struct AVMC_Appender<TraitsT, XaNodeT, UparamT, void, SymbolT>
-  {
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    Value
+    make_sparam(bool& /*reachable*/, const Fused_xop_immediate& altr)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, UparamT, void>::thunk,
-                              nullptr>(
-                              TraitsT::make_symbols(altr),
-                              TraitsT::make_uparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+        return altr.value;
       }
-  };
 
-template<typename TraitsT, typename XaNodeT, typename UparamT>
-struct AVMC_Appender<TraitsT, XaNodeT, UparamT, void, void>
-  {
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    AVMC_Queue::Symbols
+    make_symbols(const Fused_xop_immediate& altr)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, UparamT, void>::thunk,
-                              nullptr>(
-                              TraitsT::make_uparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+        AVMC_Queue::Symbols syms;
+        syms.sloc = altr.sloc;
+        return syms;
       }
-  };
 
-template<typename TraitsT, typename XaNodeT, typename SparamT, typename SymbolT>
-struct AVMC_Appender<TraitsT, XaNodeT, void, SparamT, SymbolT>
-  {
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    AIR_Status
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Value& value)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, void, SparamT>::thunk,
-                              enumerator_of<SparamT>::thunk>(
-                              TraitsT::make_symbols(altr),
-                              AVMC_Queue::Uparam(),
-                              TraitsT::make_sparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+        // The right-hand operand is not pushed.
+        Reference_root::S_temporary xref = { value };
+        AIR_Traits_Xop<xopT>::operate(ctx.stack().get_top().read(), xref.val);
+
+        do_set_temporary(ctx, up.v8s[0], ::std::move(xref));
+        return air_status_next;
       }
   };
 
-template<typename TraitsT, typename XaNodeT, typename SparamT>
-struct AVMC_Appender<TraitsT, XaNodeT, void, SparamT, void>
+template<Xop xopT>
+struct AIR_Traits_Fused_local_xop_immediate
   {
+    // `Uparam` is the depth and slot.
+    // `Sparam` is `assign`, the name and the right-hand operand.
+
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const Fused_local_xop_immediate& altr)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, void, SparamT>::thunk,
-                              enumerator_of<SparamT>::thunk>(
-                              AVMC_Queue::Uparam(),
-                              TraitsT::make_sparam(reachable, altr));
-        queue.shrink_to_fit();
-        return reachable;
+        AVMC_Queue::Uparam up;
+        up.x16 = static_cast<uint16_t>(::rocket::min(altr.slot, uint32_t(UINT16_MAX)));
+        up.x32 = altr.depth;
+        return up;
+      }
+
+    static
+    Sparam_local_immediate
+    make_sparam(bool& /*reachable*/, const Fused_local_xop_immediate& altr)
+      {
+        Sparam_local_immediate sp;
+        sp.assign = altr.assign;
+        sp.name = altr.name;
+        sp.value = altr.value;
+        return sp;
+      }
+
+    static
+    AVMC_Queue::Symbols
+    make_symbols(const Fused_local_xop_immediate& altr)
+      {
+        AVMC_Queue::Symbols syms;
+        syms.sloc = altr.sloc;
+        return syms;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_local_immediate& sp)
+      {
+        // Neither operand is pushed.
+        const auto& ref = do_get_local_reference(ctx, up.x32, up.x16, sp.name);
+        Reference_root::S_temporary xref = { sp.value };
+        AIR_Traits_Xop<xopT>::operate(ref.read(), xref.val);
+
+        // If `assign` is set, write the result to the local reference and push the reference.
+        // Otherwise, push the result as a temporary value.
+        if(sp.assign) {
+          ctx.stack().push(ref);
+          ctx.stack().get_top().open() = ::std::move(xref.val);
+          return air_status_next;
+        }
+        ctx.stack().push(::std::move(xref));
+        return air_status_next;
       }
   };
 
-template<typename TraitsT, typename XaNodeT, typename SymbolT>
-struct AVMC_Appender<TraitsT, XaNodeT, void, void, SymbolT>
+template<Xop xopT>
+struct AIR_Traits_Fused_compare_branch
   {
+    // `Uparam` is `negative` and whether the right-hand operand is an immediate.
+    // `Sparam` is the two branches and the right-hand operand.
+
     static
-    bool
-    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const Fused_compare_branch& altr)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, void, void>::thunk,
-                              nullptr>(
-                              TraitsT::make_symbols(altr),
-                              AVMC_Queue::Uparam());
-        queue.shrink_to_fit();
-        return reachable;
+        AVMC_Queue::Uparam up;
+        up.v8s[0] = altr.negative;
+        up.v8s[1] = !!altr.value_opt;
+        return up;
+      }
+
+    static
+    Sparam_compare_branch
+    make_sparam(bool& reachable, const Fused_compare_branch& altr)
+      {
+        Sparam_compare_branch sp;
+        bool rtrue = do_solidify_code(sp.queues[0], altr.code_true);
+        bool rfalse = do_solidify_code(sp.queues[1], altr.code_false);
+        reachable &= rtrue | rfalse;
+        if(altr.value_opt)
+          sp.value = *(altr.value_opt);
+        return sp;
+      }
+
+    static
+    AVMC_Queue::Symbols
+    make_symbols(const Fused_compare_branch& altr)
+      {
+        AVMC_Queue::Symbols syms;
+        syms.sloc = altr.sloc;
+        return syms;
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_compare_branch& sp)
+      {
+        // Get the right-hand operand.
+        Reference_root::S_temporary xref;
+        if(up.v8s[1]) {
+          xref.val = sp.value;
+        }
+        else {
+          xref.val = ctx.stack().get_top().read();
+          ctx.stack().pop();
+        }
+        AIR_Traits_Xop<xopT>::operate(ctx.stack().get_top().read(), xref.val);
+
+        // The result is left on the stack, as the condition of the `if` statement.
+        bool cond = xref.val.test();
+        do_set_temporary(ctx, false, ::std::move(xref));
+
+        // Check the value of the condition.
+        if(cond != up.v8s[0])
+          // Execute the true branch and forward the status verbatim.
+          return sp.queues[0].execute(ctx);
+
+        // Execute the false branch and forward the status verbatim.
+        return sp.queues[1].execute(ctx);
       }
   };
 
-template<typename TraitsT, typename XaNodeT>
-struct AVMC_Appender<TraitsT, XaNodeT, void, void, void>
+struct AIR_Traits_Counted_for
   {
+    // `Uparam` is whether the body has its own scope, `inclusive` and `slot`.
+    // `Sparam` is ... everything.
+
+    static
+    AVMC_Queue::Uparam
+    make_uparam(bool& /*reachable*/, const Counted_for& altr)
+      {
+        AVMC_Queue::Uparam up;
+        up.y8s[0] = do_is_scoped_body(altr.code_body);
+        up.y8s[1] = altr.inclusive;
+        up.y32 = altr.slot;
+        return up;
+      }
+
+    static
+    Sparam_counted_for
+    make_sparam(bool& /*reachable*/, const Counted_for& altr)
+      {
+        Sparam_counted_for sp;
+        sp.name = altr.name;
+        do_solidify_code(sp.queue_init, altr.code_init);
+        do_solidify_code(sp.queue_bound, altr.code_bound);
+        do_solidify_code(sp.queue_cond, altr.code_cond);
+        do_solidify_code(sp.queue_step, altr.code_step);
+        do_solidify_loop_body(sp.queue_body, altr.code_body);
+        return sp;
+      }
+
     static
     bool
-    do_append(AVMC_Queue& queue, const XaNodeT& /*altr*/)
+    do_check_condition(Executive_Context& ctx_for, const AVMC_Queue::Uparam& up,
+                       const Sparam_counted_for& sp, const Variable* qvar)
       {
-        bool reachable = true;
-        queue.template append<executor_of<TraitsT, void, void>::thunk,
-                              nullptr>(
-                              AVMC_Queue::Uparam());
-        queue.shrink_to_fit();
-        return reachable;
+        // Evaluate the bound, which is usually a constant or a plain reference.
+        auto status = sp.queue_bound.execute(ctx_for);
+        ROCKET_ASSERT(status == air_status_next);
+        const auto& bound = ctx_for.stack().get_top().read();
+
+        // Compare integers natively.
+        if(qvar && qvar->get_value().is_integer() && bound.is_integer()) {
+          auto value = qvar->get_value().as_integer();
+          return up.y8s[1] ? (value <= bound.as_integer()) : (value < bound.as_integer());
+        }
+
+        // Fall back to the original condition.
+        status = sp.queue_cond.execute(ctx_for);
+        ROCKET_ASSERT(status == air_status_next);
+        return ctx_for.stack().get_top().read().test();
+      }
+
+    static
+    void
+    do_step(Executive_Context& ctx_for, const Sparam_counted_for& sp, Variable* qvar)
+      {
+        // Increment integers natively, unless that would overflow.
+        if(qvar && !qvar->is_immutable() && qvar->get_value().is_integer() &&
+           (qvar->get_value().as_integer() != INT64_MAX)) {
+          qvar->open_value().open_integer() += 1;
+          return;
+        }
+
+        // Fall back to the original increment, which throws exceptions as appropriate.
+        auto status = sp.queue_step.execute(ctx_for);
+        ROCKET_ASSERT(status == air_status_next);
+      }
+
+    static
+    AIR_Status
+    execute(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const Sparam_counted_for& sp)
+      {
+        // This is the same as the generic `for` statement, except that the induction variable is
+        // compared and incremented natively if it is an integer.
+        Executive_Context ctx_for(::rocket::ref(ctx));
+        auto status = sp.queue_init.execute(ctx_for);
+        ROCKET_ASSERT(status == air_status_next);
+
+        // Get the induction variable, which has been declared by the initializer.
+        auto var = do_get_local_reference(ctx_for, 0, up.y32, sp.name).get_variable_opt();
+        Executive_Context ctx_body(::rocket::ref(ctx_for));
+        for(;;) {
+          // Check the condition.
+          if(!do_check_condition(ctx_for, up, sp, var.get()))
+            break;
+
+          // Execute the body.
+          status = do_execute_loop_body(sp.queue_body, up.y8s[0], ctx_for, ctx_body);
+          if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for }))
+            break;
+          if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                            air_status_continue_for }))
+            return status;
+
+          // Execute the increment.
+          do_step(ctx_for, sp, var.get());
+        }
+        return air_status_next;
       }
   };
 
+// These are helper type traits.
+// Depending on the existence of Uparam, Sparam and Symbols, the code will look very different.
+
+// check for `make_uparam`
+template<typename TraitsT, typename XaNodeT, typename = void>
+struct Uparam_of
+  : ::std::enable_if<true>  // `::type` is void
+  { };
+
 template<typename TraitsT, typename XaNodeT>
-inline
-bool
-do_solidify_explicit(AVMC_Queue& queue, const XaNodeT& altr)
-  {
-    return AVMC_Appender<TraitsT, XaNodeT,
-                         typename Uparam_of<TraitsT, XaNodeT>::type,
-                         typename Sparam_of<TraitsT, XaNodeT>::type,
-                         typename Symbols_of<TraitsT, XaNodeT>::type>
-             ::do_append(queue, altr);
-  }
+struct Uparam_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_uparam))>
+  : ::std::decay<decltype(TraitsT::make_uparam(::std::declval<bool&>(), ::std::declval<const XaNodeT&>()))>
+  { };
 
-template<typename XaNodeT>
-inline
+// check for `make_sparam`
+template<typename TraitsT, typename XaNodeT, typename = void>
+struct Sparam_of
+  : ::std::enable_if<true>  // `::type` is void
+  { };
+
+template<typename TraitsT, typename XaNodeT>
+struct Sparam_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_sparam))>
+  : ::std::decay<decltype(TraitsT::make_sparam(::std::declval<bool&>(), ::std::declval<const XaNodeT&>()))>
+  { };
+
+// check for `make_symbols`
+template<typename TraitsT, typename XaNodeT, typename = void>
+struct Symbols_of
+  : ::std::enable_if<true>  // `::type` is void
+  { };
+
+template<typename TraitsT, typename XaNodeT>
+struct Symbols_of<TraitsT, XaNodeT, ROCKET_VOID_T(decltype(&TraitsT::make_symbols))>
+  : ::std::decay<decltype(TraitsT::make_symbols(::std::declval<const XaNodeT&>()))>
+  { };
+
+// executor thunk
+template<typename TraitsT, typename UparamT, typename SparamT>
+struct executor_of
+  {
+    static
+    AIR_Status
+    thunk(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const void* sp)
+      { return TraitsT::execute(ctx, static_cast<const UparamT&>(up), *(const SparamT*)sp);  }
+  };
+
+template<typename TraitsT, typename UparamT>
+struct executor_of<TraitsT, UparamT, void>
+  {
+    static
+    AIR_Status
+    thunk(Executive_Context& ctx, const AVMC_Queue::Uparam& up, const void* /*sp*/)
+      { return TraitsT::execute(ctx, static_cast<const UparamT&>(up));  }
+  };
+
+template<typename TraitsT, typename SparamT>
+struct executor_of<TraitsT, void, SparamT>
+  {
+    static
+    AIR_Status
+    thunk(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/, const void* sp)
+      { return TraitsT::execute(ctx, *(const SparamT*)sp);  }
+  };
+
+template<typename TraitsT>
+struct executor_of<TraitsT, void, void>
+  {
+    static
+    AIR_Status
+    thunk(Executive_Context& ctx, const AVMC_Queue::Uparam& /*up*/, const void* /*sp*/)
+      { return TraitsT::execute(ctx);  }
+  };
+
+// enumerator thunk
+template<typename SparamT, typename = void>
+struct enumerator_of
+  {
+    static constexpr AVMC_Queue::Enumerator* thunk = nullptr;
+  };
+
+template<typename SparamT>
+struct enumerator_of<SparamT, ROCKET_VOID_T(decltype(&SparamT::enumerate_variables))>
+  {
+    static
+    Variable_Callback&
+    thunk(Variable_Callback& callback, AVMC_Queue::Uparam /*up*/, const void* sp)
+      { return ((const SparamT*)sp)->enumerate_variables(callback);  }
+  };
+
+// Finally...
+template<typename TraitsT, typename XaNodeT, typename UparamT, typename SparamT, typename SymbolT>
+struct AVMC_Appender
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, UparamT, SparamT>::thunk,
+                              enumerator_of<SparamT>::thunk>(
+                              TraitsT::make_symbols(altr),
+                              TraitsT::make_uparam(reachable, altr),
+                              TraitsT::make_sparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename UparamT, typename SparamT>
+struct AVMC_Appender<TraitsT, XaNodeT, UparamT, SparamT, void>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, UparamT, SparamT>::thunk,
+                              enumerator_of<SparamT>::thunk>(
+                              TraitsT::make_uparam(reachable, altr),
+                              TraitsT::make_sparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename UparamT, typename SymbolT>
+struct AVMC_Appender<TraitsT, XaNodeT, UparamT, void, SymbolT>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, UparamT, void>::thunk,
+                              nullptr>(
+                              TraitsT::make_symbols(altr),
+                              TraitsT::make_uparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename UparamT>
+struct AVMC_Appender<TraitsT, XaNodeT, UparamT, void, void>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, UparamT, void>::thunk,
+                              nullptr>(
+                              TraitsT::make_uparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename SparamT, typename SymbolT>
+struct AVMC_Appender<TraitsT, XaNodeT, void, SparamT, SymbolT>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, void, SparamT>::thunk,
+                              enumerator_of<SparamT>::thunk>(
+                              TraitsT::make_symbols(altr),
+                              AVMC_Queue::Uparam(),
+                              TraitsT::make_sparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename SparamT>
+struct AVMC_Appender<TraitsT, XaNodeT, void, SparamT, void>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, void, SparamT>::thunk,
+                              enumerator_of<SparamT>::thunk>(
+                              AVMC_Queue::Uparam(),
+                              TraitsT::make_sparam(reachable, altr));
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT, typename SymbolT>
+struct AVMC_Appender<TraitsT, XaNodeT, void, void, SymbolT>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& altr)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, void, void>::thunk,
+                              nullptr>(
+                              TraitsT::make_symbols(altr),
+                              AVMC_Queue::Uparam());
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT>
+struct AVMC_Appender<TraitsT, XaNodeT, void, void, void>
+  {
+    static
+    bool
+    do_append(AVMC_Queue& queue, const XaNodeT& /*altr*/)
+      {
+        bool reachable = true;
+        queue.template append<executor_of<TraitsT, void, void>::thunk,
+                              nullptr>(
+                              AVMC_Queue::Uparam());
+        queue.shrink_to_fit();
+        return reachable;
+      }
+  };
+
+template<typename TraitsT, typename XaNodeT>
+inline
+bool
+do_solidify_explicit(AVMC_Queue& queue, const XaNodeT& altr)
+  {
+    do_get_named_executor<TraitsT, typename Uparam_of<TraitsT, XaNodeT>::type,
+                          typename Sparam_of<TraitsT, XaNodeT>::type>();
+
+    return AVMC_Appender<TraitsT, XaNodeT,
+                         typename Uparam_of<TraitsT, XaNodeT>::type,
+                         typename Sparam_of<TraitsT, XaNodeT>::type,
+                         typename Symbols_of<TraitsT, XaNodeT>::type>
+             ::do_append(queue, altr);
+  }
+
+template<typename XaNodeT>
+inline
 bool
 do_solidify(AVMC_Queue& queue, const XaNodeT& altr)
   {
@@ -4334,612 +5114,2310 @@ do_solidify(AVMC_Queue& queue, const AIR_Node::S_apply_operator& altr)
     return do_solidify_explicit<AIR_Traits_Xop<xopT>>(queue, altr);
   }
 
-}  // namespace
+bool&
+do_optimize_nodes(bool& dirty, cow_vector<AIR_Node>& code, const Compiler_Options& opts, bool scoped)
+  {
+    dirty |= AIR_Node::optimize_code(code, opts, scoped);
+    return dirty;
+  }
+
+bool&
+do_optimize_nodes(bool& dirty, cow_vector<cow_vector<AIR_Node>>& seqs, const Compiler_Options& opts, bool scoped)
+  {
+    for(size_t k = 0;  k < seqs.size();  ++k) {
+      // Don't trigger copy-on-write unless a sequence needs rewriting.
+      auto code = seqs[k];
+      if(!AIR_Node::optimize_code(code, opts, scoped))
+        continue;
+      dirty |= true;
+      seqs.mut(k) = ::std::move(code);
+    }
+    return dirty;
+  }
+
+bool
+do_refers_to_local(const cow_vector<AIR_Node>& code, const phsh_string& name)
+  {
+    return ::rocket::any_of(code, [&](const AIR_Node& node) { return node.refers_to_local(name);  });
+  }
+
+bool
+do_refers_to_local(const cow_vector<cow_vector<AIR_Node>>& seqs, const phsh_string& name)
+  {
+    return ::rocket::any_of(seqs, [&](const cow_vector<AIR_Node>& code) { return do_refers_to_local(code, name);  });
+  }
+
+uint32_t
+do_get_fold_arity(Xop xop)
+noexcept
+  {
+    switch(weaken_enum(xop)) {
+      case xop_pos:
+      case xop_neg:
+      case xop_notb:
+      case xop_notl:
+      case xop_countof:
+      case xop_typeof:
+      case xop_sqrt:
+      case xop_isnan:
+      case xop_isinf:
+      case xop_abs:
+      case xop_sign:
+      case xop_round:
+      case xop_floor:
+      case xop_ceil:
+      case xop_trunc:
+      case xop_roundi:
+      case xop_floori:
+      case xop_ceili:
+      case xop_trunci:
+        return 1;
+
+      case xop_cmp_eq:
+      case xop_cmp_ne:
+      case xop_cmp_lt:
+      case xop_cmp_gt:
+      case xop_cmp_lte:
+      case xop_cmp_gte:
+      case xop_cmp_3way:
+      case xop_add:
+      case xop_sub:
+      case xop_mul:
+      case xop_div:
+      case xop_mod:
+      case xop_sll:
+      case xop_srl:
+      case xop_sla:
+      case xop_sra:
+      case xop_andb:
+      case xop_orb:
+      case xop_xorb:
+        return 2;
+
+      default:
+        // Operators that take references can't be folded.
+        return 0;
+    }
+  }
+
+// Evaluate an operator on constant operands, storing the result into the last one.
+// If an exception is thrown, nothing is folded, so the same exception will be thrown at runtime.
+bool
+do_fold_operator(Xop xop, Value* args)
+  try {
+    switch(weaken_enum(xop)) {
+      case xop_pos:
+        return AIR_Traits_Xop<xop_pos>::operate(args[0]), true;
+
+      case xop_neg:
+        return AIR_Traits_Xop<xop_neg>::operate(args[0]), true;
+
+      case xop_notb:
+        return AIR_Traits_Xop<xop_notb>::operate(args[0]), true;
+
+      case xop_notl:
+        return AIR_Traits_Xop<xop_notl>::operate(args[0]), true;
+
+      case xop_countof:
+        return AIR_Traits_Xop<xop_countof>::operate(args[0]), true;
+
+      case xop_typeof:
+        return AIR_Traits_Xop<xop_typeof>::operate(args[0]), true;
+
+      case xop_sqrt:
+        return AIR_Traits_Xop<xop_sqrt>::operate(args[0]), true;
+
+      case xop_isnan:
+        return AIR_Traits_Xop<xop_isnan>::operate(args[0]), true;
+
+      case xop_isinf:
+        return AIR_Traits_Xop<xop_isinf>::operate(args[0]), true;
+
+      case xop_abs:
+        return AIR_Traits_Xop<xop_abs>::operate(args[0]), true;
+
+      case xop_sign:
+        return AIR_Traits_Xop<xop_sign>::operate(args[0]), true;
+
+      case xop_round:
+        return AIR_Traits_Xop<xop_round>::operate(args[0]), true;
+
+      case xop_floor:
+        return AIR_Traits_Xop<xop_floor>::operate(args[0]), true;
+
+      case xop_ceil:
+        return AIR_Traits_Xop<xop_ceil>::operate(args[0]), true;
+
+      case xop_trunc:
+        return AIR_Traits_Xop<xop_trunc>::operate(args[0]), true;
+
+      case xop_roundi:
+        return AIR_Traits_Xop<xop_roundi>::operate(args[0]), true;
+
+      case xop_floori:
+        return AIR_Traits_Xop<xop_floori>::operate(args[0]), true;
+
+      case xop_ceili:
+        return AIR_Traits_Xop<xop_ceili>::operate(args[0]), true;
+
+      case xop_trunci:
+        return AIR_Traits_Xop<xop_trunci>::operate(args[0]), true;
+
+      case xop_cmp_eq:
+        return AIR_Traits_Xop<xop_cmp_eq>::operate(args[0], args[1]), true;
+
+      case xop_cmp_ne:
+        return AIR_Traits_Xop<xop_cmp_ne>::operate(args[0], args[1]), true;
+
+      case xop_cmp_lt:
+        return AIR_Traits_Xop<xop_cmp_lt>::operate(args[0], args[1]), true;
+
+      case xop_cmp_gt:
+        return AIR_Traits_Xop<xop_cmp_gt>::operate(args[0], args[1]), true;
+
+      case xop_cmp_lte:
+        return AIR_Traits_Xop<xop_cmp_lte>::operate(args[0], args[1]), true;
+
+      case xop_cmp_gte:
+        return AIR_Traits_Xop<xop_cmp_gte>::operate(args[0], args[1]), true;
+
+      case xop_cmp_3way:
+        return AIR_Traits_Xop<xop_cmp_3way>::operate(args[0], args[1]), true;
+
+      case xop_add:
+        return AIR_Traits_Xop<xop_add>::operate(args[0], args[1]), true;
+
+      case xop_sub:
+        return AIR_Traits_Xop<xop_sub>::operate(args[0], args[1]), true;
+
+      case xop_mul:
+        return AIR_Traits_Xop<xop_mul>::operate(args[0], args[1]), true;
+
+      case xop_div:
+        return AIR_Traits_Xop<xop_div>::operate(args[0], args[1]), true;
+
+      case xop_mod:
+        return AIR_Traits_Xop<xop_mod>::operate(args[0], args[1]), true;
+
+      case xop_sll:
+        return AIR_Traits_Xop<xop_sll>::operate(args[0], args[1]), true;
+
+      case xop_srl:
+        return AIR_Traits_Xop<xop_srl>::operate(args[0], args[1]), true;
+
+      case xop_sla:
+        return AIR_Traits_Xop<xop_sla>::operate(args[0], args[1]), true;
+
+      case xop_sra:
+        return AIR_Traits_Xop<xop_sra>::operate(args[0], args[1]), true;
+
+      case xop_andb:
+        return AIR_Traits_Xop<xop_andb>::operate(args[0], args[1]), true;
+
+      case xop_orb:
+        return AIR_Traits_Xop<xop_orb>::operate(args[0], args[1]), true;
+
+      case xop_xorb:
+        return AIR_Traits_Xop<xop_xorb>::operate(args[0], args[1]), true;
+
+      default:
+        return false;
+    }
+  }
+  catch(exception& /*stdex*/) {
+    return false;
+  }
+
+AIR_Node
+do_make_constant(Value&& value)
+  {
+    switch(weaken_enum(value.vtype())) {
+      case vtype_null: {
+        AIR_Node::S_immediate_null xnode = { };
+        return ::std::move(xnode);
+      }
+
+      case vtype_boolean: {
+        AIR_Node::S_immediate_boolean xnode = { value.as_boolean() };
+        return ::std::move(xnode);
+      }
+
+      case vtype_integer: {
+        // Values that fit in 48-bit range may be optimized a bit further.
+        int64_t ival = value.as_integer();
+        if((-0x8000'0000'0000 <= ival) && (ival <= +0x7FFF'FFFF'FFFF)) {
+          AIR_Node::S_immediate_int_x48 xnode = { uint32_t(ival), int16_t(ival >> 32) };
+          return ::std::move(xnode);
+        }
+        AIR_Node::S_immediate_integer xnode = { ival };
+        return ::std::move(xnode);
+      }
+
+      case vtype_real: {
+        AIR_Node::S_immediate_real xnode = { value.as_real() };
+        return ::std::move(xnode);
+      }
+
+      case vtype_string: {
+        AIR_Node::S_immediate_string xnode = { ::std::move(value.open_string()) };
+        return ::std::move(xnode);
+      }
+
+      default: {
+        AIR_Node::S_push_immediate xnode = { ::std::move(value) };
+        return ::std::move(xnode);
+      }
+    }
+  }
+
+// Solidify a fused node with a binary operator.
+// The caller shall ensure `xop` is a binary operator that takes values.
+template<template<Xop> class TraitsT, typename XaNodeT>
+bool
+do_solidify_binary(AVMC_Queue& queue, Xop xop, const XaNodeT& altr)
+  {
+    switch(weaken_enum(xop)) {
+      case xop_cmp_eq:
+        return do_solidify_explicit<TraitsT<xop_cmp_eq>>(queue, altr);
+
+      case xop_cmp_ne:
+        return do_solidify_explicit<TraitsT<xop_cmp_ne>>(queue, altr);
+
+      case xop_cmp_lt:
+        return do_solidify_explicit<TraitsT<xop_cmp_lt>>(queue, altr);
+
+      case xop_cmp_gt:
+        return do_solidify_explicit<TraitsT<xop_cmp_gt>>(queue, altr);
+
+      case xop_cmp_lte:
+        return do_solidify_explicit<TraitsT<xop_cmp_lte>>(queue, altr);
+
+      case xop_cmp_gte:
+        return do_solidify_explicit<TraitsT<xop_cmp_gte>>(queue, altr);
+
+      case xop_cmp_3way:
+        return do_solidify_explicit<TraitsT<xop_cmp_3way>>(queue, altr);
+
+      case xop_add:
+        return do_solidify_explicit<TraitsT<xop_add>>(queue, altr);
+
+      case xop_sub:
+        return do_solidify_explicit<TraitsT<xop_sub>>(queue, altr);
+
+      case xop_mul:
+        return do_solidify_explicit<TraitsT<xop_mul>>(queue, altr);
+
+      case xop_div:
+        return do_solidify_explicit<TraitsT<xop_div>>(queue, altr);
+
+      case xop_mod:
+        return do_solidify_explicit<TraitsT<xop_mod>>(queue, altr);
+
+      case xop_sll:
+        return do_solidify_explicit<TraitsT<xop_sll>>(queue, altr);
+
+      case xop_srl:
+        return do_solidify_explicit<TraitsT<xop_srl>>(queue, altr);
+
+      case xop_sla:
+        return do_solidify_explicit<TraitsT<xop_sla>>(queue, altr);
+
+      case xop_sra:
+        return do_solidify_explicit<TraitsT<xop_sra>>(queue, altr);
+
+      case xop_andb:
+        return do_solidify_explicit<TraitsT<xop_andb>>(queue, altr);
+
+      case xop_orb:
+        return do_solidify_explicit<TraitsT<xop_orb>>(queue, altr);
+
+      case xop_xorb:
+        return do_solidify_explicit<TraitsT<xop_xorb>>(queue, altr);
+
+      default:
+        ASTERIA_TERMINATE("invalid binary operator type (xop `$1`)", xop);
+    }
+  }
+
+bool
+do_is_comparison(Xop xop)
+noexcept
+  {
+    return ::rocket::is_any_of(xop, { xop_cmp_eq, xop_cmp_ne, xop_cmp_lt, xop_cmp_gt,
+                                      xop_cmp_lte, xop_cmp_gte });
+  }
+
+// Solidify a fused node with a comparison operator.
+// The caller shall ensure `xop` is a comparison operator.
+template<template<Xop> class TraitsT, typename XaNodeT>
+bool
+do_solidify_comparison(AVMC_Queue& queue, Xop xop, const XaNodeT& altr)
+  {
+    switch(weaken_enum(xop)) {
+      case xop_cmp_eq:
+        return do_solidify_explicit<TraitsT<xop_cmp_eq>>(queue, altr);
+
+      case xop_cmp_ne:
+        return do_solidify_explicit<TraitsT<xop_cmp_ne>>(queue, altr);
+
+      case xop_cmp_lt:
+        return do_solidify_explicit<TraitsT<xop_cmp_lt>>(queue, altr);
+
+      case xop_cmp_gt:
+        return do_solidify_explicit<TraitsT<xop_cmp_gt>>(queue, altr);
+
+      case xop_cmp_lte:
+        return do_solidify_explicit<TraitsT<xop_cmp_lte>>(queue, altr);
+
+      case xop_cmp_gte:
+        return do_solidify_explicit<TraitsT<xop_cmp_gte>>(queue, altr);
+
+      default:
+        ASTERIA_TERMINATE("invalid comparison operator type (xop `$1`)", xop);
+    }
+  }
+
+}  // namespace
+
+opt<AIR_Node>
+AIR_Node::
+rebind_opt(const Abstract_Context& ctx, cow_vector<S_push_local_reference>* captures_opt)
+const
+  {
+    switch(this->index()) {
+      case index_clear_stack:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+
+        // Rebind the body.
+        Analytic_Context ctx_body(::rocket::ref(ctx));
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx_body, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_declare_variable:
+      case index_initialize_variable:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<index_if_statement>();
+
+        // Rebind both branches. Branches that have their own scopes are blocks.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_true, ctx, captures_opt);
+        do_rebind_nodes(dirty, bound.code_false, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<index_switch_statement>();
+
+        // Rebind all clauses.
+        Analytic_Context ctx_body(::rocket::ref(ctx));
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_labels, ctx, captures_opt);  // this is not part of the body!
+        do_rebind_nodes(dirty, bound.code_bodies, ctx_body, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<index_do_while_statement>();
+
+        // Rebind the body and the condition.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx, captures_opt);
+        do_rebind_nodes(dirty, bound.code_cond, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<index_while_statement>();
+
+        // Rebind the condition and the body.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_cond, ctx, captures_opt);
+        do_rebind_nodes(dirty, bound.code_body, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<index_for_each_statement>();
+
+        // Rebind the range initializer and the body.
+        Analytic_Context ctx_for(::rocket::ref(ctx));
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_init, ctx_for, captures_opt);
+        do_rebind_nodes(dirty, bound.code_body, ctx_for, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<index_for_statement>();
+
+        // Rebind the initializer, the condition, the loop increment and the body.
+        Analytic_Context ctx_for(::rocket::ref(ctx));
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_init, ctx_for, captures_opt);
+        do_rebind_nodes(dirty, bound.code_cond, ctx_for, captures_opt);
+        do_rebind_nodes(dirty, bound.code_step, ctx_for, captures_opt);
+        do_rebind_nodes(dirty, bound.code_body, ctx_for, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<index_try_statement>();
+
+        // Rebind the `try` and `catch` clauses.
+        // Only the `catch` clause has a scope of its own.
+        Analytic_Context ctx_catch(::rocket::ref(ctx));
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_try, ctx, captures_opt);
+        do_rebind_nodes(dirty, bound.code_catch, ctx_catch, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_throw_statement:
+      case index_assert_statement:
+      case index_return_statement:
+      case index_glvalue_to_prvalue:
+      case index_push_immediate:
+      case index_push_global_reference:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<index_push_local_reference>();
+
+        // Get the context.
+        // Don't bind references in analytic contexts.
+        const Abstract_Context* qctx = &ctx;
+        uint32_t depth = altr.depth;
+        while(qctx->is_analytic()) {
+          if(depth == 0)
+            return nullopt;
+
+          auto qnext = qctx->get_parent_opt();
+          if(!qnext) {
+            // The reference goes beyond the outermost context, so capture it.
+            if(!captures_opt)
+              return nullopt;
+
+            S_push_captured_reference xnode = { do_add_capture(*captures_opt, depth, altr.slot, altr.name),
+                                                altr.name };
+            return ::std::move(xnode);
+          }
+          qctx = qnext;
+          depth--;
+        }
+
+        // Look for the name in the context, or in its enclosing closure.
+        auto qref = do_find_reference_opt(static_cast<const Executive_Context&>(*qctx), depth,
+                                          altr.slot, altr.name);
+        if(!qref)
+          return nullopt;
+
+        // Bind it now.
+        S_push_bound_reference xnode = { *qref };
+        return ::std::move(xnode);
+      }
+
+      case index_push_bound_reference:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<index_define_function>();
+
+        // Rebind the function body.
+        Analytic_Context ctx_func(&ctx, altr.params);
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx_func, captures_opt);
+
+        // When capturing, references in nested functions are only collected. They will be
+        // rewritten when the nested functions are solidified.
+        if(captures_opt)
+          return nullopt;
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+
+        // Rebind the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_true, ctx, captures_opt);
+        do_rebind_nodes(dirty, bound.code_false, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+
+        // Rebind the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_null, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_function_call:
+      case index_member_access:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_variadic_call:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<index_defer_expression>();
+
+        // Rebind the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx, captures_opt);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_import_call:
+      case index_immediate_null:
+      case index_immediate_boolean:
+      case index_immediate_int_x48:
+      case index_immediate_integer:
+      case index_immediate_real:
+      case index_immediate_string:
+      case index_break_or_continue:
+        // There is nothing to rebind.
+        return nullopt;
+
+      case index_push_captured_reference: {
+        const auto& altr = this->m_stor.as<index_push_captured_reference>();
+
+        // Captured references can only be bound in the closure that holds them.
+        if(captures_opt || ctx.is_analytic())
+          return nullopt;
+
+        auto qclosure = static_cast<const Executive_Context&>(ctx).get_closure_opt();
+        if(!qclosure)
+          return nullopt;
+
+        // Bind it now.
+        S_push_bound_reference xnode = { qclosure->get_capture(altr.index) };
+        return ::std::move(xnode);
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+opt<AIR_Node>
+AIR_Node::
+optimize_opt(const Compiler_Options& opts)
+const
+  {
+    switch(this->index()) {
+      case index_clear_stack:
+        // There is nothing to optimize.
+        return nullopt;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+
+        // Optimize the body.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_body, opts, true);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_declare_variable:
+      case index_initialize_variable:
+        // There is nothing to optimize.
+        return nullopt;
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<index_if_statement>();
+
+        // Optimize both branches.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_true, opts, false);
+        do_optimize_nodes(dirty, bound.code_false, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<index_switch_statement>();
+
+        // Optimize all clauses.
+        // Clauses share the same scope, so names declared in one clause may be referenced
+        // in another.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_labels, opts, false);
+        do_optimize_nodes(dirty, bound.code_bodies, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<index_do_while_statement>();
+
+        // Optimize the body and the condition.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_body, opts, false);
+        do_optimize_nodes(dirty, bound.code_cond, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<index_while_statement>();
+
+        // Optimize the condition and the body.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_cond, opts, false);
+        do_optimize_nodes(dirty, bound.code_body, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<index_for_each_statement>();
+
+        // Optimize the range initializer and the body.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_init, opts, false);
+        do_optimize_nodes(dirty, bound.code_body, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<index_for_statement>();
+
+        // Optimize the initializer, the condition, the loop increment and the body.
+        // Names declared in the initializer are referenced by the others.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_init, opts, false);
+        do_optimize_nodes(dirty, bound.code_cond, opts, false);
+        do_optimize_nodes(dirty, bound.code_step, opts, false);
+        do_optimize_nodes(dirty, bound.code_body, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<index_try_statement>();
+
+        // Optimize the `try` and `catch` clauses.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_try, opts, false);
+        do_optimize_nodes(dirty, bound.code_catch, opts, true);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_throw_statement:
+      case index_assert_statement:
+      case index_return_statement:
+      case index_glvalue_to_prvalue:
+      case index_push_immediate:
+      case index_push_global_reference:
+      case index_push_local_reference:
+      case index_push_bound_reference:
+        // There is nothing to optimize.
+        return nullopt;
+
+      case index_define_function:
+        // The function body has been optimized when it was generated.
+        return nullopt;
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+
+        // Optimize the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_true, opts, false);
+        do_optimize_nodes(dirty, bound.code_false, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+
+        // Optimize the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_null, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_function_call:
+      case index_member_access:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_variadic_call:
+        // There is nothing to optimize.
+        return nullopt;
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<index_defer_expression>();
+
+        // Optimize the expression.
+        bool dirty = false;
+        auto bound = altr;
+
+        do_optimize_nodes(dirty, bound.code_body, opts, false);
+
+        return do_forward_if_opt(dirty, ::std::move(bound));
+      }
+
+      case index_import_call:
+      case index_immediate_null:
+      case index_immediate_boolean:
+      case index_immediate_int_x48:
+      case index_immediate_integer:
+      case index_immediate_real:
+      case index_immediate_string:
+      case index_break_or_continue:
+      case index_push_captured_reference:
+        // There is nothing to optimize.
+        return nullopt;
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+bool
+AIR_Node::
+refers_to_local(const phsh_string& name)
+const
+  {
+    switch(this->index()) {
+      case index_clear_stack:
+      case index_declare_variable:
+      case index_initialize_variable:
+        return false;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+        return do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<index_if_statement>();
+        return do_refers_to_local(altr.code_true, name) ||
+               do_refers_to_local(altr.code_false, name);
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<index_switch_statement>();
+        return do_refers_to_local(altr.code_labels, name) ||
+               do_refers_to_local(altr.code_bodies, name);
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<index_do_while_statement>();
+        return do_refers_to_local(altr.code_body, name) ||
+               do_refers_to_local(altr.code_cond, name);
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<index_while_statement>();
+        return do_refers_to_local(altr.code_cond, name) ||
+               do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<index_for_each_statement>();
+        return do_refers_to_local(altr.code_init, name) ||
+               do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<index_for_statement>();
+        return do_refers_to_local(altr.code_init, name) ||
+               do_refers_to_local(altr.code_cond, name) ||
+               do_refers_to_local(altr.code_step, name) ||
+               do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<index_try_statement>();
+        return do_refers_to_local(altr.code_try, name) ||
+               do_refers_to_local(altr.code_catch, name);
+      }
+
+      case index_throw_statement:
+      case index_assert_statement:
+      case index_return_statement:
+      case index_glvalue_to_prvalue:
+      case index_push_immediate:
+      case index_push_global_reference:
+        return false;
+
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<index_push_local_reference>();
+        return altr.name == name;
+      }
+
+      case index_push_bound_reference:
+        return false;
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<index_define_function>();
+        return do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+        return do_refers_to_local(altr.code_true, name) ||
+               do_refers_to_local(altr.code_false, name);
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+        return do_refers_to_local(altr.code_null, name);
+      }
+
+      case index_function_call:
+      case index_member_access:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_variadic_call:
+        return false;
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<index_defer_expression>();
+        return do_refers_to_local(altr.code_body, name);
+      }
+
+      case index_import_call:
+      case index_immediate_null:
+      case index_immediate_boolean:
+      case index_immediate_int_x48:
+      case index_immediate_integer:
+      case index_immediate_real:
+      case index_immediate_string:
+      case index_break_or_continue:
+        return false;
+
+      case index_push_captured_reference: {
+        const auto& altr = this->m_stor.as<index_push_captured_reference>();
+        return altr.name == name;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+const cow_vector<AIR_Node>*
+AIR_Node::
+get_block_body_opt()
+const noexcept
+  {
+    if(this->index() != index_execute_block)
+      return nullptr;
+
+    return ::std::addressof(this->m_stor.as<index_execute_block>().code_body);
+  }
+
+opt<Value>
+AIR_Node::
+get_constant_opt()
+const
+  {
+    switch(weaken_enum(this->index())) {
+      case index_push_immediate:
+        return this->m_stor.as<index_push_immediate>().value;
+
+      case index_immediate_null:
+        return Value(nullptr);
+
+      case index_immediate_boolean:
+        return Value(this->m_stor.as<index_immediate_boolean>().value);
+
+      case index_immediate_int_x48: {
+        const auto& altr = this->m_stor.as<index_immediate_int_x48>();
+        return Value(V_integer(static_cast<int64_t>(altr.high) * 0x1'0000'0000 + altr.low));
+      }
+
+      case index_immediate_integer:
+        return Value(this->m_stor.as<index_immediate_integer>().value);
+
+      case index_immediate_real:
+        return Value(this->m_stor.as<index_immediate_real>().value);
+
+      case index_immediate_string:
+        return Value(this->m_stor.as<index_immediate_string>().value);
+
+      default:
+        return nullopt;
+    }
+  }
+
+bool
+AIR_Node::
+optimize_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts, bool scoped)
+  {
+    if(opts.optimization_level <= 0)
+      return false;
+
+    // Optimize nested code recursively.
+    bool dirty = false;
+    for(size_t i = 0;  i < code.size();  ++i) {
+      auto qnode = code[i].optimize_opt(opts);
+      if(!qnode)
+        continue;
+      dirty |= true;
+      code.mut(i) = ::std::move(*qnode);
+    }
+
+    // Fold constant expressions and prune constant branches.
+    // This is repeated until no more nodes can be folded, as expanded branches may be
+    // folded further.
+    for(;;) {
+      bool folded = false;
+      cow_vector<AIR_Node> temp;
+      cow_vector<Value> args;
+
+      for(size_t i = 0;  i < code.size();  ++i) {
+        const auto& node = code[i];
+        switch(weaken_enum(node.index())) {
+          case index_apply_operator: {
+            const auto& altr = node.m_stor.as<index_apply_operator>();
+            if(altr.assign)
+              break;
+
+            // Check whether all operands are constants.
+            size_t nargs = do_get_fold_arity(altr.xop);
+            if((nargs == 0) || (temp.size() < nargs))
+              break;
+
+            args.clear();
+            for(size_t k = temp.size() - nargs;  k < temp.size();  ++k)
+              if(auto qvalue = temp[k].get_constant_opt())
+                args.emplace_back(::std::move(*qvalue));
+
+            if(args.size() != nargs)
+              break;
+
+            // Evaluate the operator now.
+            if(!do_fold_operator(altr.xop, args.mut_data()))
+              break;
+
+            // Replace the operands and the operator with the result.
+            temp.pop_back(nargs);
+            temp.emplace_back(do_make_constant(::std::move(args.mut_back())));
+            folded |= true;
+            continue;
+          }
+
+          case index_if_statement: {
+            const auto& altr = node.m_stor.as<index_if_statement>();
+            auto qcond = temp.empty() ? nullopt : temp.back().get_constant_opt();
+            if(!qcond)
+              break;
+
+            // Select a branch now. The condition is left on the stack, as it would be.
+            // Branches that need a scope have been wrapped in blocks by the compiler.
+            const auto& code_taken = (qcond->test() != altr.negative) ? altr.code_true : altr.code_false;
+            temp.append(code_taken.begin(), code_taken.end());
+            folded |= true;
+            continue;
+          }
+
+          case index_branch_expression: {
+            const auto& altr = node.m_stor.as<index_branch_expression>();
+            auto qcond = (altr.assign || temp.empty()) ? nullopt : temp.back().get_constant_opt();
+            if(!qcond)
+              break;
+
+            // Select a branch now. If it is empty, the condition is the result.
+            // Otherwise, the condition is replaced with the result of the branch.
+            const auto& code_taken = qcond->test() ? altr.code_true : altr.code_false;
+            if(!code_taken.empty()) {
+              temp.pop_back();
+              temp.append(code_taken.begin(), code_taken.end());
+            }
+            folded |= true;
+            continue;
+          }
+
+          default:
+            break;
+        }
+        temp.emplace_back(node);
+      }
+
+      if(!folded)
+        break;
+
+      dirty |= true;
+      code = ::std::move(temp);
+    }
+
+    // Drop nodes following one that terminates control flow.
+    for(size_t i = 0;  i < code.size();  ++i) {
+      auto index = code[i].index();
+      if(::rocket::is_none_of(index, { index_return_statement, index_throw_statement,
+                                       index_break_or_continue }))
+        continue;
+
+      if(i + 1 == code.size())
+        break;
+
+      dirty |= true;
+      code.erase(i + 1);
+      break;
+    }
+
+    // Remove declarations of null variables that are never referenced.
+    // If `code` doesn't constitute a whole scope, names may be referenced by code outside it.
+    if(scoped && (opts.optimization_level >= 2)) {
+      for(size_t i = code.size() - 1;  i != SIZE_MAX;  --i) {
+        if(code[i].index() != index_define_null_variable)
+          continue;
+
+        const auto& name = code[i].m_stor.as<index_define_null_variable>().name;
+        if(name.empty())
+          continue;
+
+        if(::std::any_of(code.begin() + static_cast<ptrdiff_t>(i + 1), code.end(),
+                         [&](const AIR_Node& node) { return node.refers_to_local(name);  }))
+          continue;
+
+        dirty |= true;
+        // Slots were assigned when code was generated. If another variable is declared
+        // in this scope later, its slot would be shifted at runtime, so the declaration
+        // is replaced with one that has no name, which only reserves the slot.
+        if(::std::any_of(code.begin() + static_cast<ptrdiff_t>(i + 1), code.end(),
+                         [&](const AIR_Node& node) {
+                           return ::rocket::is_any_of(node.index(), { index_declare_variable,
+                                                                      index_define_null_variable });
+                         }))
+          code.mut(i).m_stor.as<index_define_null_variable>().name.clear();
+        else
+          code.erase(i, 1);
+      }
+    }
+    return dirty;
+  }
+
+bool
+AIR_Node::
+solidify(AVMC_Queue& queue)
+const
+  {
+    switch(this->index()) {
+      case index_clear_stack: {
+        const auto& altr = this->m_stor.as<index_clear_stack>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<index_execute_block>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_declare_variable: {
+        const auto& altr = this->m_stor.as<index_declare_variable>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_initialize_variable: {
+        const auto& altr = this->m_stor.as<index_initialize_variable>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<index_if_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<index_switch_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<index_do_while_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<index_while_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<index_for_each_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<index_for_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<index_try_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_throw_statement: {
+        const auto& altr = this->m_stor.as<index_throw_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_assert_statement: {
+        const auto& altr = this->m_stor.as<index_assert_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_return_statement: {
+        const auto& altr = this->m_stor.as<index_return_statement>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_glvalue_to_prvalue: {
+        const auto& altr = this->m_stor.as<index_glvalue_to_prvalue>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_immediate: {
+        const auto& altr = this->m_stor.as<index_push_immediate>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_global_reference: {
+        const auto& altr = this->m_stor.as<index_push_global_reference>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<index_push_local_reference>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_bound_reference: {
+        const auto& altr = this->m_stor.as<index_push_bound_reference>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<index_define_function>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<index_function_call>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_member_access: {
+        const auto& altr = this->m_stor.as<index_member_access>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_unnamed_array: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_array>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_unnamed_object: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_object>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<index_apply_operator>();
+
+        switch(altr.xop) {
+          case xop_inc_post:
+            return do_solidify<xop_inc_post>(queue, altr);
+
+          case xop_dec_post:
+            return do_solidify<xop_dec_post>(queue, altr);
+
+          case xop_subscr:
+            return do_solidify<xop_subscr>(queue, altr);
+
+          case xop_pos:
+            return do_solidify<xop_pos>(queue, altr);
+
+          case xop_neg:
+            return do_solidify<xop_neg>(queue, altr);
+
+          case xop_notb:
+            return do_solidify<xop_notb>(queue, altr);
+
+          case xop_notl:
+            return do_solidify<xop_notl>(queue, altr);
+
+          case xop_inc_pre:
+            return do_solidify<xop_inc_pre>(queue, altr);
+
+          case xop_dec_pre:
+            return do_solidify<xop_dec_pre>(queue, altr);
+
+          case xop_unset:
+            return do_solidify<xop_unset>(queue, altr);
+
+          case xop_countof:
+            return do_solidify<xop_countof>(queue, altr);
+
+          case xop_typeof:
+            return do_solidify<xop_typeof>(queue, altr);
+
+          case xop_sqrt:
+            return do_solidify<xop_sqrt>(queue, altr);
+
+          case xop_isnan:
+            return do_solidify<xop_isnan>(queue, altr);
+
+          case xop_isinf:
+            return do_solidify<xop_isinf>(queue, altr);
+
+          case xop_abs:
+            return do_solidify<xop_abs>(queue, altr);
+
+          case xop_sign:
+            return do_solidify<xop_sign>(queue, altr);
+
+          case xop_round:
+            return do_solidify<xop_round>(queue, altr);
+
+          case xop_floor:
+            return do_solidify<xop_floor>(queue, altr);
+
+          case xop_ceil:
+            return do_solidify<xop_ceil>(queue, altr);
+
+          case xop_trunc:
+            return do_solidify<xop_trunc>(queue, altr);
+
+          case xop_roundi:
+            return do_solidify<xop_roundi>(queue, altr);
+
+          case xop_floori:
+            return do_solidify<xop_floori>(queue, altr);
+
+          case xop_ceili:
+            return do_solidify<xop_ceili>(queue, altr);
+
+          case xop_trunci:
+            return do_solidify<xop_trunci>(queue, altr);
+
+          case xop_cmp_eq:
+            return do_solidify<xop_cmp_eq>(queue, altr);
+
+          case xop_cmp_ne:
+            return do_solidify<xop_cmp_ne>(queue, altr);
+
+          case xop_cmp_lt:
+            return do_solidify<xop_cmp_lt>(queue, altr);
+
+          case xop_cmp_gt:
+            return do_solidify<xop_cmp_gt>(queue, altr);
+
+          case xop_cmp_lte:
+            return do_solidify<xop_cmp_lte>(queue, altr);
+
+          case xop_cmp_gte:
+            return do_solidify<xop_cmp_gte>(queue, altr);
+
+          case xop_cmp_3way:
+            return do_solidify<xop_cmp_3way>(queue, altr);
+
+          case xop_add:
+            return do_solidify<xop_add>(queue, altr);
+
+          case xop_sub:
+            return do_solidify<xop_sub>(queue, altr);
+
+          case xop_mul:
+            return do_solidify<xop_mul>(queue, altr);
+
+          case xop_div:
+            return do_solidify<xop_div>(queue, altr);
+
+          case xop_mod:
+            return do_solidify<xop_mod>(queue, altr);
+
+          case xop_sll:
+            return do_solidify<xop_sll>(queue, altr);
+
+          case xop_srl:
+            return do_solidify<xop_srl>(queue, altr);
+
+          case xop_sla:
+            return do_solidify<xop_sla>(queue, altr);
+
+          case xop_sra:
+            return do_solidify<xop_sra>(queue, altr);
+
+          case xop_andb:
+            return do_solidify<xop_andb>(queue, altr);
+
+          case xop_orb:
+            return do_solidify<xop_orb>(queue, altr);
+
+          case xop_xorb:
+            return do_solidify<xop_xorb>(queue, altr);
+
+          case xop_assign:
+            return do_solidify<xop_assign>(queue, altr);
+
+          case xop_fma:
+            return do_solidify<xop_fma>(queue, altr);
+
+          case xop_head:
+            return do_solidify<xop_head>(queue, altr);
+
+          case xop_tail:
+            return do_solidify<xop_tail>(queue, altr);
+
+          default:
+            ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
+        }
+      }
+
+      case index_unpack_struct_array: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_array>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_unpack_struct_object: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_object>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_define_null_variable: {
+        const auto& altr = this->m_stor.as<index_define_null_variable>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_single_step_trap: {
+        const auto& altr = this->m_stor.as<index_single_step_trap>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_variadic_call: {
+        const auto& altr = this->m_stor.as<index_variadic_call>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<index_defer_expression>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<index_import_call>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_null: {
+        const auto& altr = this->m_stor.as<index_immediate_null>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_boolean: {
+        const auto& altr = this->m_stor.as<index_immediate_boolean>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_int_x48: {
+        const auto& altr = this->m_stor.as<index_immediate_int_x48>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_integer: {
+        const auto& altr = this->m_stor.as<index_immediate_integer>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_real: {
+        const auto& altr = this->m_stor.as<index_immediate_real>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_immediate_string: {
+        const auto& altr = this->m_stor.as<index_immediate_string>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_break_or_continue: {
+        const auto& altr = this->m_stor.as<index_break_or_continue>();
+        return do_solidify(queue, altr);
+      }
+
+      case index_push_captured_reference: {
+        const auto& altr = this->m_stor.as<index_push_captured_reference>();
+        return do_solidify(queue, altr);
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+    }
+  }
+
+bool
+AIR_Node::
+solidify_code(AVMC_Queue& queue, const cow_vector<AIR_Node>& code)
+  {
+    // Get the binary operator node at `k`, if any.
+    auto get_binary_opt = [&](size_t k) -> const S_apply_operator*
+      {
+        if((k >= code.size()) || (code[k].index() != index_apply_operator))
+          return nullptr;
+
+        const auto& altr = code[k].m_stor.as<index_apply_operator>();
+        if(do_get_fold_arity(altr.xop) != 2)
+          return nullptr;
+        return &altr;
+      };
+
+    // Get the `if` statement node at `k`, if any.
+    auto get_if_opt = [&](size_t k) -> const S_if_statement*
+      {
+        if((k >= code.size()) || (code[k].index() != index_if_statement))
+          return nullptr;
+        return &(code[k].m_stor.as<index_if_statement>());
+      };
+
+    // Get the local reference that is pushed by `seq[k]`, if any.
+    auto get_local_opt = [&](const cow_vector<AIR_Node>& seq, size_t k) -> const S_push_local_reference*
+      {
+        if((k >= seq.size()) || (seq[k].index() != index_push_local_reference))
+          return nullptr;
+        return &(seq[k].m_stor.as<index_push_local_reference>());
+      };
+
+    // Check whether `seq[k]` is a unary operator or member access, which only modifies the top.
+    auto is_unary = [&](const cow_vector<AIR_Node>& seq, size_t k)
+      {
+        if(::rocket::is_any_of(seq[k].index(), { index_member_access, index_glvalue_to_prvalue }))
+          return true;
+        if(seq[k].index() != index_apply_operator)
+          return false;
+        const auto& altr = seq[k].m_stor.as<index_apply_operator>();
+        return !altr.assign && (do_get_fold_arity(altr.xop) == 1);
+      };
+
+    // Check whether a `for` statement can be turned into a counted loop.
+    // The condition must be `i < b` or `i <= b` where `b` is a constant or a reference,
+    // possibly with unary operators applied. The increment must be `++i` or `i++`.
+    auto get_counted_for_opt = [&](const AIR_Node& xnode) -> opt<Counted_for>
+      {
+        if(xnode.index() != index_for_statement)
+          return nullopt;
+
+        const auto& altr = xnode.m_stor.as<index_for_statement>();
+        const auto& cond = altr.code_cond;
+        const auto& step = altr.code_step;
+        auto qcref = get_local_opt(cond, 1);
+        auto qsref = get_local_opt(step, 1);
+        if(!qcref || !qsref || (qcref->depth != 0) || (qsref->depth != 0) || (qcref->name != qsref->name))
+          return nullopt;
+
+        // Check the increment.
+        if((step.size() != 3) || (step[0].index() != index_clear_stack) ||
+           (step[2].index() != index_apply_operator))
+          return nullopt;
+        const auto& sxop = step[2].m_stor.as<index_apply_operator>();
+        if(::rocket::is_none_of(sxop.xop, { xop_inc_pre, xop_inc_post }))
+          return nullopt;
+
+        // Check the condition. The comparison may be followed by a conversion to prvalue.
+        size_t ncond = cond.size();
+        if((ncond != 0) && (cond[ncond-1].index() == index_glvalue_to_prvalue))
+          ncond -= 1;
+        if((ncond < 4) || (cond[0].index() != index_clear_stack) ||
+           (cond[ncond-1].index() != index_apply_operator))
+          return nullopt;
+        const auto& cxop = cond[ncond-1].m_stor.as<index_apply_operator>();
+        if(cxop.assign || ::rocket::is_none_of(cxop.xop, { xop_cmp_lt, xop_cmp_lte }))
+          return nullopt;
+
+        // Check the bound.
+        if(!cond[2].get_constant_opt() &&
+           ::rocket::is_none_of(cond[2].index(), { index_push_local_reference, index_push_bound_reference,
+                                                   index_push_global_reference }))
+          return nullopt;
+        for(size_t k = 3;  k < ncond - 1;  ++k)
+          if(!is_unary(cond, k))
+            return nullopt;
+
+        // Check that the induction variable is declared by the initializer.
+        if(::std::none_of(altr.code_init.begin(), altr.code_init.end(),
+                          [&](const AIR_Node& init) {
+                            return (init.index() == index_declare_variable) &&
+                                   (init.m_stor.as<index_declare_variable>().name == qcref->name);
+                          }))
+          return nullopt;
+
+        Counted_for counted = { cxop.xop == xop_cmp_lte, qcref->slot, qcref->name,
+                                altr.code_init, { }, cond, step, altr.code_body };
+        counted.code_bound.emplace_back(S_clear_stack());
+        counted.code_bound.append(cond.begin() + 2, cond.begin() + static_cast<ptrdiff_t>(ncond - 1));
+        return ::std::move(counted);
+      };
+
+    size_t i = 0;
+    while(i < code.size()) {
+      const auto& node = code[i];
+      auto qvalue = node.get_constant_opt();
+      opt<Value> qnext;
+      const S_apply_operator* qxop;
+      const S_if_statement* qif;
+      bool reachable = true;
+
+      if((node.index() == index_push_local_reference) && (i + 2 < code.size()) &&
+         (qnext = code[i+1].get_constant_opt()) && (qxop = get_binary_opt(i+2))) {
+        // local reference, immediate, binary operator
+        const auto& altr = node.m_stor.as<index_push_local_reference>();
+        Fused_local_xop_immediate xnode = { qxop->sloc, qxop->assign, altr.depth, altr.slot,
+                                            altr.name, ::std::move(*qnext) };
+        reachable = do_solidify_binary<AIR_Traits_Fused_local_xop_immediate>(queue, qxop->xop, xnode);
+        i += 3;
+      }
+      else if(qvalue && (qxop = get_binary_opt(i+1)) && !qxop->assign && do_is_comparison(qxop->xop) &&
+              (qif = get_if_opt(i+2))) {
+        // immediate, comparison operator, `if` statement
+        Fused_compare_branch xnode = { qxop->sloc, qif->negative, ::std::move(*qvalue),
+                                       qif->code_true, qif->code_false };
+        reachable = do_solidify_comparison<AIR_Traits_Fused_compare_branch>(queue, qxop->xop, xnode);
+        i += 3;
+      }
+      else if((qxop = get_binary_opt(i)) && !qxop->assign && do_is_comparison(qxop->xop) &&
+              (qif = get_if_opt(i+1))) {
+        // comparison operator, `if` statement
+        Fused_compare_branch xnode = { qxop->sloc, qif->negative, nullopt,
+                                       qif->code_true, qif->code_false };
+        reachable = do_solidify_comparison<AIR_Traits_Fused_compare_branch>(queue, qxop->xop, xnode);
+        i += 2;
+      }
+      else if(qvalue && (qxop = get_binary_opt(i+1))) {
+        // immediate, binary operator
+        Fused_xop_immediate xnode = { qxop->sloc, qxop->assign, ::std::move(*qvalue) };
+        reachable = do_solidify_binary<AIR_Traits_Fused_xop_immediate>(queue, qxop->xop, xnode);
+        i += 2;
+      }
+      else if(auto qcounted = get_counted_for_opt(node)) {
+        // counted `for` statement
+        reachable = do_solidify_explicit<AIR_Traits_Counted_for>(queue, *qcounted);
+        i += 1;
+      }
+      else {
+        // This node can't be fused.
+        reachable = node.solidify(queue);
+        i += 1;
+      }
+
+      // Nodes following one that terminates control flow are not solidified.
+      if(!reachable)
+        return false;
+    }
+    return true;
+  }
 
-opt<AIR_Node>
+bool
 AIR_Node::
-rebind_opt(const Abstract_Context& ctx)
+serialize(AIR_Serializer& ser)
 const
   {
+    ser.put_byte(this->index());
     switch(this->index()) {
       case index_clear_stack:
-        // There is nothing to rebind.
-        return nullopt;
+        return true;
 
       case index_execute_block: {
         const auto& altr = this->m_stor.as<index_execute_block>();
+        return ser.put_code(altr.code_body);
+      }
 
-        // Rebind the body.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_declare_variable: {
+        const auto& altr = this->m_stor.as<index_declare_variable>();
+        ser.put_source_location(altr.sloc);
+        ser.put_name(altr.name);
+        return true;
       }
 
-      case index_declare_variable:
-      case index_initialize_variable:
-        // There is nothing to rebind.
-        return nullopt;
+      case index_initialize_variable: {
+        const auto& altr = this->m_stor.as<index_initialize_variable>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.immutable);
+        return true;
+      }
 
       case index_if_statement: {
         const auto& altr = this->m_stor.as<index_if_statement>();
-
-        // Rebind both branches.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_true, ctx_body);
-        do_rebind_nodes(dirty, bound.code_false, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        ser.put_bool(altr.negative);
+        return ser.put_code(altr.code_true) && ser.put_code(altr.code_false);
       }
 
       case index_switch_statement: {
         const auto& altr = this->m_stor.as<index_switch_statement>();
-
-        // Rebind all clauses.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_labels, ctx);  // this is not part of the body!
-        do_rebind_nodes(dirty, bound.code_bodies, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        ser.put_uint32(static_cast<uint32_t>(altr.code_labels.size()));
+        for(size_t i = 0;  i < altr.code_labels.size();  ++i) {
+          if(!ser.put_code(altr.code_labels.at(i)) || !ser.put_code(altr.code_bodies.at(i)))
+            return false;
+          ser.put_names(altr.names_added.at(i));
+        }
+        return true;
       }
 
       case index_do_while_statement: {
         const auto& altr = this->m_stor.as<index_do_while_statement>();
-
-        // Rebind the body and the condition.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-        do_rebind_nodes(dirty, bound.code_cond, ctx);  // this is not part of the body!
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        ser.put_bool(altr.negative);
+        return ser.put_code(altr.code_body) && ser.put_code(altr.code_cond);
       }
 
       case index_while_statement: {
         const auto& altr = this->m_stor.as<index_while_statement>();
-
-        // Rebind the condition and the body.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_cond, ctx);  // this is not part of the body!
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        ser.put_bool(altr.negative);
+        return ser.put_code(altr.code_cond) && ser.put_code(altr.code_body);
       }
 
       case index_for_each_statement: {
         const auto& altr = this->m_stor.as<index_for_each_statement>();
-
-        // Rebind the range initializer and the body.
-        Analytic_Context ctx_for(::rocket::ref(ctx));
-        Analytic_Context ctx_body(::rocket::ref(ctx_for));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_init, ctx_for);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        ser.put_name(altr.name_key);
+        ser.put_name(altr.name_mapped);
+        return ser.put_code(altr.code_init) && ser.put_code(altr.code_body);
       }
 
       case index_for_statement: {
         const auto& altr = this->m_stor.as<index_for_statement>();
-
-        // Rebind the initializer, the condition, the loop increment and the body.
-        Analytic_Context ctx_for(::rocket::ref(ctx));
-        Analytic_Context ctx_body(::rocket::ref(ctx_for));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_init, ctx_for);
-        do_rebind_nodes(dirty, bound.code_cond, ctx_for);
-        do_rebind_nodes(dirty, bound.code_step, ctx_for);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-
-        return do_forward_if_opt(dirty, ::std::move(bound));
+        return ser.put_code(altr.code_init) && ser.put_code(altr.code_cond) &&
+               ser.put_code(altr.code_step) && ser.put_code(altr.code_body);
       }
 
       case index_try_statement: {
         const auto& altr = this->m_stor.as<index_try_statement>();
+        ser.put_source_location(altr.sloc_try);
+        if(!ser.put_code(altr.code_try))
+          return false;
+        ser.put_source_location(altr.sloc_catch);
+        ser.put_name(altr.name_except);
+        return ser.put_code(altr.code_catch);
+      }
 
-        // Rebind the `try` and `catch` clauses.
-        Analytic_Context ctx_body(::rocket::ref(ctx));
-        bool dirty = false;
-        auto bound = altr;
-
-        do_rebind_nodes(dirty, bound.code_try, ctx_body);
-        do_rebind_nodes(dirty, bound.code_catch, ctx_body);
+      case index_throw_statement: {
+        const auto& altr = this->m_stor.as<index_throw_statement>();
+        ser.put_source_location(altr.sloc);
+        return true;
+      }
 
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_assert_statement: {
+        const auto& altr = this->m_stor.as<index_assert_statement>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.negative);
+        ser.put_string(altr.msg);
+        return true;
       }
 
-      case index_throw_statement:
-      case index_assert_statement:
-      case index_return_statement:
-      case index_glvalue_to_prvalue:
-      case index_push_immediate:
-      case index_push_global_reference:
-        // There is nothing to rebind.
-        return nullopt;
+      case index_return_statement: {
+        const auto& altr = this->m_stor.as<index_return_statement>();
+        ser.put_byte(altr.status);
+        return true;
+      }
 
-      case index_push_local_reference: {
-        const auto& altr = this->m_stor.as<index_push_local_reference>();
+      case index_glvalue_to_prvalue: {
+        const auto& altr = this->m_stor.as<index_glvalue_to_prvalue>();
+        ser.put_source_location(altr.sloc);
+        return true;
+      }
 
-        // Get the context.
-        // Don't bind references in analytic contexts.
-        const Abstract_Context* qctx = &ctx;
-        ::rocket::ranged_for(uint32_t(0), altr.depth, [&](uint32_t) { qctx = qctx->get_parent_opt();  });
-        ROCKET_ASSERT(qctx);
-        if(qctx->is_analytic())
-          return nullopt;
+      case index_push_immediate: {
+        const auto& altr = this->m_stor.as<index_push_immediate>();
+        return ser.put_value(altr.value);
+      }
 
-        // Look for the name in the context.
-        auto qref = qctx->get_named_reference_opt(altr.name);
-        if(!qref)
-          return nullopt;
+      case index_push_global_reference: {
+        const auto& altr = this->m_stor.as<index_push_global_reference>();
+        ser.put_source_location(altr.sloc);
+        ser.put_name(altr.name);
+        return true;
+      }
 
-        // Bind it now.
-        S_push_bound_reference xnode = { *qref };
-        return ::std::move(xnode);
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<index_push_local_reference>();
+        ser.put_source_location(altr.sloc);
+        ser.put_uint32(altr.depth);
+        ser.put_uint32(altr.slot);
+        ser.put_name(altr.name);
+        return true;
       }
 
       case index_push_bound_reference:
-        // There is nothing to rebind.
-        return nullopt;
+        // Bound references only exist at runtime.
+        return false;
 
       case index_define_function: {
         const auto& altr = this->m_stor.as<index_define_function>();
+        ser.put_options(altr.opts);
+        ser.put_source_location(altr.sloc);
+        ser.put_string(altr.func);
+        ser.put_names(altr.params);
+        return ser.put_code(altr.code_body);
+      }
 
-        // Rebind the function body.
-        Analytic_Context ctx_func(&ctx, altr.params);
-        bool dirty = false;
-        auto bound = altr;
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<index_branch_expression>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.assign);
+        return ser.put_code(altr.code_true) && ser.put_code(altr.code_false);
+      }
 
-        do_rebind_nodes(dirty, bound.code_body, ctx_func);
+      case index_coalescence: {
+        const auto& altr = this->m_stor.as<index_coalescence>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.assign);
+        return ser.put_code(altr.code_null);
+      }
 
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<index_function_call>();
+        ser.put_source_location(altr.sloc);
+        ser.put_uint32(altr.nargs);
+        ser.put_byte(altr.ptc);
+        return true;
       }
 
-      case index_branch_expression: {
-        const auto& altr = this->m_stor.as<index_branch_expression>();
+      case index_member_access: {
+        const auto& altr = this->m_stor.as<index_member_access>();
+        ser.put_source_location(altr.sloc);
+        ser.put_name(altr.name);
+        return true;
+      }
 
-        // Rebind the expression.
-        bool dirty = false;
-        auto bound = altr;
+      case index_push_unnamed_array: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_array>();
+        ser.put_source_location(altr.sloc);
+        ser.put_uint32(altr.nelems);
+        return true;
+      }
 
-        do_rebind_nodes(dirty, bound.code_true, ctx);
-        do_rebind_nodes(dirty, bound.code_false, ctx);
+      case index_push_unnamed_object: {
+        const auto& altr = this->m_stor.as<index_push_unnamed_object>();
+        ser.put_source_location(altr.sloc);
+        ser.put_names(altr.keys);
+        return true;
+      }
 
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<index_apply_operator>();
+        ser.put_source_location(altr.sloc);
+        ser.put_byte(altr.xop);
+        ser.put_bool(altr.assign);
+        return true;
       }
 
-      case index_coalescence: {
-        const auto& altr = this->m_stor.as<index_coalescence>();
+      case index_unpack_struct_array: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_array>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.immutable);
+        ser.put_uint32(altr.nelems);
+        return true;
+      }
 
-        // Rebind the expression.
-        bool dirty = false;
-        auto bound = altr;
+      case index_unpack_struct_object: {
+        const auto& altr = this->m_stor.as<index_unpack_struct_object>();
+        ser.put_source_location(altr.sloc);
+        ser.put_bool(altr.immutable);
+        ser.put_names(altr.keys);
+        return true;
+      }
 
-        do_rebind_nodes(dirty, bound.code_null, ctx);
+      case index_define_null_variable: {
+        const auto& altr = this->m_stor.as<index_define_null_variable>();
+        ser.put_bool(altr.immutable);
+        ser.put_source_location(altr.sloc);
+        ser.put_name(altr.name);
+        return true;
+      }
 
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_single_step_trap: {
+        const auto& altr = this->m_stor.as<index_single_step_trap>();
+        ser.put_source_location(altr.sloc);
+        return true;
       }
 
-      case index_function_call:
-      case index_member_access:
-      case index_push_unnamed_array:
-      case index_push_unnamed_object:
-      case index_apply_operator:
-      case index_unpack_struct_array:
-      case index_unpack_struct_object:
-      case index_define_null_variable:
-      case index_single_step_trap:
-      case index_variadic_call:
-        // There is nothing to rebind.
-        return nullopt;
+      case index_variadic_call: {
+        const auto& altr = this->m_stor.as<index_variadic_call>();
+        ser.put_source_location(altr.sloc);
+        ser.put_byte(altr.ptc);
+        return true;
+      }
 
       case index_defer_expression: {
         const auto& altr = this->m_stor.as<index_defer_expression>();
+        ser.put_source_location(altr.sloc);
+        return ser.put_code(altr.code_body);
+      }
 
-        // Rebind the expression.
-        bool dirty = false;
-        auto bound = altr;
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<index_import_call>();
+        ser.put_options(altr.opts);
+        ser.put_source_location(altr.sloc);
+        ser.put_uint32(altr.nargs);
+        return true;
+      }
+
+      case index_immediate_null:
+        return true;
 
-        do_rebind_nodes(dirty, bound.code_body, ctx);
+      case index_immediate_boolean: {
+        const auto& altr = this->m_stor.as<index_immediate_boolean>();
+        ser.put_bool(altr.value);
+        return true;
+      }
 
-        return do_forward_if_opt(dirty, ::std::move(bound));
+      case index_immediate_int_x48: {
+        const auto& altr = this->m_stor.as<index_immediate_int_x48>();
+        ser.put_uint32(altr.low);
+        ser.put_uint32(static_cast<uint16_t>(altr.high));
+        return true;
       }
 
-      case index_import_call:
-      case index_immediate_null:
-      case index_immediate_boolean:
-      case index_immediate_int_x48:
-      case index_immediate_integer:
-      case index_immediate_real:
-      case index_immediate_string:
-      case index_break_or_continue:
-        // There is nothing to rebind.
-        return nullopt;
+      case index_immediate_integer: {
+        const auto& altr = this->m_stor.as<index_immediate_integer>();
+        ser.put_int64(altr.value);
+        return true;
+      }
+
+      case index_immediate_real: {
+        const auto& altr = this->m_stor.as<index_immediate_real>();
+        ser.put_real(altr.value);
+        return true;
+      }
+
+      case index_immediate_string: {
+        const auto& altr = this->m_stor.as<index_immediate_string>();
+        ser.put_string(altr.value);
+        return true;
+      }
+
+      case index_break_or_continue: {
+        const auto& altr = this->m_stor.as<index_break_or_continue>();
+        ser.put_source_location(altr.sloc);
+        ser.put_byte(altr.status);
+        return true;
+      }
+
+      case index_push_captured_reference: {
+        const auto& altr = this->m_stor.as<index_push_captured_reference>();
+        ser.put_uint32(altr.index);
+        ser.put_name(altr.name);
+        return true;
+      }
 
       default:
         ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
     }
   }
 
-bool
+AIR_Node
 AIR_Node::
-solidify(AVMC_Queue& queue)
-const
+deserialize(AIR_Deserializer& des)
   {
-    switch(this->index()) {
-      case index_clear_stack: {
-        const auto& altr = this->m_stor.as<index_clear_stack>();
-        return do_solidify(queue, altr);
-      }
+    // Members are read in the same order as they have been written. Note that the
+    // order of evaluation of function arguments is unspecified, so each member is
+    // read in a separate statement.
+    uint8_t index = des.get_byte();
+    switch(index) {
+      case index_clear_stack:
+        return S_clear_stack();
 
       case index_execute_block: {
-        const auto& altr = this->m_stor.as<index_execute_block>();
-        return do_solidify(queue, altr);
+        S_execute_block xnode;
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_declare_variable: {
-        const auto& altr = this->m_stor.as<index_declare_variable>();
-        return do_solidify(queue, altr);
+        S_declare_variable xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       case index_initialize_variable: {
-        const auto& altr = this->m_stor.as<index_initialize_variable>();
-        return do_solidify(queue, altr);
+        S_initialize_variable xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.immutable = des.get_bool();
+        return ::std::move(xnode);
       }
 
       case index_if_statement: {
-        const auto& altr = this->m_stor.as<index_if_statement>();
-        return do_solidify(queue, altr);
+        S_if_statement xnode;
+        xnode.negative = des.get_bool();
+        xnode.code_true = des.get_code();
+        xnode.code_false = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_switch_statement: {
-        const auto& altr = this->m_stor.as<index_switch_statement>();
-        return do_solidify(queue, altr);
+        S_switch_statement xnode;
+        uint32_t count = des.get_uint32();
+        for(uint32_t i = 0;  i != count;  ++i) {
+          xnode.code_labels.emplace_back(des.get_code());
+          xnode.code_bodies.emplace_back(des.get_code());
+          xnode.names_added.emplace_back(des.get_names());
+        }
+        return ::std::move(xnode);
       }
 
       case index_do_while_statement: {
-        const auto& altr = this->m_stor.as<index_do_while_statement>();
-        return do_solidify(queue, altr);
+        S_do_while_statement xnode;
+        xnode.negative = des.get_bool();
+        xnode.code_body = des.get_code();
+        xnode.code_cond = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_while_statement: {
-        const auto& altr = this->m_stor.as<index_while_statement>();
-        return do_solidify(queue, altr);
+        S_while_statement xnode;
+        xnode.negative = des.get_bool();
+        xnode.code_cond = des.get_code();
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_for_each_statement: {
-        const auto& altr = this->m_stor.as<index_for_each_statement>();
-        return do_solidify(queue, altr);
+        S_for_each_statement xnode;
+        xnode.name_key = des.get_name();
+        xnode.name_mapped = des.get_name();
+        xnode.code_init = des.get_code();
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_for_statement: {
-        const auto& altr = this->m_stor.as<index_for_statement>();
-        return do_solidify(queue, altr);
+        S_for_statement xnode;
+        xnode.code_init = des.get_code();
+        xnode.code_cond = des.get_code();
+        xnode.code_step = des.get_code();
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_try_statement: {
-        const auto& altr = this->m_stor.as<index_try_statement>();
-        return do_solidify(queue, altr);
+        S_try_statement xnode;
+        xnode.sloc_try = des.get_source_location();
+        xnode.code_try = des.get_code();
+        xnode.sloc_catch = des.get_source_location();
+        xnode.name_except = des.get_name();
+        xnode.code_catch = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_throw_statement: {
-        const auto& altr = this->m_stor.as<index_throw_statement>();
-        return do_solidify(queue, altr);
+        S_throw_statement xnode;
+        xnode.sloc = des.get_source_location();
+        return ::std::move(xnode);
       }
 
       case index_assert_statement: {
-        const auto& altr = this->m_stor.as<index_assert_statement>();
-        return do_solidify(queue, altr);
+        S_assert_statement xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.negative = des.get_bool();
+        xnode.msg = des.get_string();
+        return ::std::move(xnode);
       }
 
       case index_return_statement: {
-        const auto& altr = this->m_stor.as<index_return_statement>();
-        return do_solidify(queue, altr);
+        S_return_statement xnode;
+        xnode.status = static_cast<AIR_Status>(des.get_byte());
+        return ::std::move(xnode);
       }
 
       case index_glvalue_to_prvalue: {
-        const auto& altr = this->m_stor.as<index_glvalue_to_prvalue>();
-        return do_solidify(queue, altr);
+        S_glvalue_to_prvalue xnode;
+        xnode.sloc = des.get_source_location();
+        return ::std::move(xnode);
       }
 
       case index_push_immediate: {
-        const auto& altr = this->m_stor.as<index_push_immediate>();
-        return do_solidify(queue, altr);
+        S_push_immediate xnode;
+        xnode.value = des.get_value();
+        return ::std::move(xnode);
       }
 
       case index_push_global_reference: {
-        const auto& altr = this->m_stor.as<index_push_global_reference>();
-        return do_solidify(queue, altr);
+        S_push_global_reference xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       case index_push_local_reference: {
-        const auto& altr = this->m_stor.as<index_push_local_reference>();
-        return do_solidify(queue, altr);
-      }
-
-      case index_push_bound_reference: {
-        const auto& altr = this->m_stor.as<index_push_bound_reference>();
-        return do_solidify(queue, altr);
+        S_push_local_reference xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.depth = des.get_uint32();
+        xnode.slot = des.get_uint32();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       case index_define_function: {
-        const auto& altr = this->m_stor.as<index_define_function>();
-        return do_solidify(queue, altr);
+        S_define_function xnode;
+        xnode.opts = des.get_options();
+        xnode.sloc = des.get_source_location();
+        xnode.func = des.get_string();
+        xnode.params = des.get_names();
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_branch_expression: {
-        const auto& altr = this->m_stor.as<index_branch_expression>();
-        return do_solidify(queue, altr);
+        S_branch_expression xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.assign = des.get_bool();
+        xnode.code_true = des.get_code();
+        xnode.code_false = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_coalescence: {
-        const auto& altr = this->m_stor.as<index_coalescence>();
-        return do_solidify(queue, altr);
+        S_coalescence xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.assign = des.get_bool();
+        xnode.code_null = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_function_call: {
-        const auto& altr = this->m_stor.as<index_function_call>();
-        return do_solidify(queue, altr);
+        S_function_call xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.nargs = des.get_uint32();
+        xnode.ptc = static_cast<PTC_Aware>(des.get_byte());
+        return ::std::move(xnode);
       }
 
       case index_member_access: {
-        const auto& altr = this->m_stor.as<index_member_access>();
-        return do_solidify(queue, altr);
+        S_member_access xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       case index_push_unnamed_array: {
-        const auto& altr = this->m_stor.as<index_push_unnamed_array>();
-        return do_solidify(queue, altr);
+        S_push_unnamed_array xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.nelems = des.get_uint32();
+        return ::std::move(xnode);
       }
 
       case index_push_unnamed_object: {
-        const auto& altr = this->m_stor.as<index_push_unnamed_object>();
-        return do_solidify(queue, altr);
+        S_push_unnamed_object xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.keys = des.get_names();
+        return ::std::move(xnode);
       }
 
       case index_apply_operator: {
-        const auto& altr = this->m_stor.as<index_apply_operator>();
-
-        switch(altr.xop) {
-          case xop_inc_post:
-            return do_solidify<xop_inc_post>(queue, altr);
-
-          case xop_dec_post:
-            return do_solidify<xop_dec_post>(queue, altr);
-
-          case xop_subscr:
-            return do_solidify<xop_subscr>(queue, altr);
-
-          case xop_pos:
-            return do_solidify<xop_pos>(queue, altr);
-
-          case xop_neg:
-            return do_solidify<xop_neg>(queue, altr);
-
-          case xop_notb:
-            return do_solidify<xop_notb>(queue, altr);
-
-          case xop_notl:
-            return do_solidify<xop_notl>(queue, altr);
-
-          case xop_inc_pre:
-            return do_solidify<xop_inc_pre>(queue, altr);
-
-          case xop_dec_pre:
-            return do_solidify<xop_dec_pre>(queue, altr);
-
-          case xop_unset:
-            return do_solidify<xop_unset>(queue, altr);
-
-          case xop_countof:
-            return do_solidify<xop_countof>(queue, altr);
-
-          case xop_typeof:
-            return do_solidify<xop_typeof>(queue, altr);
-
-          case xop_sqrt:
-            return do_solidify<xop_sqrt>(queue, altr);
-
-          case xop_isnan:
-            return do_solidify<xop_isnan>(queue, altr);
-
-          case xop_isinf:
-            return do_solidify<xop_isinf>(queue, altr);
-
-          case xop_abs:
-            return do_solidify<xop_abs>(queue, altr);
-
-          case xop_sign:
-            return do_solidify<xop_sign>(queue, altr);
-
-          case xop_round:
-            return do_solidify<xop_round>(queue, altr);
-
-          case xop_floor:
-            return do_solidify<xop_floor>(queue, altr);
-
-          case xop_ceil:
-            return do_solidify<xop_ceil>(queue, altr);
-
-          case xop_trunc:
-            return do_solidify<xop_trunc>(queue, altr);
-
-          case xop_roundi:
-            return do_solidify<xop_roundi>(queue, altr);
-
-          case xop_floori:
-            return do_solidify<xop_floori>(queue, altr);
-
-          case xop_ceili:
-            return do_solidify<xop_ceili>(queue, altr);
-
-          case xop_trunci:
-            return do_solidify<xop_trunci>(queue, altr);
-
-          case xop_cmp_eq:
-            return do_solidify<xop_cmp_eq>(queue, altr);
-
-          case xop_cmp_ne:
-            return do_solidify<xop_cmp_ne>(queue, altr);
-
-          case xop_cmp_lt:
-            return do_solidify<xop_cmp_lt>(queue, altr);
-
-          case xop_cmp_gt:
-            return do_solidify<xop_cmp_gt>(queue, altr);
-
-          case xop_cmp_lte:
-            return do_solidify<xop_cmp_lte>(queue, altr);
-
-          case xop_cmp_gte:
-            return do_solidify<xop_cmp_gte>(queue, altr);
-
-          case xop_cmp_3way:
-            return do_solidify<xop_cmp_3way>(queue, altr);
-
-          case xop_add:
-            return do_solidify<xop_add>(queue, altr);
-
-          case xop_sub:
-            return do_solidify<xop_sub>(queue, altr);
-
-          case xop_mul:
-            return do_solidify<xop_mul>(queue, altr);
-
-          case xop_div:
-            return do_solidify<xop_div>(queue, altr);
-
-          case xop_mod:
-            return do_solidify<xop_mod>(queue, altr);
-
-          case xop_sll:
-            return do_solidify<xop_sll>(queue, altr);
-
-          case xop_srl:
-            return do_solidify<xop_srl>(queue, altr);
-
-          case xop_sla:
-            return do_solidify<xop_sla>(queue, altr);
-
-          case xop_sra:
-            return do_solidify<xop_sra>(queue, altr);
-
-          case xop_andb:
-            return do_solidify<xop_andb>(queue, altr);
-
-          case xop_orb:
-            return do_solidify<xop_orb>(queue, altr);
-
-          case xop_xorb:
-            return do_solidify<xop_xorb>(queue, altr);
-
-          case xop_assign:
-            return do_solidify<xop_assign>(queue, altr);
-
-          case xop_fma:
-            return do_solidify<xop_fma>(queue, altr);
-
-          case xop_head:
-            return do_solidify<xop_head>(queue, altr);
-
-          case xop_tail:
-            return do_solidify<xop_tail>(queue, altr);
-
-          default:
-            ASTERIA_TERMINATE("invalid operator type (xop `$1`)", altr.xop);
-        }
+        S_apply_operator xnode;
+        xnode.sloc = des.get_source_location();
+        uint8_t xop = des.get_byte();
+        if(xop > xop_tail)
+          ASTERIA_THROW("invalid operator in serialized data (xop `$1`)", xop);
+        xnode.xop = static_cast<Xop>(xop);
+        xnode.assign = des.get_bool();
+        return ::std::move(xnode);
       }
 
       case index_unpack_struct_array: {
-        const auto& altr = this->m_stor.as<index_unpack_struct_array>();
-        return do_solidify(queue, altr);
+        S_unpack_struct_array xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.immutable = des.get_bool();
+        xnode.nelems = des.get_uint32();
+        return ::std::move(xnode);
       }
 
       case index_unpack_struct_object: {
-        const auto& altr = this->m_stor.as<index_unpack_struct_object>();
-        return do_solidify(queue, altr);
+        S_unpack_struct_object xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.immutable = des.get_bool();
+        xnode.keys = des.get_names();
+        return ::std::move(xnode);
       }
 
       case index_define_null_variable: {
-        const auto& altr = this->m_stor.as<index_define_null_variable>();
-        return do_solidify(queue, altr);
+        S_define_null_variable xnode;
+        xnode.immutable = des.get_bool();
+        xnode.sloc = des.get_source_location();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       case index_single_step_trap: {
-        const auto& altr = this->m_stor.as<index_single_step_trap>();
-        return do_solidify(queue, altr);
+        S_single_step_trap xnode;
+        xnode.sloc = des.get_source_location();
+        return ::std::move(xnode);
       }
 
       case index_variadic_call: {
-        const auto& altr = this->m_stor.as<index_variadic_call>();
-        return do_solidify(queue, altr);
+        S_variadic_call xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.ptc = static_cast<PTC_Aware>(des.get_byte());
+        return ::std::move(xnode);
       }
 
       case index_defer_expression: {
-        const auto& altr = this->m_stor.as<index_defer_expression>();
-        return do_solidify(queue, altr);
+        S_defer_expression xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.code_body = des.get_code();
+        return ::std::move(xnode);
       }
 
       case index_import_call: {
-        const auto& altr = this->m_stor.as<index_import_call>();
-        return do_solidify(queue, altr);
+        S_import_call xnode;
+        xnode.opts = des.get_options();
+        xnode.sloc = des.get_source_location();
+        xnode.nargs = des.get_uint32();
+        return ::std::move(xnode);
       }
 
-      case index_immediate_null: {
-        const auto& altr = this->m_stor.as<index_immediate_null>();
-        return do_solidify(queue, altr);
-      }
+      case index_immediate_null:
+        return S_immediate_null();
 
       case index_immediate_boolean: {
-        const auto& altr = this->m_stor.as<index_immediate_boolean>();
-        return do_solidify(queue, altr);
+        S_immediate_boolean xnode;
+        xnode.value = des.get_bool();
+        return ::std::move(xnode);
       }
 
       case index_immediate_int_x48: {
-        const auto& altr = this->m_stor.as<index_immediate_int_x48>();
-        return do_solidify(queue, altr);
+        S_immediate_int_x48 xnode;
+        xnode.low = des.get_uint32();
+        xnode.high = static_cast<int16_t>(des.get_uint32());
+        return ::std::move(xnode);
       }
 
       case index_immediate_integer: {
-        const auto& altr = this->m_stor.as<index_immediate_integer>();
-        return do_solidify(queue, altr);
+        S_immediate_integer xnode;
+        xnode.value = des.get_int64();
+        return ::std::move(xnode);
       }
 
       case index_immediate_real: {
-        const auto& altr = this->m_stor.as<index_immediate_real>();
-        return do_solidify(queue, altr);
+        S_immediate_real xnode;
+        xnode.value = des.get_real();
+        return ::std::move(xnode);
       }
 
       case index_immediate_string: {
-        const auto& altr = this->m_stor.as<index_immediate_string>();
-        return do_solidify(queue, altr);
+        S_immediate_string xnode;
+        xnode.value = des.get_string();
+        return ::std::move(xnode);
       }
 
       case index_break_or_continue: {
-        const auto& altr = this->m_stor.as<index_break_or_continue>();
-        return do_solidify(queue, altr);
+        S_break_or_continue xnode;
+        xnode.sloc = des.get_source_location();
+        xnode.status = static_cast<AIR_Status>(des.get_byte());
+        return ::std::move(xnode);
+      }
+
+      case index_push_captured_reference: {
+        S_push_captured_reference xnode;
+        xnode.index = des.get_uint32();
+        xnode.name = des.get_name();
+        return ::std::move(xnode);
       }
 
       default:
-        ASTERIA_TERMINATE("invalid AIR node type (index `$1`)", this->index());
+        ASTERIA_THROW("invalid AIR node type in serialized data (index `$1`)", index);
     }
   }
 
@@ -5082,6 +7560,7 @@ const
       case index_immediate_real:
       case index_immediate_string:
       case index_break_or_continue:
+      case index_push_captured_reference:
         return callback;
 
       default:
@@ -125,6 +125,7 @@ class AIR_Node
       {
         Source_Location sloc;
         uint32_t depth;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -207,7 +208,7 @@ class AIR_Node
       {
         bool immutable;
         Source_Location sloc;
-        phsh_string name;
+        phsh_string name;  // if empty, only a slot is reserved
       };
 
     struct S_single_step_trap
@@ -270,6 +271,12 @@ class AIR_Node
         AIR_Status status;
       };
 
+    struct S_push_captured_reference
+      {
+        uint32_t index;
+        phsh_string name;
+      };
+
     enum Index : uint8_t
       {
         index_clear_stack            =  0,
@@ -313,6 +320,7 @@ class AIR_Node
         index_immediate_real         = 38,
         index_immediate_string       = 39,
         index_break_or_continue      = 40,
+        index_push_captured_reference  = 41,
       };
 
     using Storage = variant<
@@ -358,6 +366,7 @@ class AIR_Node
       , S_immediate_real         // 38,
       , S_immediate_string       // 39,
       , S_break_or_continue      // 40,
+      , S_push_captured_reference  // 41,
       )>;
 
     static_assert(::std::is_nothrow_copy_assignable<Storage>::value);
@@ -392,11 +401,44 @@ class AIR_Node
 
     // Rebind this node.
     // If this node refers to a local reference, which has been allocated in an
-    // executive context now, we need to replace `*this` with a copy of it.
+    // executive context now, we need to replace `*this` with a copy of it. This
+    // happens when a deferred expression is declared.
+    // If `captures_opt` is specified, references beyond the outermost context are
+    // replaced with captured references, whose depths, slots and names are appended
+    // to `*captures_opt`. Nested functions are inspected but not modified.
+    opt<AIR_Node>
+    rebind_opt(const Abstract_Context& ctx, cow_vector<S_push_local_reference>* captures_opt = nullptr)
+    const;
+
+    // If this node executes a block on a new scope, return its body.
+    const cow_vector<AIR_Node>*
+    get_block_body_opt()
+    const noexcept;
+
+    // If this node pushes a constant, return a copy of its value.
+    opt<Value>
+    get_constant_opt()
+    const;
+
+    // Optimize nested code of this node according to `opts`.
+    // If anything has been changed, a copy of `*this` is returned.
     opt<AIR_Node>
-    rebind_opt(const Abstract_Context& ctx)
+    optimize_opt(const Compiler_Options& opts)
     const;
 
+    // Check whether this node, or any node nested in it, may refer to the local
+    // reference `name`. This is conservative: shadowing is not taken into account.
+    bool
+    refers_to_local(const phsh_string& name)
+    const;
+
+    // Perform constant folding and dead code elimination on `code`.
+    // If `scoped` is `false`, declarations are retained, as names may be referenced by
+    // code outside `code`. The return value indicates whether `code` has been changed.
+    static
+    bool
+    optimize_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts, bool scoped);
+
     // Compress this IR node.
     // The return value indicates whether this node terminates control flow i.e.
     // all subsequent nodes are unreachable.
@@ -404,6 +446,24 @@ class AIR_Node
     solidify(AVMC_Queue& queue)
     const;
 
+    // Compress a sequence of IR nodes.
+    // Common sequences of nodes are fused into single AVMC nodes, which reduces the
+    // number of indirect calls during execution. The return value is the same as above.
+    static
+    bool
+    solidify_code(AVMC_Queue& queue, const cow_vector<AIR_Node>& code);
+
+    // Write this node to `ser`, so it can be read back with `deserialize()`.
+    // If this node refers to runtime objects, `false` is returned.
+    bool
+    serialize(AIR_Serializer& ser)
+    const;
+
+    // Read a node that has been written by `serialize()`.
+    static
+    AIR_Node
+    deserialize(AIR_Deserializer& des);
+
     // This is needed because the body of a closure should not be solidified.
     Variable_Callback&
     enumerate_variables(Variable_Callback& callback)
@@ -22,6 +22,7 @@ reload(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
   {
     this->m_code.clear();
     this->m_params = params;
+    this->m_captures.clear();
 
     // Generate code for all statements.
     Analytic_Context ctx_func(ctx_opt, this->m_params);
@@ -31,35 +32,35 @@ reload(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
                           ? ptc_aware_void : ptc_aware_none);
     }
 
-    // TODO: Insert optimization passes
+    // Fold constants and eliminate dead code.
+    AIR_Node::optimize_code(this->m_code, this->m_opts, true);
     return *this;
   }
 
 AIR_Optimizer&
 AIR_Optimizer::
-rebind(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
-       const cow_vector<AIR_Node>& code)
+capture(const cow_vector<phsh_string>& params, const cow_vector<AIR_Node>& code)
   {
     this->m_code = code;
     this->m_params = params;
+    this->m_captures.clear();
 
-    // Rebind all nodes recursively.
+    // Rewrite all nodes recursively.
     // Don't trigger copy-on-write unless a node needs rewriting.
-    Analytic_Context ctx_func(ctx_opt, params);
+    // The function context has no parent, so references that go beyond it are captured.
+    Analytic_Context ctx_func(static_cast<const Abstract_Context*>(nullptr), params);
     for(size_t i = 0;  i < code.size();  ++i) {
-      auto qnode = code.at(i).rebind_opt(ctx_func);
+      auto qnode = code.at(i).rebind_opt(ctx_func, &(this->m_captures));
       if(!qnode)
         continue;
       this->m_code.mut(i) = ::std::move(*qnode);
     }
-
-    // TODO: Insert optimization passes
     return *this;
   }
 
-cow_function
+rcptr<Function_Template>
 AIR_Optimizer::
-create_function(const Source_Location& sloc, const cow_string& name)
+create_template(const Source_Location& sloc, const cow_string& name)
   {
     // Append the parameter list to `name`.
     // We only do this if `name` really looks like a function name.
@@ -73,10 +74,20 @@ create_function(const Source_Location& sloc, const cow_string& name)
       func << ')';
     }
 
-    // Instantiate the function.
-    return ::rocket::make_refcnt<Instantiated_Function>(this->m_params,
+    // Create the template. The body is not solidified until it is called.
+    return ::rocket::make_refcnt<Function_Template>(this->m_params,
                          ::rocket::make_refcnt<Variadic_Arguer>(sloc, ::std::move(func)),
-                         this->m_code);
+                         this->m_code, this->m_captures);
+  }
+
+cow_function
+AIR_Optimizer::
+create_function(const Source_Location& sloc, const cow_string& name)
+  {
+    // Instantiate the function.
+    ROCKET_ASSERT(this->m_captures.empty());
+    return ::rocket::make_refcnt<Instantiated_Function>(this->create_template(sloc, name),
+                                                        cow_vector<Reference>());
   }
 
 }  // namespace Asteria
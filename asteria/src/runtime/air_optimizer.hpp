@@ -15,6 +15,7 @@ class AIR_Optimizer
     Compiler_Options m_opts;
     cow_vector<phsh_string> m_params;
     cow_vector<AIR_Node> m_code;
+    cow_vector<AIR_Node::S_push_local_reference> m_captures;
 
   public:
     explicit constexpr
@@ -58,7 +59,7 @@ class AIR_Optimizer
     AIR_Optimizer&
     clear()
     noexcept
-      { return this->m_code.clear(), *this;  }
+      { return this->m_code.clear(), this->m_captures.clear(), *this;  }
 
     // This function performs code generation.
     // `ctx_opt` is the parent context this closure.
@@ -66,13 +67,17 @@ class AIR_Optimizer
     reload(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
            const cow_vector<Statement>& stmts);
 
-    // This function loads some already-generated code.
-    // `ctx_opt` is the parent context this closure.
+    // This function loads some already-generated code, which is the body of a closure.
+    // References to enclosing functions are replaced with captured references.
     AIR_Optimizer&
-    rebind(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
-           const cow_vector<AIR_Node>& code);
+    capture(const cow_vector<phsh_string>& params, const cow_vector<AIR_Node>& code);
+
+    // Create a template from which closures can be instantiated.
+    rcptr<Function_Template>
+    create_template(const Source_Location& sloc, const cow_string& name);
 
     // Create a closure value that can be assigned to a variable.
+    // Nothing may have been captured.
     cow_function
     create_function(const Source_Location& sloc, const cow_string& name);
   };
@@ -0,0 +1,291 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "air_serializer.hpp"
+#include "air_node.hpp"
+#include "../value.hpp"
+#include "../utilities.hpp"
+
+namespace Asteria {
+
+void
+AIR_Serializer::
+put_string(const cow_string& str)
+  {
+    this->put_uint32(static_cast<uint32_t>(str.size()));
+    this->do_put_raw(str.data(), str.size());
+  }
+
+void
+AIR_Serializer::
+put_name(const phsh_string& name)
+  {
+    this->put_string(name.rdstr());
+  }
+
+void
+AIR_Serializer::
+put_names(const cow_vector<phsh_string>& names)
+  {
+    this->put_uint32(static_cast<uint32_t>(names.size()));
+    for(const auto& name : names)
+      this->put_name(name);
+  }
+
+void
+AIR_Serializer::
+put_source_location(const Source_Location& sloc)
+  {
+    // Look for the file name in the table. In most cases there is only one.
+    uint32_t index = 0;
+    while((index != this->m_files.size()) && (this->m_files[index] != sloc.file()))
+      ++index;
+
+    // A new file name is written after its index.
+    this->put_uint32(index);
+    if(index == this->m_files.size()) {
+      this->put_string(sloc.file());
+      this->m_files.emplace_back(sloc.file());
+    }
+    this->put_uint32(static_cast<uint32_t>(sloc.line()));
+    this->put_uint32(static_cast<uint32_t>(sloc.offset()));
+  }
+
+void
+AIR_Serializer::
+put_options(const Compiler_Options& opts)
+  {
+    this->put_byte(opts.version);
+    this->put_bool(opts.escapable_single_quotes);
+    this->put_bool(opts.keywords_as_identifiers);
+    this->put_bool(opts.integers_as_reals);
+    this->put_bool(opts.proper_tail_calls);
+    this->put_byte(static_cast<uint8_t>(opts.optimization_level));
+    this->put_bool(opts.verbose_single_step_traps);
+    this->put_bool(opts.cache_compiled_code);
+  }
+
+bool
+AIR_Serializer::
+put_value(const Value& val)
+  {
+    this->put_byte(val.vtype());
+    switch(val.vtype()) {
+      case vtype_null:
+        return true;
+
+      case vtype_boolean:
+        this->put_bool(val.as_boolean());
+        return true;
+
+      case vtype_integer:
+        this->put_int64(val.as_integer());
+        return true;
+
+      case vtype_real:
+        this->put_real(val.as_real());
+        return true;
+
+      case vtype_string:
+        this->put_string(val.as_string());
+        return true;
+
+      case vtype_opaque:
+      case vtype_function:
+        return false;
+
+      case vtype_array: {
+        const auto& arr = val.as_array();
+        this->put_uint32(static_cast<uint32_t>(arr.size()));
+        for(const auto& elem : arr)
+          if(!this->put_value(elem))
+            return false;
+        return true;
+      }
+
+      case vtype_object: {
+        const auto& obj = val.as_object();
+        this->put_uint32(static_cast<uint32_t>(obj.size()));
+        for(auto it = obj.begin();  it != obj.end();  ++it) {
+          this->put_name(it->first);
+          if(!this->put_value(it->second))
+            return false;
+        }
+        return true;
+      }
+
+      default:
+        ASTERIA_TERMINATE("invalid value type (type `$1`)", val.vtype());
+    }
+  }
+
+bool
+AIR_Serializer::
+put_code(const cow_vector<AIR_Node>& code)
+  {
+    this->put_uint32(static_cast<uint32_t>(code.size()));
+    for(const auto& node : code)
+      if(!node.serialize(*this))
+        return false;
+    return true;
+  }
+
+const char*
+AIR_Deserializer::
+do_get_raw(size_t size)
+  {
+    if(static_cast<size_t>(this->m_eptr - this->m_bptr) < size)
+      ASTERIA_THROW("unexpected end of serialized data");
+
+    auto bptr = this->m_bptr;
+    this->m_bptr += size;
+    return bptr;
+  }
+
+uint32_t
+AIR_Deserializer::
+get_uint32()
+  {
+    uint32_t val;
+    ::std::memcpy(&val, this->do_get_raw(sizeof(val)), sizeof(val));
+    return val;
+  }
+
+int64_t
+AIR_Deserializer::
+get_int64()
+  {
+    int64_t val;
+    ::std::memcpy(&val, this->do_get_raw(sizeof(val)), sizeof(val));
+    return val;
+  }
+
+double
+AIR_Deserializer::
+get_real()
+  {
+    double val;
+    ::std::memcpy(&val, this->do_get_raw(sizeof(val)), sizeof(val));
+    return val;
+  }
+
+cow_string
+AIR_Deserializer::
+get_string()
+  {
+    uint32_t size = this->get_uint32();
+    auto bptr = this->do_get_raw(size);
+    return cow_string(bptr, size);
+  }
+
+phsh_string
+AIR_Deserializer::
+get_name()
+  {
+    return phsh_string(this->get_string());
+  }
+
+cow_vector<phsh_string>
+AIR_Deserializer::
+get_names()
+  {
+    cow_vector<phsh_string> names;
+    uint32_t count = this->get_uint32();
+    names.reserve(::rocket::min(count, size_t(this->m_eptr - this->m_bptr)));
+    for(uint32_t i = 0;  i != count;  ++i)
+      names.emplace_back(this->get_name());
+    return names;
+  }
+
+Source_Location
+AIR_Deserializer::
+get_source_location()
+  {
+    // File names are shared, so their storage is not duplicated.
+    uint32_t index = this->get_uint32();
+    if(index > this->m_files.size())
+      ASTERIA_THROW("invalid file index in serialized data (index `$1`)", index);
+    if(index == this->m_files.size())
+      this->m_files.emplace_back(this->get_string());
+
+    int line = static_cast<int>(this->get_uint32());
+    int offset = static_cast<int>(this->get_uint32());
+    return Source_Location(this->m_files[index], line, offset);
+  }
+
+Compiler_Options
+AIR_Deserializer::
+get_options()
+  {
+    Compiler_Options opts;
+    if(this->get_byte() != opts.version)
+      ASTERIA_THROW("compiler options version mismatch in serialized data");
+
+    opts.escapable_single_quotes = this->get_bool();
+    opts.keywords_as_identifiers = this->get_bool();
+    opts.integers_as_reals = this->get_bool();
+    opts.proper_tail_calls = this->get_bool();
+    opts.optimization_level = static_cast<int8_t>(this->get_byte());
+    opts.verbose_single_step_traps = this->get_bool();
+    opts.cache_compiled_code = this->get_bool();
+    return opts;
+  }
+
+Value
+AIR_Deserializer::
+get_value()
+  {
+    uint8_t vtype = this->get_byte();
+    switch(vtype) {
+      case vtype_null:
+        return V_null();
+
+      case vtype_boolean:
+        return V_boolean(this->get_bool());
+
+      case vtype_integer:
+        return V_integer(this->get_int64());
+
+      case vtype_real:
+        return V_real(this->get_real());
+
+      case vtype_string:
+        return this->get_string();
+
+      case vtype_array: {
+        V_array arr;
+        uint32_t count = this->get_uint32();
+        for(uint32_t i = 0;  i != count;  ++i)
+          arr.emplace_back(this->get_value());
+        return ::std::move(arr);
+      }
+
+      case vtype_object: {
+        V_object obj;
+        uint32_t count = this->get_uint32();
+        for(uint32_t i = 0;  i != count;  ++i) {
+          auto key = this->get_name();
+          obj.insert_or_assign(::std::move(key), this->get_value());
+        }
+        return ::std::move(obj);
+      }
+
+      default:
+        ASTERIA_THROW("invalid value type in serialized data (type `$1`)", vtype);
+    }
+  }
+
+cow_vector<AIR_Node>
+AIR_Deserializer::
+get_code()
+  {
+    cow_vector<AIR_Node> code;
+    uint32_t count = this->get_uint32();
+    code.reserve(::rocket::min(count, size_t(this->m_eptr - this->m_bptr)));
+    for(uint32_t i = 0;  i != count;  ++i)
+      code.emplace_back(AIR_Node::deserialize(*this));
+    return code;
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,166 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_AIR_SERIALIZER_HPP_
+#define ASTERIA_RUNTIME_AIR_SERIALIZER_HPP_
+
+#include "../fwd.hpp"
+#include "../source_location.hpp"
+
+namespace Asteria {
+
+// These classes convert IR nodes to and from a compact binary form, which is
+// used by cache files of compiled scripts. The binary form is only meant to be
+// read by the same build on the same machine, so integers are stored in native
+// byte order.
+// Names of source files are stored once and then referenced by index.
+class AIR_Serializer
+  {
+  private:
+    cow_string m_buf;
+    cow_vector<cow_string> m_files;
+
+  public:
+    AIR_Serializer()
+    noexcept
+      { }
+
+    ASTERIA_DECLARE_NONCOPYABLE(AIR_Serializer);
+
+  private:
+    void
+    do_put_raw(const void* data, size_t size)
+      { this->m_buf.append(static_cast<const char*>(data), size);  }
+
+  public:
+    const cow_string&
+    get_string()
+    const noexcept
+      { return this->m_buf;  }
+
+    cow_string
+    extract_string()
+    noexcept
+      { return ::std::move(this->m_buf);  }
+
+    AIR_Serializer&
+    clear()
+    noexcept
+      { return this->m_buf.clear(), this->m_files.clear(), *this;  }
+
+    // These functions write primitive values.
+    void
+    put_byte(uint8_t val)
+      { this->m_buf.push_back(static_cast<char>(val));  }
+
+    void
+    put_bool(bool val)
+      { this->put_byte(val);  }
+
+    void
+    put_uint32(uint32_t val)
+      { this->do_put_raw(&val, sizeof(val));  }
+
+    void
+    put_int64(int64_t val)
+      { this->do_put_raw(&val, sizeof(val));  }
+
+    void
+    put_real(double val)
+      { this->do_put_raw(&val, sizeof(val));  }
+
+    void
+    put_string(const cow_string& str);
+
+    void
+    put_name(const phsh_string& name);
+
+    void
+    put_names(const cow_vector<phsh_string>& names);
+
+    void
+    put_source_location(const Source_Location& sloc);
+
+    void
+    put_options(const Compiler_Options& opts);
+
+    // These functions write values and code.
+    // If anything refers to runtime objects, such as functions, opaque values or
+    // bound references, it cannot be written, and `false` is returned. In this case
+    // the contents of this buffer are unspecified.
+    bool
+    put_value(const Value& val);
+
+    bool
+    put_code(const cow_vector<AIR_Node>& code);
+  };
+
+class AIR_Deserializer
+  {
+  private:
+    const char* m_bptr;
+    const char* m_eptr;
+    cow_vector<cow_string> m_files;
+
+  public:
+    AIR_Deserializer(const char* bptr, const char* eptr)
+    noexcept
+      : m_bptr(bptr), m_eptr(eptr)
+      { }
+
+    ASTERIA_DECLARE_NONCOPYABLE(AIR_Deserializer);
+
+  private:
+    const char*
+    do_get_raw(size_t size);
+
+  public:
+    bool
+    at_end()
+    const noexcept
+      { return this->m_bptr == this->m_eptr;  }
+
+    // These functions read data that have been written by `AIR_Serializer`.
+    // An exception is thrown if the input is malformed.
+    uint8_t
+    get_byte()
+      { return static_cast<uint8_t>(*(this->do_get_raw(1)));  }
+
+    bool
+    get_bool()
+      { return this->get_byte() != 0;  }
+
+    uint32_t
+    get_uint32();
+
+    int64_t
+    get_int64();
+
+    double
+    get_real();
+
+    cow_string
+    get_string();
+
+    phsh_string
+    get_name();
+
+    cow_vector<phsh_string>
+    get_names();
+
+    Source_Location
+    get_source_location();
+
+    Compiler_Options
+    get_options();
+
+    Value
+    get_value();
+
+    cow_vector<AIR_Node>
+    get_code();
+  };
+
+}  // namespace Asteria
+
+#endif
@@ -31,14 +31,12 @@ do_prepare_function(const cow_vector<phsh_string>& params)
         break;
       }
       // Its contents are out of interest.
-      this->open_named_reference(name) /*= Reference_root::S_void()*/;
+      // Parameters are bound by position, so they are not hashed.
+      this->append_unhashed_reference(name) /*= Reference_root::S_void()*/;
     }
 
     // Set pre-defined references.
-    // N.B. If you have ever changed these, remember to update 'executive_context.cpp' as well.
-    this->open_named_reference(::rocket::sref("__varg")) /*= Reference_root::S_void()*/;
-    this->open_named_reference(::rocket::sref("__this")) /*= Reference_root::S_void()*/;
-    this->open_named_reference(::rocket::sref("__func")) /*= Reference_root::S_void()*/;
+    this->do_append_predefined_references();
   }
 
 }  // namespace Asteria
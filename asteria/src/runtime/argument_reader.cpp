@@ -9,13 +9,27 @@ namespace Asteria {
 
 void
 Argument_Reader::
-do_record_parameter_required(Vtype vtype)
+do_record_parameter(uint8_t desc)
   {
     if(this->m_state.finished)
       ASTERIA_THROW("argument reader finished and disposed");
 
+    // If the history is full, the last parameter is shown as `<more>`, which can't be
+    // mistaken for the variadic placeholder.
+    auto& hist = this->m_state.history;
+    auto& nhist = this->m_state.nhist;
+    if(ROCKET_EXPECT(nhist < ::rocket::countof(hist)))
+      hist[nhist++] = desc;
+    else
+      hist[nhist - 1] = param_omitted;
+  }
+
+void
+Argument_Reader::
+do_record_parameter_required(Vtype vtype)
+  {
     // Record a parameter and increment the number of parameters in total.
-    this->m_state.history << ", " << describe_vtype(vtype);
+    this->do_record_parameter(vtype);
     this->m_state.nparams++;
   }
 
@@ -23,11 +37,8 @@ void
 Argument_Reader::
 do_record_parameter_optional(Vtype vtype)
   {
-    if(this->m_state.finished)
-      ASTERIA_THROW("argument reader finished and disposed");
-
     // Record a parameter and increment the number of parameters in total.
-    this->m_state.history << ", [" << describe_vtype(vtype) << ']';
+    this->do_record_parameter(static_cast<uint8_t>(vtype | param_optional));
     this->m_state.nparams++;
   }
 
@@ -35,11 +46,8 @@ void
 Argument_Reader::
 do_record_parameter_generic()
   {
-    if(this->m_state.finished)
-      ASTERIA_THROW("argument reader finished and disposed");
-
     // Record a parameter and increment the number of parameters in total.
-    this->m_state.history << ", <generic>";
+    this->do_record_parameter(param_generic);
     this->m_state.nparams++;
   }
 
@@ -47,11 +55,8 @@ void
 Argument_Reader::
 do_record_parameter_variadic()
   {
-    if(this->m_state.finished)
-      ASTERIA_THROW("argument reader finished and disposed");
-
     // Terminate the parameter list.
-    this->m_state.history << ", ...";
+    this->do_record_parameter(param_variadic);
   }
 
 void
@@ -61,10 +66,18 @@ do_record_parameter_finish()
     if(this->m_state.finished)
       ASTERIA_THROW("argument reader finished and disposed");
 
+    // Append this overload to the overload list, if it fits.
+    const auto& hist = this->m_state.history;
+    auto nhist = this->m_state.nhist;
+    if(::rocket::countof(this->m_ovlds) - this->m_novlds <= nhist) {
+      this->m_ovlds_trunc = true;
+      return;
+    }
+
+    ::std::memcpy(this->m_ovlds + this->m_novlds, hist, nhist);
+    this->m_novlds = static_cast<uint8_t>(this->m_novlds + nhist);
     // Terminate this overload.
-    this->m_state.history.push_back('\0');
-    // Append it to the overload list as a single operation.
-    this->m_ovlds.append(this->m_state.history);
+    this->m_ovlds[this->m_novlds++] = param_end;
   }
 
 const Reference*
@@ -101,7 +114,7 @@ I()
 noexcept
   {
     // Clear internal states.
-    this->m_state.history.clear();
+    this->m_state.nhist = 0;
     this->m_state.nparams = 0;
     this->m_state.finished = false;
     this->m_state.succeeded = true;
@@ -628,24 +641,37 @@ const
     // Append the list of overloads.
     cow_string ovlds_str;
     const auto& ovlds = this->m_ovlds;
-    if(!ovlds.empty()) {
-      ovlds_str << "\n[list of overloads:\n  ";
+    if((this->m_novlds != 0) || this->m_ovlds_trunc) {
+      ovlds_str << "\n[list of overloads:";
       size_t k = 0;
-      for(;;) {
-        ovlds_str << '`' << this->m_name << '(';
-        // Get the current parameter list.
-        const char* sparams = ovlds.data() + k;
-        size_t nchars = ::std::strlen(sparams);
-        // If the parameter list is not empty, it always start with a ", " so skip it.
-        if(nchars != 0)
-          ovlds_str.append(sparams + 2, nchars - 2);
-        k += nchars;
+      while(k != this->m_novlds) {
+        ovlds_str << "\n  `" << this->m_name << '(';
+        // Compose the current parameter list.
+        size_t ks = k;
+        while(ovlds[k] != param_end) {
+          if(k != ks)
+            ovlds_str << ", ";
+
+          auto desc = ovlds[k];
+          if(desc == param_variadic)
+            ovlds_str << "...";
+          else if(desc == param_omitted)
+            ovlds_str << "<more>";
+          else if(desc == param_generic)
+            ovlds_str << "<generic>";
+          else if(desc & param_optional)
+            ovlds_str << '[' << describe_vtype(static_cast<Vtype>(desc & 0x0F)) << ']';
+          else
+            ovlds_str << describe_vtype(static_cast<Vtype>(desc));
+          ++k;
+        }
         ovlds_str << ')' << '`';
-        // Seek to the next overload.
-        if(++k == ovlds.size())
-          break;
-        ovlds_str << "\n  ";
+        // Skip the terminator.
+        ++k;
       }
+      // Mark overloads that have been omitted.
+      if(this->m_ovlds_trunc)
+        ovlds_str << "\n  <more>";
       ovlds_str << "\n  -- end of list of overloads]";
     }
 
@@ -13,9 +13,23 @@ namespace Asteria {
 class Argument_Reader
   {
   public:
+    // Parameters are recorded as one-byte descriptors, which are only turned into text
+    // when no overload matches, so recording doesn't allocate memory.
+    // A descriptor is a `Vtype`, optionally with one of these flags. The variadic
+    // placeholder is recorded as a descriptor of its own.
+    enum : uint8_t
+      {
+        param_optional  = 0x10,
+        param_generic   = 0x20,
+        param_variadic  = 0x40,
+        param_omitted   = 0x80,  // replaces the last parameter if there are too many
+        param_end       = 0xFF,  // terminates an overload in `m_ovlds`
+      };
+
     struct State
       {
-        cow_string history;
+        uint8_t history[15];  // parameters of the current overload
+        uint8_t nhist;
         uint32_t nparams;
         bool finished;
         bool succeeded;
@@ -25,8 +39,12 @@ class Argument_Reader
     refp<const cow_vector<Reference>> m_args;
     cow_string m_name;
 
-    // `m_ovlds` contains all overloads that have been tested so far.
-    cow_string m_ovlds;
+    // `m_ovlds` contains all overloads that have been tested so far, each of which is
+    // terminated by `param_end`. Overloads that don't fit are omitted, and are shown as
+    // `<more>` at the end of the list.
+    uint8_t m_ovlds[127];
+    uint8_t m_novlds = 0;
+    bool m_ovlds_trunc = false;
     // `m_state` can be copied elsewhere and back; any further operations will resume
     // from that point.
     State m_state = { };
@@ -40,6 +58,10 @@ class Argument_Reader
     ASTERIA_DECLARE_NONCOPYABLE(Argument_Reader);
 
   private:
+    inline
+    void
+    do_record_parameter(uint8_t desc);
+
     inline
     void
     do_record_parameter_optional(Vtype vtype);
@@ -77,13 +77,127 @@ struct Variable_Wiper : Variable_Callback
       }
   };
 
+// These are stages of an incremental collection cycle.
+enum : uint8_t
+  {
+    stage_idle            = 0,
+    stage_mark_roots      = 1,  // phase 1, from `m_pending`
+    stage_drop_refs       = 2,  // phase 2, from `m_staging`
+    stage_mark_reachable  = 3,  // phase 3, from `m_staging`
+    stage_sweep           = 4,  // phase 4, from `m_staging`
+    stage_finish          = 5,  // validation of candidates in `m_scanned`
+  };
+
+void
+do_mark_root(Variable_HashSet& staging, const rcptr<Variable>& root)
+  {
+    // Add a variable that is reachable directly.
+    // The reference from `m_tracked` should be excluded, so we initialize the gcref
+    // counter to 1.
+    root->reset_gcref(1);
+    // If this variable has been inserted indirectly, finish.
+    if(!staging.insert(root))
+      return;
+
+    // If `root` is the last reference to this variable, it can be marked for collection
+    // immediately.
+    auto nref = root->use_count();
+    if(nref <= 1) {
+      root->uninitialize();
+      return;
+    }
+
+    // Enumerate variables that are reachable from `root` indirectly.
+    do_traverse(*root,
+      [&](const rcptr<Variable>& child) {
+        // If this variable has been inserted indirectly, finish.
+        if(!staging.insert(child))
+          return false;
+
+        // Initialize the gcref counter.
+        // N.B. If this variable is encountered later from `m_tracked`, the gcref counter
+        // will be overwritten with 1.
+        child->reset_gcref(0);
+        // Decend into grandchildren.
+        return true;
+      });
+  }
+
+void
+do_drop_references(const rcptr<Variable>& root, bool exact)
+  {
+    // Drop a direct reference.
+    // N.B. If references have been moved since `root` was staged, `exact` shall be
+    // false, as gcref counters may exceed reference counts in that case.
+    root->increment_gcref(1);
+    ROCKET_ASSERT(!exact || (root->get_gcref() <= root->use_count()));
+
+    // Skip variables that cannot have any children.
+    auto split = root->gcref_split();
+    if(split <= 0)
+      return;
+
+    // Enumerate variables that are reachable from `root` indirectly.
+    do_traverse(*root,
+      [&](const rcptr<Variable>& child) {
+        // Drop an indirect reference.
+        child->increment_gcref(split);
+        ROCKET_ASSERT(!exact || (child->get_gcref() <= child->use_count()));
+        // This is not going to be recursive.
+        return false;
+      });
+  }
+
+void
+do_mark_reachable(const rcptr<Variable>& root)
+  {
+    // Skip variables that are possibly unreachable.
+    if(root->get_gcref() >= root->use_count())
+      return;
+
+    // Make this variable reachable, ...
+    root->reset_gcref(-1);
+    // ... as well as all children.
+    do_traverse(*root,
+      [&](const rcptr<Variable>& child) {
+        // Skip variables that have already been marked.
+        if(child->get_gcref() < 0)
+          return false;
+
+        // Mark it, ...
+        child->reset_gcref(-1);
+        // ... as well as all grandchildren.
+        return true;
+      });
+  }
+
 }  // namespace
 
+inline
+bool
+Collector::
+do_insert_tracked(const rcptr<Variable>& var)
+  {
+    // Variables that are pending scanning are still being tracked.
+    if(ROCKET_UNEXPECT(this->m_pending.has(var)))
+      return false;
+    return this->m_tracked.insert(var);
+  }
+
+inline
+bool
+Collector::
+do_erase_tracked(const rcptr<Variable>& var)
+noexcept
+  {
+    return this->m_tracked.erase(var) || this->m_pending.erase(var);
+  }
+
 bool
 Collector::
 track_variable(const rcptr<Variable>& var)
   {
-    if(!this->m_tracked.insert(var))
+    if(!this->do_insert_tracked(var))
       return false;
     this->m_counter++;
     // The variable has been inserted successfully.
@@ -92,12 +206,23 @@ track_variable(const rcptr<Variable>& var)
     return true;
   }
 
+bool
+Collector::
+track_variable_deferred(const rcptr<Variable>& var)
+  {
+    if(!this->do_insert_tracked(var))
+      return false;
+    this->m_counter++;
+    // The variable has been inserted successfully.
+    return true;
+  }
+
 bool
 Collector::
 untrack_variable(const rcptr<Variable>& var)
 noexcept
   {
-    if(!this->m_tracked.erase(var))
+    if(!this->do_erase_tracked(var))
       return false;
     this->m_counter--;
     // The variable has been erased successfully.
@@ -120,6 +245,7 @@ collect_single_opt()
     Collector* next = nullptr;
     auto output = this->m_output_opt;
     auto tied = this->m_tied_opt;
+    this->cancel_cycle();
     this->m_staging.clear();
 
     ///////////////////////////////////////////////////////////////////////////
@@ -129,36 +255,7 @@ collect_single_opt()
     ///////////////////////////////////////////////////////////////////////////
     do_traverse(this->m_tracked,
       [&](const rcptr<Variable>& root) {
-        // Add a variable that is reachable directly.
-        // The reference from `m_tracked` should be excluded, so we initialize the gcref
-        // counter to 1.
-        root->reset_gcref(1);
-        // If this variable has been inserted indirectly, finish.
-        if(!this->m_staging.insert(root))
-          return false;
-
-        // If `root` is the last reference to this variable, it can be marked for collection
-        // immediately.
-        auto nref = root->use_count();
-        if(nref <= 1) {
-          root->uninitialize();
-          return false;
-        }
-
-        // Enumerate variables that are reachable from `root` indirectly.
-        do_traverse(*root,
-          [&](const rcptr<Variable>& child) {
-            // If this variable has been inserted indirectly, finish.
-            if(!this->m_staging.insert(child))
-              return false;
-
-            // Initialize the gcref counter.
-            // N.B. If this variable is encountered later from `m_tracked`, the gcref counter
-            // will be overwritten with 1.
-            child->reset_gcref(0);
-            // Decend into grandchildren.
-            return true;
-          });
+        do_mark_root(this->m_staging, root);
         return false;
       });
 
@@ -168,24 +265,7 @@ collect_single_opt()
     ///////////////////////////////////////////////////////////////////////////
     do_traverse(this->m_staging,
       [&](const rcptr<Variable>& root) {
-        // Drop a direct reference.
-        root->increment_gcref(1);
-        ROCKET_ASSERT(root->get_gcref() <= root->use_count());
-
-        // Skip variables that cannot have any children.
-        auto split = root->gcref_split();
-        if(split <= 0)
-          return false;
-
-        // Enumerate variables that are reachable from `root` indirectly.
-        do_traverse(*root,
-          [&](const rcptr<Variable>& child) {
-            // Drop an indirect reference.
-            child->increment_gcref(split);
-            ROCKET_ASSERT(child->get_gcref() <= child->use_count());
-            // This is not going to be recursive.
-            return false;
-          });
+        do_drop_references(root, true);
         return false;
       });
 
@@ -195,24 +275,7 @@ collect_single_opt()
     ///////////////////////////////////////////////////////////////////////////
     do_traverse(this->m_staging,
       [&](const rcptr<Variable>& root) {
-        // Skip variables that are possibly unreachable.
-        if(root->get_gcref() >= root->use_count())
-          return false;
-
-        // Make this variable reachable, ...
-        root->reset_gcref(-1);
-        // ... as well as all children.
-        do_traverse(*root,
-          [&](const rcptr<Variable>& child) {
-            // Skip variables that have already been marked.
-            if(child->get_gcref() < 0)
-              return false;
-
-            // Mark it, ...
-            child->reset_gcref(-1);
-            // ... as well as all grandchildren.
-            return true;
-          });
+        do_mark_reachable(root);
         return false;
       });
 
@@ -236,7 +299,7 @@ collect_single_opt()
 
         if(tied) {
           // Transfer this variable to the next generational collector, if one has been tied.
-          tied->m_tracked.insert(root);
+          tied->do_insert_tracked(root);
           // Check whether the next generation needs to be checked as well.
           if(tied->m_counter++ >= tied->m_threshold)
             next = tied;
@@ -266,6 +329,205 @@ auto_collect()
     while(qnext);
   }
 
+void
+Collector::
+do_finish_cycle()
+  {
+    // Variables may have been modified since they were scanned, so candidates have to be
+    // checked again. Only references from other candidates are dropped this time. Any
+    // other reference makes a candidate reachable, as well as candidates reachable from it.
+    auto output = this->m_output_opt;
+    auto tied = this->m_tied_opt;
+
+    do_traverse(this->m_scanned,
+      [&](const rcptr<Variable>& root) {
+        // The reference from `m_tracked` should be excluded, as in phase 1.
+        root->reset_gcref(this->m_tracked.has(root) ? 1 : 0);
+        return false;
+      });
+
+    do_traverse(this->m_scanned,
+      [&](const rcptr<Variable>& root) {
+        // Drop the reference from `m_scanned`.
+        root->increment_gcref(1);
+        auto split = root->gcref_split();
+        if(split <= 0)
+          return false;
+
+        // Drop indirect references to other candidates.
+        do_traverse(*root,
+          [&](const rcptr<Variable>& child) {
+            if(this->m_scanned.has(child))
+              child->increment_gcref(split);
+            return false;
+          });
+        return false;
+      });
+
+    do_traverse(this->m_scanned,
+      [&](const rcptr<Variable>& root) {
+        // Skip variables that are possibly unreachable.
+        if(root->get_gcref() >= root->use_count())
+          return false;
+
+        // Make this variable reachable, as well as all candidates reachable from it.
+        // Other variables are not examined, as references from them have not been dropped.
+        root->reset_gcref(-1);
+        do_traverse(*root,
+          [&](const rcptr<Variable>& child) {
+            if((child->get_gcref() < 0) || !this->m_scanned.has(child))
+              return false;
+
+            child->reset_gcref(-1);
+            return true;
+          });
+        return false;
+      });
+
+    do_traverse(this->m_scanned,
+      [&](const rcptr<Variable>& root) {
+        // Wipe out unreachable variables, like in phase 4.
+        if(root->get_gcref() >= 0) {
+          root->uninitialize();
+          if(output)
+            output->insert(root);
+          this->m_tracked.erase(root);
+          return false;
+        }
+
+        // Transfer this variable to the next generational collector, if one has been tied.
+        if(tied && this->m_tracked.erase(root)) {
+          tied->do_insert_tracked(root);
+          tied->m_counter++;
+        }
+        return false;
+      });
+
+    this->m_scanned.clear();
+    this->m_stage = stage_idle;
+  }
+
+Collector&
+Collector::
+start_cycle()
+  {
+    if(this->m_stage != stage_idle)
+      return *this;
+
+    // Move all tracked variables into `m_pending`. Variables that are tracked after this
+    // point will not be examined until the next cycle.
+    ROCKET_ASSERT(this->m_pending.empty());
+    this->m_pending.swap(this->m_tracked);
+    this->m_staging.clear();
+    this->m_scanned.clear();
+    this->m_counter = 0;
+    this->m_stage = stage_mark_roots;
+    return *this;
+  }
+
+Collector&
+Collector::
+cancel_cycle()
+noexcept
+  {
+    if(this->m_stage == stage_idle)
+      return *this;
+
+    // Move pending variables back into `m_tracked`, starting from the smaller set.
+    if(this->m_tracked.size() < this->m_pending.size())
+      this->m_tracked.swap(this->m_pending);
+    while(auto var = this->m_pending.erase_random_opt())
+      this->m_tracked.insert(var);
+
+    this->m_staging.clear();
+    this->m_scanned.clear();
+    this->m_stage = stage_idle;
+    return *this;
+  }
+
+size_t
+Collector::
+collect_steps(size_t limit)
+  {
+    // Ignore recursive requests.
+    const Sentry sentry(this->m_recur);
+    if(!sentry)
+      return 0;
+
+    size_t nsteps = 0;
+    while(nsteps < limit) {
+      switch(this->m_stage) {
+        case stage_idle:
+          return nsteps;
+
+        case stage_mark_roots: {
+          // Move a variable back into `m_tracked`, then scan it.
+          auto root = this->m_pending.erase_random_opt();
+          if(!root) {
+            this->m_stage = stage_drop_refs;
+            break;
+          }
+          this->m_tracked.insert(root);
+          do_mark_root(this->m_staging, root);
+          nsteps++;
+          break;
+        }
+
+        case stage_drop_refs:
+        case stage_mark_reachable: {
+          // Move a variable from `m_staging` into `m_scanned`, then process it. When all
+          // variables have been moved, they are moved back for the next phase.
+          auto var = this->m_staging.erase_random_opt();
+          if(!var) {
+            this->m_staging.swap(this->m_scanned);
+            this->m_stage++;
+            break;
+          }
+          this->m_scanned.insert(var);
+          if(this->m_stage == stage_drop_refs) {
+            // Scripts may have run since the previous step.
+            do_drop_references(var, false);
+          }
+          else {
+            // The reference from `var` should be excluded, too.
+            var->increment_gcref(1);
+            do_mark_reachable(var);
+          }
+          nsteps++;
+          break;
+        }
+
+        case stage_sweep: {
+          // Keep unreachable variables in `m_scanned` as candidates.
+          auto var = this->m_staging.erase_random_opt();
+          if(!var) {
+            this->m_stage = stage_finish;
+            break;
+          }
+          if(var->get_gcref() >= 0)
+            this->m_scanned.insert(var);
+          else if(this->m_tied_opt && this->m_tracked.erase(var)) {
+            // Transfer this variable to the next generational collector.
+            this->m_tied_opt->do_insert_tracked(var);
+            this->m_tied_opt->m_counter++;
+          }
+          nsteps++;
+          break;
+        }
+
+        case stage_finish:
+          // This has to be performed as a whole.
+          nsteps += this->m_scanned.size() + 1;
+          this->do_finish_cycle();
+          return nsteps;
+
+        default:
+          ASTERIA_TERMINATE("invalid collection stage (stage `$1`)", static_cast<int>(this->m_stage));
+      }
+    }
+    return nsteps;
+  }
+
 Collector&
 Collector::
 wipe_out_variables()
@@ -277,6 +539,7 @@ noexcept
       return *this;
 
     // Wipe all variables recursively.
+    this->cancel_cycle();
     Variable_Wiper wiper;
     this->m_tracked.enumerate_variables(wiper);
     return *this;
@@ -21,6 +21,12 @@ class Collector
     Variable_HashSet m_tracked;
     Variable_HashSet m_staging;
 
+    // These are used by incremental collection. Tracked variables are moved into
+    // `m_pending` when a cycle starts, and are moved back as they are scanned.
+    uint8_t m_stage = 0;
+    Variable_HashSet m_pending;
+    Variable_HashSet m_scanned;
+
   public:
     Collector(Variable_HashSet* output_opt, Collector* tied_opt, uint32_t threshold)
     noexcept
@@ -29,6 +35,19 @@ class Collector
 
     ASTERIA_DECLARE_NONCOPYABLE(Collector);
 
+  private:
+    inline
+    bool
+    do_insert_tracked(const rcptr<Variable>& var);
+
+    inline
+    bool
+    do_erase_tracked(const rcptr<Variable>& var)
+    noexcept;
+
+    void
+    do_finish_cycle();
+
   public:
     Variable_HashSet*
     get_output_pool_opt()
@@ -60,14 +79,25 @@ class Collector
     noexcept
       { return this->m_threshold = threshold, *this;  }
 
+    // Check whether tracking another variable will trigger garbage collection.
+    bool
+    is_collection_due()
+    const noexcept
+      { return this->m_counter >= this->m_threshold;  }
+
     size_t
     count_tracked_variables()
     const noexcept
-      { return this->m_tracked.size();  }
+      { return this->m_tracked.size() + this->m_pending.size();  }
 
     bool
     track_variable(const rcptr<Variable>& var);
 
+    // This function does not trigger garbage collection. The caller is responsible for
+    // checking `is_collection_due()`.
+    bool
+    track_variable_deferred(const rcptr<Variable>& var);
+
     bool
     untrack_variable(const rcptr<Variable>& var)
     noexcept;
@@ -78,6 +108,28 @@ class Collector
     void
     auto_collect();
 
+    // Incremental collection splits `collect_single_opt()` into steps, between which
+    // variables may be modified arbitrarily. Every step processes one variable, except
+    // the last one, which checks all candidates again and collects only those that are
+    // still unreachable, so its cost is proportional to the amount of garbage.
+    bool
+    is_cycle_in_progress()
+    const noexcept
+      { return this->m_stage != 0;  }
+
+    Collector&
+    start_cycle();
+
+    Collector&
+    cancel_cycle()
+    noexcept;
+
+    // This function performs at most `limit` steps of the current cycle, and returns
+    // the number of steps that have been performed. The final step is always performed
+    // as a whole.
+    size_t
+    collect_steps(size_t limit);
+
     Collector&
     wipe_out_variables()
     noexcept;
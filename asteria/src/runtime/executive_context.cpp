@@ -3,6 +3,7 @@
 
 #include "../precompiled.hpp"
 #include "executive_context.hpp"
+#include "global_context.hpp"
 #include "runtime_error.hpp"
 #include "ptc_arguments.hpp"
 #include "../llds/avmc_queue.hpp"
@@ -33,19 +34,20 @@ Executive_Context::
 do_bind_parameters(const rcptr<Variadic_Arguer>& zvarg, const cow_vector<phsh_string>& params,
                    Reference&& self, cow_vector<Reference>&& args)
   {
+    // Take storage for named references from the pool in `global`, so binding doesn't
+    // allocate memory in general. It is returned by the caller of this function.
+    auto dict = this->m_global->acquire_dictionary_storage();
+    this->swap_named_references(dict);
+
     // Set the zero-ary argument getter.
     this->m_zvarg = zvarg;
 
-    // Set the `this` reference.
-    // If the self reference is null, it is likely that `this` isn't ever referenced in this function,
-    // so perform lazy initialization.
-    if(!self.is_void() && !self.is_constant_null())
-      this->open_named_reference(::rocket::sref("__this")) = ::std::move(self);
-
     // This is the subscript of the special parameter placeholder `...`.
     size_t elps = SIZE_MAX;
 
     // Set parameters, which are local references.
+    // They are bound by position, so their slots match those in the analytic context
+    // and nothing is hashed.
     for(size_t i = 0;  i < params.size();  ++i) {
       const auto& name = params.at(i);
       if(name.empty())
@@ -61,10 +63,11 @@ do_bind_parameters(const rcptr<Variadic_Arguer>& zvarg, const cow_vector<phsh_st
         break;
       }
       // Set the parameter.
+      auto& ref = this->append_unhashed_reference(name);
       if(ROCKET_UNEXPECT(i >= args.size()))
-        this->open_named_reference(name) = Reference_root::S_constant();
+        ref = Reference_root::S_constant();
       else
-        this->open_named_reference(name) = ::std::move(args.mut(i));
+        ref = ::std::move(args.mut(i));
     }
 
     // Disallow exceess arguments if the function is not variadic.
@@ -73,8 +76,16 @@ do_bind_parameters(const rcptr<Variadic_Arguer>& zvarg, const cow_vector<phsh_st
     }
     args.erase(0, elps);
 
+    // Set pre-defined references. They are initialized lazily.
+    auto& ref_this = this->do_append_predefined_references();
+    // If the self reference is null, it is likely that `this` isn't ever referenced in this function,
+    // so perform lazy initialization.
+    if(!self.is_void() && !self.is_constant_null())
+      ref_this = ::std::move(self);
+
     // Stash variadic arguments for lazy initialization.
-    // If all arguments are positional, `args` may be reused for the evaluation stack, so don't move it.
+    // If all arguments are positional, `args` is left empty and its storage is reused for
+    // the evaluation stack, so don't move it.
     if(args.size())
       this->m_lazy_args = ::std::move(args);
   }
@@ -164,7 +175,7 @@ Executive_Context::
 do_lazy_lookup_opt(const phsh_string& name)
   {
     // Create pre-defined references as needed.
-    // N.B. If you have ever changed these, remember to update 'analytic_context.cpp' as well.
+    // N.B. If you have ever changed these, remember to update 'abstract_context.cpp' as well.
     if(name == "__func") {
       // Note: This can only happen inside a function context.
       Reference_root::S_constant xref = { this->m_zvarg->func() };
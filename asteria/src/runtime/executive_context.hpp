@@ -23,6 +23,9 @@ class Executive_Context
     refp<Global_Context> m_global;
     refp<Evaluation_Stack> m_stack;
 
+    // This is the closure that holds captured references, if any.
+    const Instantiated_Function* m_closure_opt;
+
     // These members are used for lazy initialization.
     rcptr<Variadic_Arguer> m_zvarg;
     cow_vector<Reference> m_lazy_args;
@@ -35,20 +38,24 @@ class Executive_Context
     ROCKET_ENABLE_IF(::std::is_base_of<Executive_Context, ContextT>::value)>
     Executive_Context(refp<ContextT> parent)  // for non-functions
       : m_parent_opt(parent.ptr()),
-        m_global(parent->m_global), m_stack(parent->m_stack)
+        m_global(parent->m_global), m_stack(parent->m_stack),
+        m_closure_opt(parent->m_closure_opt)
       { }
 
     Executive_Context(refp<Global_Context> xglobal, refp<Evaluation_Stack> xstack,
                       cow_bivector<Source_Location, AVMC_Queue>&& defer)  // for proper tail calls
       : m_parent_opt(nullptr),
-        m_global(xglobal), m_stack(xstack)
+        m_global(xglobal), m_stack(xstack),
+        m_closure_opt(nullptr)
       { this->m_defer = ::std::move(defer);  }
 
     Executive_Context(refp<Global_Context> xglobal, refp<Evaluation_Stack> xstack,
-                      const rcptr<Variadic_Arguer>& zvarg, const cow_vector<phsh_string>& params,
+                      const Instantiated_Function* closure_opt, const rcptr<Variadic_Arguer>& zvarg,
+                      const cow_vector<phsh_string>& params,
                       Reference&& self, cow_vector<Reference>&& args)  // for functions
       : m_parent_opt(nullptr),
-        m_global(xglobal), m_stack(xstack)
+        m_global(xglobal), m_stack(xstack),
+        m_closure_opt(closure_opt)
       { this->do_bind_parameters(zvarg, params, ::std::move(self), ::std::move(args));  }
 
     ~Executive_Context()
@@ -109,6 +116,11 @@ class Executive_Context
     const noexcept
       { return this->m_stack;  }
 
+    const Instantiated_Function*
+    get_closure_opt()
+    const noexcept
+      { return this->m_closure_opt;  }
+
     // Defer an expression which will be evaluated at scope exit.
     // The result of such expressions are discarded.
     Executive_Context&
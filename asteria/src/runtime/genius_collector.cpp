@@ -5,9 +5,23 @@
 #include "genius_collector.hpp"
 #include "variable.hpp"
 #include "reference.hpp"
+#include "abstract_hooks.hpp"
 #include "../utilities.hpp"
+#include <chrono>
 
 namespace Asteria {
+namespace {
+
+inline
+uint64_t
+do_clock_ns()
+noexcept
+  {
+    auto dur = ::std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(dur).count());
+  }
+
+}  // namespace
 
 Genius_Collector::
 ~Genius_Collector()
@@ -34,6 +48,101 @@ const
     }
   }
 
+void
+Genius_Collector::
+do_track_variable_with_hooks(Collector& coll, GC_Generation gc_gen, const rcptr<Variable>& var)
+  {
+    // Notify the hooks if garbage collection is going to be triggered.
+    auto qhooks = unerase_cast(this->m_qhooks);
+    if(!coll.is_collection_due()) {
+      coll.track_variable(var);
+      return;
+    }
+
+    auto npooled = this->m_pool.size();
+    qhooks->on_garbage_collect_begin(gc_gen);
+    coll.track_variable(var);
+    qhooks->on_garbage_collect_end(gc_gen, this->m_pool.size() - npooled);
+  }
+
+void
+Genius_Collector::
+do_track_variable_incremental(Collector& coll, const rcptr<Variable>& var)
+  {
+    coll.track_variable_deferred(var);
+
+    // If no cycle is in progress, start one on the newest generation that is due.
+    if(!this->is_cycle_in_progress()) {
+      auto gc_gen = gc_generation_newest;
+      while(!this->get_collector(gc_gen).is_collection_due())
+        if((gc_gen = static_cast<GC_Generation>(gc_gen + 1)) > gc_generation_oldest)
+          return;
+
+      this->m_incr_gen = gc_gen;
+      this->m_incr_limit = gc_gen;
+      this->open_collector(gc_gen).start_cycle();
+    }
+    this->do_collect_incremental(this->m_slice, 0);
+  }
+
+void
+Genius_Collector::
+do_start_pass(GC_Generation gc_limit)
+  {
+    // If a cycle is in progress, extend it to `gc_limit`.
+    if(this->is_cycle_in_progress()) {
+      this->m_incr_limit = ::rocket::max(this->m_incr_limit, gc_limit);
+      return;
+    }
+
+    // Otherwise, start from the newest generation.
+    this->m_incr_gen = gc_generation_newest;
+    this->m_incr_limit = gc_limit;
+    this->m_newest.start_cycle();
+  }
+
+size_t
+Genius_Collector::
+do_collect_incremental(size_t limit, uint64_t deadline)
+  {
+    auto qhooks = unerase_cast(this->m_qhooks);
+    auto gc_gen = this->m_incr_gen;
+    auto npooled = this->m_pool.size();
+    if(qhooks)
+      qhooks->on_garbage_collect_begin(gc_gen);
+
+    // Check the clock every few steps if a deadline has been specified.
+    size_t nsteps = 0;
+    for(;;) {
+      auto& coll = this->open_collector(this->m_incr_gen);
+      nsteps += coll.collect_steps(deadline ? ::rocket::min(limit - nsteps, size_t(64)) : (limit - nsteps));
+
+      if(!coll.is_cycle_in_progress()) {
+        // Move on to the next generation if it has been requested or is due.
+        if(this->m_incr_gen == gc_generation_oldest)
+          break;
+
+        auto gc_next = static_cast<GC_Generation>(this->m_incr_gen + 1);
+        auto& next = this->open_collector(gc_next);
+        if((gc_next > this->m_incr_limit) && !next.is_collection_due())
+          break;
+
+        this->m_incr_gen = gc_next;
+        next.start_cycle();
+      }
+
+      if(nsteps >= limit)
+        break;
+      if(deadline && (do_clock_ns() >= deadline))
+        break;
+    }
+
+    auto nvars = this->m_pool.size() - npooled;
+    if(qhooks)
+      qhooks->on_garbage_collect_end(gc_gen, nvars);
+    return nvars;
+  }
+
 rcptr<Variable>
 Genius_Collector::
 create_variable(GC_Generation gc_hint)
@@ -45,7 +154,13 @@ create_variable(GC_Generation gc_hint)
     auto var = this->m_pool.erase_random_opt();
     if(ROCKET_UNEXPECT(!var))
       var = ::rocket::make_refcnt<Variable>();
-    coll.track_variable(var);
+
+    if(ROCKET_UNEXPECT(this->m_slice))
+      this->do_track_variable_incremental(coll, var);
+    else if(ROCKET_EXPECT(!this->m_qhooks))
+      coll.track_variable(var);
+    else
+      this->do_track_variable_with_hooks(coll, gc_hint, var);
 
     // Mark it uninitialized.
     var->uninitialize();
@@ -56,6 +171,11 @@ size_t
 Genius_Collector::
 collect_variables(GC_Generation gc_limit)
   {
+    auto qhooks = unerase_cast(this->m_qhooks);
+    auto npooled = this->m_pool.size();
+    if(qhooks)
+      qhooks->on_garbage_collect_begin(gc_limit);
+
     // Collect variables from the newest generation to the oldest.
     for(auto p = ::std::make_pair(&(this->m_newest), gc_limit + 1);
           p.first && p.second;  p.first = p.first->get_tied_collector_opt(), p.second--)
@@ -64,9 +184,30 @@ collect_variables(GC_Generation gc_limit)
     // Clear the variable pool.
     auto nvars = this->m_pool.size();
     this->m_pool.clear();
+
+    if(qhooks)
+      qhooks->on_garbage_collect_end(gc_limit, nvars - npooled);
     return nvars;
   }
 
+size_t
+Genius_Collector::
+collect_steps(size_t nsteps, GC_Generation gc_limit)
+  {
+    this->do_start_pass(gc_limit);
+    return this->do_collect_incremental(nsteps, 0);
+  }
+
+size_t
+Genius_Collector::
+collect_for(uint32_t usecs, GC_Generation gc_limit)
+  {
+    auto deadline = do_clock_ns() + usecs * UINT64_C(1000);
+
+    this->do_start_pass(gc_limit);
+    return this->do_collect_incremental(SIZE_MAX, deadline);
+  }
+
 Genius_Collector&
 Genius_Collector::
 wipe_out_variables()
@@ -21,6 +21,14 @@ final
     Collector m_middle;
     Collector m_newest;
 
+    rcfwdp<Abstract_Hooks> m_qhooks;
+
+    // These are used by incremental collection. At most one generation is collected
+    // incrementally at a time, which is `m_incr_gen`.
+    uint32_t m_slice = 0;
+    GC_Generation m_incr_gen = gc_generation_newest;
+    GC_Generation m_incr_limit = gc_generation_newest;
+
   public:
     Genius_Collector()
     noexcept
@@ -39,7 +47,35 @@ final
     do_locate(GC_Generation gc_gen)
     const;
 
+    ROCKET_NOINLINE
+    void
+    do_track_variable_with_hooks(Collector& coll, GC_Generation gc_gen, const rcptr<Variable>& var);
+
+    ROCKET_NOINLINE
+    void
+    do_track_variable_incremental(Collector& coll, const rcptr<Variable>& var);
+
+    void
+    do_start_pass(GC_Generation gc_limit);
+
+    size_t
+    do_collect_incremental(size_t limit, uint64_t deadline);
+
   public:
+    // Hooks are notified about garbage collection. `Global_Context` shares its hooks with
+    // its collector.
+    ASTERIA_INCOMPLET(Abstract_Hooks)
+    rcptr<Abstract_Hooks>
+    get_hooks_opt()
+    const noexcept
+      { return unerase_cast<Abstract_Hooks>(this->m_qhooks);  }
+
+    ASTERIA_INCOMPLET(Abstract_Hooks)
+    Genius_Collector&
+    set_hooks(rcptr<Abstract_Hooks> hooks_opt)
+    noexcept
+      { return this->m_qhooks = ::std::move(hooks_opt), *this;  }
+
     size_t
     get_pool_size()
     const noexcept
@@ -65,6 +101,33 @@ final
     size_t
     collect_variables(GC_Generation gc_limit = gc_generation_oldest);
 
+    // If the slice is non-zero, garbage collection that is triggered by creation of
+    // variables is incremental, and performs at most this number of steps at a time.
+    uint32_t
+    get_incremental_slice()
+    const noexcept
+      { return this->m_slice;  }
+
+    Genius_Collector&
+    set_incremental_slice(uint32_t slice)
+    noexcept
+      { return this->m_slice = slice, *this;  }
+
+    bool
+    is_cycle_in_progress()
+    const
+      { return this->get_collector(this->m_incr_gen).is_cycle_in_progress();  }
+
+    // These functions collect variables incrementally from the newest generation to
+    // `gc_limit`, resuming the cycle in progress if any, and return the number of
+    // variables that have been collected. They return early if all generations have
+    // been collected.
+    size_t
+    collect_steps(size_t nsteps, GC_Generation gc_limit = gc_generation_oldest);
+
+    size_t
+    collect_for(uint32_t usecs, GC_Generation gc_limit = gc_generation_oldest);
+
     Genius_Collector&
     wipe_out_variables()
     noexcept;
@@ -6,6 +6,7 @@
 #include "genius_collector.hpp"
 #include "random_engine.hpp"
 #include "loader_lock.hpp"
+#include "module_cache.hpp"
 #include "variable.hpp"
 #include "abstract_hooks.hpp"
 #include "../library/version.hpp"
@@ -21,6 +22,7 @@
 #include "../library/json.hpp"
 #include "../library/io.hpp"
 #include "../utilities.hpp"
+#include <ucontext.h>  // ::getcontext(), ::makecontext(), ::swapcontext()
 
 namespace Asteria {
 namespace {
@@ -69,14 +71,64 @@ struct Module_Comparator
       { return lhs.version < rhs;  }
   };
 
+struct Segment_Call
+  {
+    void (*callback)(void*);
+    void* param;
+    ::std::exception_ptr except;
+    ::ucontext_t caller;
+  };
+
+// `makecontext()` can only pass `int` arguments, so the call is passed here.
+thread_local Segment_Call* s_segment_call;
+
+void
+do_segment_entry()
+  {
+    auto call = s_segment_call;
+    // Exceptions must not be propagated across stacks. Rethrow it on the caller's stack.
+    try {
+      call->callback(call->param);
+    }
+    catch(...) {
+      call->except = ::std::current_exception();
+    }
+    // Return to `call->caller` through `uc_link`.
+  }
+
 }  // namespace
 
+uint32_t
+Global_Context::
+do_get_default_jit_threshold()
+noexcept
+  {
+    // This allows running existent programs with different thresholds.
+    // Invalid values are ignored.
+    const char* str = ::getenv("ASTERIA_JIT_THRESHOLD");
+    if(str && *str) {
+      char* ep;
+      unsigned long val = ::strtoul(str, &ep, 10);
+      if((*ep == 0) && (val <= UINT32_MAX))
+        return static_cast<uint32_t>(val);
+    }
+    // Native code is opt-in. It only removes the dispatch loop, which gains a few percent
+    // at best.
+    return 0;
+  }
+
 Global_Context::
 ~Global_Context()
   {
     auto gcoll = unerase_cast(this->m_gcoll);
     ROCKET_ASSERT(gcoll);
     gcoll->wipe_out_variables();
+
+    // Free all spare stack segments.
+    while(auto qseg = this->m_heap_stack_pool) {
+      this->m_heap_stack_pool = *static_cast<void**>(qseg);
+      ::operator delete(qseg);
+    }
   }
 
 API_Version
@@ -88,6 +140,65 @@ noexcept
     return static_cast<API_Version>(api_version_sentinel - 1);
   }
 
+Global_Context&
+Global_Context::
+call_on_heap_stack(void callback(void*), void* param)
+  {
+    // Make the call in place if the limit would be exceeded.
+    if(this->m_heap_stack_limit - this->m_heap_stack_used < heap_stack_segment_size) {
+      callback(param);
+      return *this;
+    }
+
+    // Get a segment, reusing a spare one if any.
+    auto qseg = this->m_heap_stack_pool;
+    if(qseg)
+      this->m_heap_stack_pool = *static_cast<void**>(qseg);
+    else
+      qseg = ::operator new(heap_stack_segment_size);
+
+    // Stacks grow downwards, so the recursion base is the end of the segment.
+    auto base = this->m_sentry.get_base();
+    this->m_sentry.set_base(static_cast<char*>(qseg) + heap_stack_segment_size);
+    this->m_heap_stack_used += heap_stack_segment_size;
+
+    Segment_Call call = { callback, param, nullptr, { } };
+    ::ucontext_t callee;
+    ::getcontext(&callee);
+    callee.uc_stack.ss_sp = qseg;
+    callee.uc_stack.ss_size = heap_stack_segment_size;
+    callee.uc_link = &(call.caller);
+    ::makecontext(&callee, do_segment_entry, 0);
+
+    // Switch to the segment, which returns here after `callback(param)` returns.
+    s_segment_call = &call;
+    int err = ::swapcontext(&(call.caller), &callee);
+
+    // Put the segment back.
+    this->m_heap_stack_used -= heap_stack_segment_size;
+    this->m_sentry.set_base(base);
+    *static_cast<void**>(qseg) = this->m_heap_stack_pool;
+    this->m_heap_stack_pool = qseg;
+
+    if(err != 0)
+      ASTERIA_THROW("could not switch stacks (errno `$1`)", errno);
+
+    if(call.except)
+      ::std::rethrow_exception(call.except);
+    return *this;
+  }
+
+Global_Context&
+Global_Context::
+set_hooks(rcptr<Abstract_Hooks> hooks_opt)
+noexcept
+  {
+    if(auto gcoll = unerase_cast(this->m_gcoll))
+      gcoll->set_hooks(hooks_opt);
+    this->m_qhooks = ::std::move(hooks_opt);
+    return *this;
+  }
+
 void
 Global_Context::
 initialize(API_Version version)
@@ -128,6 +239,12 @@ initialize(API_Version version)
       ldrlk = ::rocket::make_refcnt<Loader_Lock>();
     this->m_ldrlk = ldrlk;
 
+    // Initialize the cache of imported modules.
+    auto modcache = unerase_cast(this->m_modcache);
+    if(!modcache)
+      modcache = ::rocket::make_refcnt<Module_Cache>();
+    this->m_modcache = modcache;
+
     // Initialize standard library modules.
 #ifdef ROCKET_DEBUG
     ROCKET_ASSERT(::std::is_sorted(begin(s_modules), end(s_modules), Module_Comparator()));
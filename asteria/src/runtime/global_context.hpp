@@ -13,15 +13,35 @@ namespace Asteria {
 class Global_Context
   : public Abstract_Context
   {
+  public:
+    enum : size_t { heap_stack_segment_size = size_t(1) << (Recursion_Sentry::stack_mask_bits + 1)  };  // 1MiB
+
+    // These limit spare storage of evaluation stacks and function contexts.
+    enum : size_t
+      {
+        storage_pool_max_count     =  64,  // number of spare stacks or dictionaries
+        storage_pool_max_capacity  = 256,  // number of references in each of them
+      };
+
   private:
     Recursion_Sentry m_sentry;
+    size_t m_heap_stack_limit = 0;
+    size_t m_heap_stack_used = 0;  // total size of segments in use
+    void* m_heap_stack_pool = nullptr;  // singly linked list of spare segments
+    uint32_t m_jit_threshold = do_get_default_jit_threshold();
+    bool m_node_stats = false;
+    size_t m_slot_misses = 0;
 
     rcfwdp<Abstract_Hooks> m_qhooks;
     rcfwdp<Genius_Collector> m_gcoll;
     rcfwdp<Random_Engine> m_prng;
     rcfwdp<Loader_Lock> m_ldrlk;
+    rcfwdp<Module_Cache> m_modcache;
     rcfwdp<Variable> m_vstd;
 
+    cow_vector<cow_vector<Reference>> m_stack_pool;  // spare storage for evaluation stacks
+    cow_vector<Reference_Dictionary> m_dict_pool;  // spare storage for function contexts
+
   public:
     explicit
     Global_Context(API_Version version = api_version_latest)
@@ -32,6 +52,12 @@ class Global_Context
 
     ASTERIA_DECLARE_NONCOPYABLE(Global_Context);
 
+  private:
+    static
+    uint32_t
+    do_get_default_jit_threshold()
+    noexcept;
+
   protected:
     bool
     do_is_analytic()
@@ -75,18 +101,143 @@ class Global_Context
     noexcept
       { return this->m_sentry.set_base(base), *this;  }
 
+    // Calls that are about to exhaust the native stack can be made on heap-allocated stack
+    // segments, so deep recursion is limited by the total size of them instead.
+    // This limit is zero by default, which disables such segments.
+    size_t
+    get_heap_stack_limit()
+    const noexcept
+      { return this->m_heap_stack_limit;  }
+
+    Global_Context&
+    set_heap_stack_limit(size_t limit)
+    noexcept
+      { return this->m_heap_stack_limit = limit, *this;  }
+
+    // Code that has been executed this many times is compiled into native code, if
+    // this is supported by the target. A value of zero disables generation of native code,
+    // which is the default. The default value can be overridden by the environment
+    // variable `ASTERIA_JIT_THRESHOLD`.
+    uint32_t
+    get_jit_threshold()
+    const noexcept
+      { return this->m_jit_threshold;  }
+
+    Global_Context&
+    set_jit_threshold(uint32_t threshold)
+    noexcept
+      { return this->m_jit_threshold = threshold, *this;  }
+
+    // If this is set, statistics of nodes are collected, which can be printed by
+    // `AVMC_Queue::print_statistics()`. This slows execution down significantly.
+    // Native code is not used meanwhile.
+    bool
+    is_node_statistics_enabled()
+    const noexcept
+      { return this->m_node_stats;  }
+
+    Global_Context&
+    enable_node_statistics(bool enable)
+    noexcept
+      { return this->m_node_stats = enable, *this;  }
+
+    // Slots of local references are resolved at compile time. This counts lookups whose
+    // slots turned out stale at runtime, which had to look names up instead.
+    size_t
+    count_slot_misses()
+    const noexcept
+      { return this->m_slot_misses;  }
+
+    Global_Context&
+    note_slot_miss()
+    noexcept
+      { return this->m_slot_misses++, *this;  }
+
+    // Check whether the current stack is running out, leaving some room for native functions.
+    bool
+    is_stack_low()
+    const noexcept
+      {
+        const char probe = 0;
+        size_t usage = static_cast<size_t>(::std::abs(&probe
+                                                      - static_cast<const char*>(this->m_sentry.get_base())));
+        size_t limit = size_t(1) << Recursion_Sentry::stack_mask_bits;
+        return usage >= limit - limit / 8;
+      }
+
+    // Call `callback(param)` on a new stack segment. If the limit has been reached,
+    // `callback(param)` is called in place, where the recursion sentry will throw an
+    // exception eventually.
+    Global_Context&
+    call_on_heap_stack(void callback(void*), void* param);
+
+    // These are used to reuse storage of evaluation stacks across function calls.
+    // Each active call takes a segment from the pool. As calls are nested, segments are
+    // returned in reverse order. After deep recursion, only the first few segments are
+    // retained, and large ones are deallocated, so the pool has a bounded size.
+    cow_vector<Reference>
+    acquire_stack_storage()
+      {
+        cow_vector<Reference> refs;
+        if(ROCKET_EXPECT(!this->m_stack_pool.empty())) {
+          refs.swap(this->m_stack_pool.mut_back());
+          this->m_stack_pool.pop_back();
+        }
+        return refs;
+      }
+
+    Global_Context&
+    release_stack_storage(cow_vector<Reference>&& refs)
+      {
+        // Destroy references, which may keep values alive, but retain the storage.
+        refs.clear();
+        if((this->m_stack_pool.size() < storage_pool_max_count) && (refs.capacity() <= storage_pool_max_capacity))
+          this->m_stack_pool.emplace_back(::std::move(refs));
+        return *this;
+      }
+
+    // These are used to reuse storage of named references of function contexts, in the
+    // same way as above.
+    Reference_Dictionary
+    acquire_dictionary_storage()
+      {
+        Reference_Dictionary dict;
+        if(ROCKET_EXPECT(!this->m_dict_pool.empty())) {
+          dict.swap(this->m_dict_pool.mut_back());
+          this->m_dict_pool.pop_back();
+        }
+        return dict;
+      }
+
+    Global_Context&
+    release_dictionary_storage(Reference_Dictionary&& dict)
+      {
+        // Destroy references, which may keep values alive, but retain the storage.
+        // The load factor of a dictionary is kept below 0.5.
+        dict.clear();
+        if((this->m_dict_pool.size() < storage_pool_max_count) && (dict.bucket_count() <= storage_pool_max_capacity * 2))
+          this->m_dict_pool.emplace_back(::std::move(dict));
+        return *this;
+      }
+
     // This helps debugging and profiling.
+    // `has_hooks()` is a plain load, which should be checked before `get_hooks_opt()` on hot
+    // paths, as the latter copies a reference-counted pointer.
+    bool
+    has_hooks()
+    const noexcept
+      { return !!(this->m_qhooks);  }
+
     ASTERIA_INCOMPLET(Abstract_Hooks)
     rcptr<Abstract_Hooks>
     get_hooks_opt()
     const noexcept
       { return unerase_cast<Abstract_Hooks>(this->m_qhooks);  }
 
-    ASTERIA_INCOMPLET(Abstract_Hooks)
+    // Hooks are shared with the garbage collector.
     Global_Context&
     set_hooks(rcptr<Abstract_Hooks> hooks_opt)
-    noexcept
-      { return this->m_qhooks = ::std::move(hooks_opt), *this;  }
+    noexcept;
 
     // These are interfaces for individual global components.
     ASTERIA_INCOMPLET(Genius_Collector)
@@ -107,6 +258,12 @@ class Global_Context
     const noexcept
       { return unerase_cast<Loader_Lock>(this->m_ldrlk);  }
 
+    ASTERIA_INCOMPLET(Module_Cache)
+    rcptr<Module_Cache>
+    module_cache()
+    const noexcept
+      { return unerase_cast<Module_Cache>(this->m_modcache);  }
+
     ASTERIA_INCOMPLET(Variable)
     rcptr<Variable>
     std_variable()
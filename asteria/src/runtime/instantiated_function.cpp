@@ -8,21 +8,72 @@
 #include "global_context.hpp"
 #include "runtime_error.hpp"
 #include "ptc_arguments.hpp"
+#include "variable_callback.hpp"
+#include "sampling_profiler.hpp"
 #include "../utilities.hpp"
 
 namespace Asteria {
+namespace {
+
+void
+do_release_storage(Global_Context& global, Evaluation_Stack& stack, Executive_Context& ctx)
+  {
+    cow_vector<Reference> refs;
+    stack.unreserve(refs);
+    global.release_stack_storage(::std::move(refs));
+
+    Reference_Dictionary dict;
+    ctx.swap_named_references(dict);
+    global.release_dictionary_storage(::std::move(dict));
+  }
+
+}  // namespace
+
+Function_Template::
+~Function_Template()
+  {
+  }
+
+void
+Function_Template::
+do_solidify()
+const
+  {
+    // Solidify the body into a temporary queue, so nothing is left in an inconsistent
+    // state if an exception is thrown.
+    AVMC_Queue queue;
+    AIR_Node::solidify_code(queue, this->m_code);
+    queue.shrink_to_fit();
+
+    this->m_queue = ::std::move(queue);
+    this->m_solid = true;
+  }
+
+Variable_Callback&
+Function_Template::
+enumerate_variables(Variable_Callback& callback)
+const
+  {
+    // Only nodes are enumerated. The queue is a copy of them.
+    ::rocket::for_each(this->m_code, callback);
+    return callback;
+  }
 
 Instantiated_Function::
 ~Instantiated_Function()
   {
   }
 
-void
+const Reference*
 Instantiated_Function::
-do_solidify(const cow_vector<AIR_Node>& code)
+get_capture_opt(uint32_t depth, const phsh_string& name)
+const noexcept
   {
-    ::rocket::all_of(code, [&](const AIR_Node& node) { return node.solidify(this->m_queue);  });
-    this->m_queue.shrink_to_fit();
+    const auto& captures = this->m_templ->get_captures();
+    for(size_t i = 0;  i < captures.size();  ++i)
+      if((captures[i].depth == depth) && (captures[i].name == name))
+        return this->m_captures[i].is_void() ? nullptr : &(this->m_captures[i]);
+    return nullptr;
   }
 
 tinyfmt&
@@ -30,7 +81,8 @@ Instantiated_Function::
 describe(tinyfmt& fmt)
 const
   {
-    return fmt << this->m_zvarg->func() << " @ " << this->m_zvarg->sloc();
+    const auto& zvarg = this->m_templ->get_zvarg();
+    return fmt << zvarg->func() << " @ " << zvarg->sloc();
   }
 
 Variable_Callback&
@@ -38,7 +90,9 @@ Instantiated_Function::
 enumerate_variables(Variable_Callback& callback)
 const
   {
-    return this->m_queue.enumerate_variables(callback);
+    // The template is not enumerated, as it is shared by all instances.
+    ::rocket::for_each(this->m_captures, callback);
+    return callback;
   }
 
 Reference&
@@ -47,20 +101,34 @@ invoke_ptc_aware(Reference& self, Global_Context& global, cow_vector<Reference>&
 const
   {
     // Create the stack and context for this function.
+    // Parameters are bound by position, by moving arguments into fixed slots of the
+    // context, whose storage is taken from the pool in `global`. Afterwards `args` holds
+    // variadic arguments only. If there are none, its storage, which was taken from the
+    // pool by the caller, is reused for the stack. The storage of the stack and named
+    // references is returned to the pool when the body returns or throws an exception,
+    // so calls don't allocate memory in general. If binding parameters fails, it is
+    // simply deallocated.
+    const auto& queue = this->m_templ->get_queue();
+    const auto& zvarg = this->m_templ->get_zvarg();
+    Sampling_Profiler::Frame_Guard pframe(*zvarg);
     Evaluation_Stack stack;
     Executive_Context ctx_func(::rocket::ref(global), ::rocket::ref(stack),
-                               this->m_zvarg, this->m_params,
+                               this, zvarg, this->m_templ->get_params(),
                                ::std::move(self), ::std::move(args));
-    stack.reserve(::std::move(args));
+    if(ROCKET_EXPECT(args.empty() && args.unique()))
+      stack.reserve(::std::move(args));
+    else
+      stack.reserve(global.acquire_stack_storage());
 
     // Execute the function body.
     AIR_Status status;
     ASTERIA_RUNTIME_TRY {
-      status = this->m_queue.execute(ctx_func);
+      status = queue.execute(ctx_func);
     }
     ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
       ctx_func.on_scope_exit(except);
-      except.push_frame_func(this->m_zvarg->sloc(), this->m_zvarg->func());
+      except.push_frame_func(zvarg->sloc(), zvarg->func());
+      do_release_storage(global, stack, ctx_func);
       throw;
     }
     ctx_func.on_scope_exit(status);
@@ -79,7 +147,7 @@ const
         // In case of PTCs, set up source location.
         // This cannot be set at the call site where such information isn't available.
         if(auto tca = self.get_tail_call_opt())
-          tca->set_enclosing_function(this->m_zvarg->sloc(), this->m_zvarg->func());
+          tca->set_enclosing_function(zvarg->sloc(), zvarg->func());
         break;
 
       case air_status_break_unspec:
@@ -97,8 +165,8 @@ const
         ASTERIA_TERMINATE("invalid AIR status code (status `$1`)", status);
     }
 
-    // Enable `args` to be reused after this call.
-    stack.unreserve(args);
+    // Return the storage of the stack to the pool.
+    do_release_storage(global, stack, ctx_func);
     return self;
   }
 
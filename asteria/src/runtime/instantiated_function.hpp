@@ -6,32 +6,105 @@
 
 #include "../fwd.hpp"
 #include "variadic_arguer.hpp"
+#include "air_node.hpp"
 #include "../llds/avmc_queue.hpp"
 
 namespace Asteria {
 
-class Instantiated_Function
+// This is the immutable part of a function, which is shared by all closures that are
+// created from the same definition.
+class Function_Template
 final
-  : public Abstract_Function
+  : public Rcfwd<Function_Template>
   {
   private:
     cow_vector<phsh_string> m_params;
     rcptr<Variadic_Arguer> m_zvarg;
-    AVMC_Queue m_queue;
+    cow_vector<AIR_Node> m_code;
+    cow_vector<AIR_Node::S_push_local_reference> m_captures;
+
+    // The body is solidified when it is called for the first time.
+    mutable AVMC_Queue m_queue;
+    mutable bool m_solid = false;
 
   public:
-    Instantiated_Function(const cow_vector<phsh_string>& params, rcptr<Variadic_Arguer>&& zvarg,
-                          const cow_vector<AIR_Node>& code)
-      : m_params(params), m_zvarg(::std::move(zvarg))
-      { this->do_solidify(code);  }
+    Function_Template(const cow_vector<phsh_string>& params, rcptr<Variadic_Arguer>&& zvarg,
+                      const cow_vector<AIR_Node>& code,
+                      const cow_vector<AIR_Node::S_push_local_reference>& captures)
+      : m_params(params), m_zvarg(::std::move(zvarg)),
+        m_code(code), m_captures(captures)
+      { }
 
-    ~Instantiated_Function()
+    ~Function_Template()
     override;
 
+    ASTERIA_DECLARE_NONCOPYABLE(Function_Template);
+
   private:
-    void do_solidify(const cow_vector<AIR_Node>& code);
+    void
+    do_solidify()
+    const;
 
   public:
+    const cow_vector<phsh_string>&
+    get_params()
+    const noexcept
+      { return this->m_params;  }
+
+    const rcptr<Variadic_Arguer>&
+    get_zvarg()
+    const noexcept
+      { return this->m_zvarg;  }
+
+    // Each capture is described by the number of contexts to go up from the function
+    // context (which is at least one), the slot hint and the name.
+    const cow_vector<AIR_Node::S_push_local_reference>&
+    get_captures()
+    const noexcept
+      { return this->m_captures;  }
+
+    const AVMC_Queue&
+    get_queue()
+    const
+      {
+        if(ROCKET_UNEXPECT(!this->m_solid))
+          this->do_solidify();
+        return this->m_queue;
+      }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const;
+  };
+
+class Instantiated_Function
+final
+  : public Abstract_Function
+  {
+  private:
+    rcptr<Function_Template> m_templ;
+    cow_vector<Reference> m_captures;
+
+  public:
+    Instantiated_Function(const rcptr<Function_Template>& templ, cow_vector<Reference>&& captures)
+      : m_templ(templ), m_captures(::std::move(captures))
+      { }
+
+    ~Instantiated_Function()
+    override;
+
+  public:
+    const Reference&
+    get_capture(size_t index)
+    const
+      { return this->m_captures.at(index);  }
+
+    // Get a captured reference by its depth and name, if it has been captured and
+    // initialized.
+    const Reference*
+    get_capture_opt(uint32_t depth, const phsh_string& name)
+    const noexcept;
+
     tinyfmt&
     describe(tinyfmt& fmt)
     const override;
@@ -0,0 +1,108 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "module_cache.hpp"
+#include "../utilities.hpp"
+#include <sys/stat.h>
+
+namespace Asteria {
+namespace {
+
+inline
+bool
+do_stamps_equal(const Module_Cache::Stamp& lhs, const Module_Cache::Stamp& rhs)
+noexcept
+  {
+    return (lhs.dev == rhs.dev) && (lhs.ino == rhs.ino) &&
+           (lhs.mtime_sec == rhs.mtime_sec) && (lhs.mtime_nsec == rhs.mtime_nsec);
+  }
+
+inline
+bool
+do_options_equal(const Compiler_Options& lhs, const Compiler_Options& rhs)
+noexcept
+  {
+    // All members are single bytes, so there is no padding.
+    static_assert(::std::is_trivially_copyable<Compiler_Options>::value);
+    return ::std::memcmp(&lhs, &rhs, sizeof(Compiler_Options)) == 0;
+  }
+
+}  // namespace
+
+Module_Cache::
+~Module_Cache()
+  {
+  }
+
+Module_Cache::Stamp
+Module_Cache::
+get_stamp(::FILE* fp)
+  {
+    struct ::stat info;
+    if(::fstat(::fileno(fp), &info) != 0)
+      ASTERIA_THROW_SYSTEM_ERROR("fstat");
+
+    Stamp stamp;
+    stamp.dev = static_cast<uint64_t>(info.st_dev);
+    stamp.ino = static_cast<uint64_t>(info.st_ino);
+    stamp.mtime_sec = static_cast<int64_t>(info.st_mtim.tv_sec);
+    stamp.mtime_nsec = static_cast<int64_t>(info.st_mtim.tv_nsec);
+    return stamp;
+  }
+
+cow_function
+Module_Cache::
+get_opt(const cow_string& path, const Stamp& stamp, const Compiler_Options& opts)
+const
+  {
+    auto qents = this->m_entries.get_ptr(phsh_string(path));
+    if(!qents)
+      return nullptr;
+
+    // There is usually only one entry for each file.
+    for(const auto& ent : *qents)
+      if(do_options_equal(ent.opts, opts))
+        return do_stamps_equal(ent.stamp, stamp) ? ent.func : nullptr;
+    return nullptr;
+  }
+
+Module_Cache&
+Module_Cache::
+insert(const cow_string& path, const Stamp& stamp, const Compiler_Options& opts,
+       const cow_function& func)
+  {
+    auto& ents = this->m_entries.try_emplace(phsh_string(path)).first->second;
+
+    // Replace the function that has been compiled with the same options.
+    for(size_t i = 0;  i < ents.size();  ++i) {
+      if(!do_options_equal(ents[i].opts, opts))
+        continue;
+      auto& ent = ents.mut(i);
+      ent.stamp = stamp;
+      ent.func = func;
+      return *this;
+    }
+
+    // Add a new entry.
+    Entry ent = { stamp, opts, func };
+    ents.emplace_back(::std::move(ent));
+    this->m_count++;
+    return *this;
+  }
+
+size_t
+Module_Cache::
+invalidate(const cow_string& path)
+  {
+    auto qents = this->m_entries.get_ptr(phsh_string(path));
+    if(!qents)
+      return 0;
+
+    size_t count = qents->size();
+    this->m_entries.erase(phsh_string(path));
+    this->m_count -= count;
+    return count;
+  }
+
+}  // namespace Asteria
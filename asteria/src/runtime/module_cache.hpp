@@ -0,0 +1,92 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_MODULE_CACHE_HPP_
+#define ASTERIA_RUNTIME_MODULE_CACHE_HPP_
+
+#include "../fwd.hpp"
+
+namespace Asteria {
+
+// This caches functions that have been compiled from script files by `import()`.
+// A function is reused only if its file has the same absolute path, device ID,
+// inode number and modification time, and is compiled with the same options.
+// Files that are modified in place within the resolution of modification times
+// can't be told apart, so hosts that need to reload such files should invalidate
+// them explicitly.
+class Module_Cache
+final
+  : public Rcfwd<Module_Cache>
+  {
+  public:
+    // This identifies a specific version of a file.
+    struct Stamp
+      {
+        uint64_t dev;
+        uint64_t ino;
+        int64_t mtime_sec;
+        int64_t mtime_nsec;
+      };
+
+  private:
+    struct Entry
+      {
+        Stamp stamp;
+        Compiler_Options opts;
+        cow_function func;
+      };
+
+    cow_dictionary<cow_vector<Entry>> m_entries;
+    size_t m_count = 0;
+
+  public:
+    Module_Cache()
+    noexcept
+      = default;
+
+    ~Module_Cache()
+    override;
+
+    ASTERIA_DECLARE_NONCOPYABLE(Module_Cache);
+
+  public:
+    // Get the stamp of an open file.
+    static
+    Stamp
+    get_stamp(::FILE* fp);
+
+    bool
+    empty()
+    const noexcept
+      { return this->m_count == 0;  }
+
+    size_t
+    size()
+    const noexcept
+      { return this->m_count;  }
+
+    Module_Cache&
+    clear()
+    noexcept
+      { return this->m_entries.clear(), this->m_count = 0, *this;  }
+
+    // Look for a function that has been compiled from `path`. If no such function
+    // exists, or the file has been changed, a null pointer is returned.
+    cow_function
+    get_opt(const cow_string& path, const Stamp& stamp, const Compiler_Options& opts)
+    const;
+
+    // Add a function, replacing the one for the same file and options, if any.
+    Module_Cache&
+    insert(const cow_string& path, const Stamp& stamp, const Compiler_Options& opts,
+           const cow_function& func);
+
+    // Remove all functions that have been compiled from `path`.
+    // The return value is the number of functions that have been removed.
+    size_t
+    invalidate(const cow_string& path);
+  };
+
+}  // namespace Asteria
+
+#endif
@@ -0,0 +1,44 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "native_binding.hpp"
+#include "../utilities.hpp"
+
+namespace Asteria {
+
+Native_Binding_Base::
+~Native_Binding_Base()
+  {
+  }
+
+void
+Native_Binding_Base::
+do_throw_no_matching_function_call(const cow_vector<Reference>& args,
+                                   void (*const* records)(Argument_Reader&), size_t nrecords)
+const
+  {
+    // Replay all overloads, so the message is the same as other functions.
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref(this->m_name));
+    for(size_t k = 0;  k != nrecords;  ++k)
+      records[k](reader);
+    reader.throw_no_matching_function_call();
+  }
+
+tinyfmt&
+Native_Binding_Base::
+describe(tinyfmt& fmt)
+const
+  {
+    return format(fmt, "$1\n[native function at $2]", this->m_desc, (const void*)this);
+  }
+
+Variable_Callback&
+Native_Binding_Base::
+enumerate_variables(Variable_Callback& callback)
+const
+  {
+    return callback;
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,349 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_NATIVE_BINDING_HPP_
+#define ASTERIA_RUNTIME_NATIVE_BINDING_HPP_
+
+#include "../fwd.hpp"
+#include "reference.hpp"
+#include "argument_reader.hpp"
+#include "../value.hpp"
+
+namespace Asteria {
+
+// These describe how arguments are passed to native functions.
+// `check()` tells whether an argument is acceptable, where a null pointer denotes an
+// absent argument. `get()` converts an acceptable argument to the parameter. `record()`
+// describes the parameter to an `Argument_Reader`, which is only used to compose error
+// messages.
+// Because `optV_opaque` and `optV_function` are aliases of `V_opaque` and `V_function`,
+// optional opaques and functions are specified as `opt<V_opaque>` and `opt<V_function>`.
+// `Global_Context&` takes no argument.
+template<typename SpecT>
+struct Native_Param;
+
+#define ASTERIA_NATIVE_PARAM_REQUIRED_(V, is_X, as_X)  \
+  template<>  \
+  struct Native_Param<V>  \
+    {  \
+      using type = V;  \
+      enum : bool { consumes = true, optional = false };  \
+      \
+      static  \
+      bool  \
+      check(const Reference* qarg)  \
+        { return qarg && qarg->read().is_X();  }  \
+      \
+      static  \
+      type  \
+      get(const Reference* qarg, Global_Context& /*global*/)  \
+        { return qarg->read().as_X();  }  \
+      \
+      static  \
+      void  \
+      record(Argument_Reader& reader)  \
+        {  \
+          V xval;  \
+          reader.v(xval);  \
+        }  \
+    }
+
+#define ASTERIA_NATIVE_PARAM_OPTIONAL_(V, O, is_X, as_X)  \
+  template<>  \
+  struct Native_Param<O>  \
+    {  \
+      using type = V;  \
+      enum : bool { consumes = true, optional = true };  \
+      \
+      static  \
+      bool  \
+      check(const Reference* qarg)  \
+        { return !qarg || qarg->read().is_null() || qarg->read().is_X();  }  \
+      \
+      static  \
+      type  \
+      get(const Reference* qarg, Global_Context& /*global*/)  \
+        {  \
+          if(!qarg || qarg->read().is_null())  \
+            return type();  \
+          return qarg->read().as_X();  \
+        }  \
+      \
+      static  \
+      void  \
+      record(Argument_Reader& reader)  \
+        {  \
+          V xopt;  \
+          reader.o(xopt);  \
+        }  \
+    }
+
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_boolean, is_boolean, as_boolean);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_integer, is_integer, as_integer);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_real, is_convertible_to_real, convert_to_real);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_string, is_string, as_string);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_opaque, is_opaque, as_opaque);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_function, is_function, as_function);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_array, is_array, as_array);
+ASTERIA_NATIVE_PARAM_REQUIRED_(V_object, is_object, as_object);
+
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_boolean, optV_boolean, is_boolean, as_boolean);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_integer, optV_integer, is_integer, as_integer);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_real, optV_real, is_convertible_to_real, convert_to_real);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_string, optV_string, is_string, as_string);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_opaque, opt<V_opaque>, is_opaque, as_opaque);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_function, opt<V_function>, is_function, as_function);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_array, optV_array, is_array, as_array);
+ASTERIA_NATIVE_PARAM_OPTIONAL_(optV_object, optV_object, is_object, as_object);
+
+#undef ASTERIA_NATIVE_PARAM_REQUIRED_
+#undef ASTERIA_NATIVE_PARAM_OPTIONAL_
+
+template<>
+struct Native_Param<Value>
+  {
+    using type = Value;
+    enum : bool { consumes = true, optional = true };
+
+    static
+    bool
+    check(const Reference* /*qarg*/)
+      { return true;  }
+
+    static
+    type
+    get(const Reference* qarg, Global_Context& /*global*/)
+      { return qarg ? qarg->read() : V_null();  }
+
+    static
+    void
+    record(Argument_Reader& reader)
+      {
+        Value val;
+        reader.o(val);
+      }
+  };
+
+template<>
+struct Native_Param<Global_Context&>
+  {
+    using type = Global_Context&;
+    enum : bool { consumes = false, optional = true };
+
+    static
+    bool
+    check(const Reference* /*qarg*/)
+      { return true;  }
+
+    static
+    type
+    get(const Reference* /*qarg*/, Global_Context& global)
+      { return global;  }
+
+    static
+    void
+    record(Argument_Reader& /*reader*/)
+      { }
+  };
+
+// This is a single overload of a native function, which takes parameters as specified
+// by `SpecsT` and returns `ResultT`. `targetT` may name an overload set, such as in
+// `Native_Overload<V_real, V_real>::Target<std_numeric_abs>`, where the one whose
+// parameters match is selected.
+template<typename ResultT, typename... SpecsT>
+struct Native_Overload
+  {
+    using target_type = ResultT (typename Native_Param<SpecsT>::type...);
+
+    // Get the index of the argument for the parameter at `pos`, and the numbers of
+    // arguments that are accepted.
+    static constexpr
+    size_t
+    arg_index(size_t pos)
+      {
+        const bool consumes[] = { Native_Param<SpecsT>::consumes..., false };
+        size_t index = 0;
+        for(size_t k = 0;  k < pos;  ++k)
+          index += consumes[k];
+        return index;
+      }
+
+    static constexpr
+    size_t
+    min_args()
+      {
+        const bool consumes[] = { Native_Param<SpecsT>::consumes..., false };
+        const bool optional[] = { Native_Param<SpecsT>::optional..., true };
+        size_t count = 0;
+        for(size_t k = 0;  k < sizeof...(SpecsT);  ++k)
+          if(consumes[k] && !optional[k])
+            count = arg_index(k) + 1;
+        return count;
+      }
+
+    static constexpr
+    size_t
+    max_args()
+      { return arg_index(sizeof...(SpecsT));  }
+
+    template<target_type* targetT>
+    struct Target
+      {
+        template<typename... ParamsT>
+        static
+        void
+        do_call(Reference& self, ::std::true_type /*void*/, ParamsT&&... params)
+          {
+            targetT(::std::forward<ParamsT>(params)...);
+            self = Reference_root::S_void();
+          }
+
+        template<typename... ParamsT>
+        static
+        void
+        do_call(Reference& self, ::std::false_type /*void*/, ParamsT&&... params)
+          {
+            Reference_root::S_temporary xref = { targetT(::std::forward<ParamsT>(params)...) };
+            self = ::std::move(xref);
+          }
+
+        template<size_t... indicesT>
+        static
+        bool
+        do_try_invoke(Reference& self, Global_Context& global, const cow_vector<Reference>& args,
+                      index_sequence<indicesT...>)
+          {
+            // Check all arguments before converting any of them.
+            const bool ok[] = { Native_Param<SpecsT>::check(args.get_ptr(
+                                    ::std::integral_constant<size_t, arg_index(indicesT)>::value))..., true };
+            for(size_t k = 0;  k < sizeof...(SpecsT);  ++k)
+              if(!ok[k])
+                return false;
+
+            // Call the target function with converted arguments.
+            static_cast<void>(global);
+            do_call(self, ::std::is_void<ResultT>(),
+                    Native_Param<SpecsT>::get(args.get_ptr(
+                        ::std::integral_constant<size_t, arg_index(indicesT)>::value), global)...);
+            return true;
+          }
+
+        // Try calling the target function. If the arguments don't match, `false` is
+        // returned and nothing is changed.
+        static
+        bool
+        try_invoke(Reference& self, Global_Context& global, const cow_vector<Reference>& args)
+          {
+            constexpr size_t nmin = min_args();
+            constexpr size_t nmax = max_args();
+            if((args.size() < nmin) || (args.size() > nmax))
+              return false;
+
+            return do_try_invoke(self, global, args, ::std::make_index_sequence<sizeof...(SpecsT)>());
+          }
+
+        static
+        void
+        record(Argument_Reader& reader)
+          {
+            reader.I();
+            // Record all parameters in order.
+            const int dummy[] = { (Native_Param<SpecsT>::record(reader), 1)..., 1 };
+            static_cast<void>(dummy);
+            reader.F();
+          }
+      };
+  };
+
+// This is the common part of all native bindings.
+class Native_Binding_Base
+  : public Abstract_Function
+  {
+  private:
+    const char* m_name;
+    const char* m_desc;
+
+  public:
+    Native_Binding_Base(const char* name, const char* desc)
+    noexcept
+      : m_name(name), m_desc(desc)
+      { }
+
+    ~Native_Binding_Base()
+    override;
+
+  protected:
+    [[noreturn]]
+    void
+    do_throw_no_matching_function_call(const cow_vector<Reference>& args,
+                                       void (*const* records)(Argument_Reader&), size_t nrecords)
+    const;
+
+  public:
+    const char*
+    name()
+    const noexcept
+      { return this->m_name;  }
+
+    const char*
+    description()
+    const noexcept
+      { return this->m_desc;  }
+
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override;
+  };
+
+// This is a native function whose arguments are checked and unpacked by code that is
+// generated at compile time. `OverloadsT` are instantiations of `Native_Overload::Target`,
+// which are tried in order. Arguments are inspected only once for each overload.
+template<typename... OverloadsT>
+class Native_Binding
+final
+  : public Native_Binding_Base
+  {
+  public:
+    Native_Binding(const char* name, const char* desc)
+    noexcept
+      : Native_Binding_Base(name, desc)
+      { }
+
+  public:
+    Reference&
+    invoke_ptc_aware(Reference& self, Global_Context& global, cow_vector<Reference>&& args)
+    const override
+      {
+        // Try overloads in order, until one of them succeeds.
+        bool found = false;
+        const int dummy[] = { (found = found || OverloadsT::try_invoke(self, global, args), 1)..., 1 };
+        static_cast<void>(dummy);
+        if(found)
+          return self;
+
+        // Fail.
+        static constexpr void (*const records[])(Argument_Reader&) = { OverloadsT::record... };
+        this->do_throw_no_matching_function_call(args, records, sizeof...(OverloadsT));
+      }
+  };
+
+// Create a function object for a native binding, e.g.
+//   bind_native<Native_Overload<V_integer, V_integer>::Target<std_numeric_abs>,
+//               Native_Overload<V_real, V_real>::Target<std_numeric_abs>>
+//     ("std.numeric.abs", "`std.numeric.abs(value)` ...")
+// `name` and `desc` shall have static storage duration.
+template<typename... OverloadsT>
+inline
+V_function
+bind_native(const char* name, const char* desc)
+  {
+    return ::rocket::make_refcnt<Native_Binding<OverloadsT...>>(name, desc);
+  }
+
+}  // namespace Asteria
+
+#endif
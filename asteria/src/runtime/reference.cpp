@@ -32,8 +32,8 @@ do_unpack_tail_calls(Reference& self, Global_Context& global)
       // Note that `self` is overwritten before the wrapped function is called.
       while(!!(tca = self.get_tail_call_opt())) {
         // Generate a single-step trap before unpacking arguments.
-        if(auto qhooks = global.get_hooks_opt())
-          qhooks->on_single_step_trap(tca->sloc());
+        if(ROCKET_UNEXPECT(global.has_hooks()))
+          global.get_hooks_opt()->on_single_step_trap(tca->sloc());
 
         // Get the `this` reference and all the other arguments.
         auto args = ::std::move(tca->open_arguments_and_self());
@@ -41,8 +41,8 @@ do_unpack_tail_calls(Reference& self, Global_Context& global)
         args.pop_back();
 
         // Call the hook function if any.
-        if(auto qhooks = global.get_hooks_opt())
-          qhooks->on_function_call(tca->sloc(), tca->get_target());
+        if(ROCKET_UNEXPECT(global.has_hooks()))
+          global.get_hooks_opt()->on_function_call(tca->sloc(), tca->get_target());
 
         // Figure out how to forward the result.
         if(tca->ptc_aware() == ptc_aware_void) {
@@ -71,8 +71,8 @@ do_unpack_tail_calls(Reference& self, Global_Context& global)
             .on_scope_exit(air_status_next);
 
         // Call the hook function if any.
-        if(auto qhooks = global.get_hooks_opt())
-          qhooks->on_function_return(tca->sloc(), tca->get_target(), self);
+        if(ROCKET_UNEXPECT(global.has_hooks()))
+          global.get_hooks_opt()->on_function_return(tca->sloc(), tca->get_target(), self);
       }
     }
     ASTERIA_RUNTIME_CATCH(Runtime_Error& except) {
@@ -86,8 +86,8 @@ do_unpack_tail_calls(Reference& self, Global_Context& global)
         except.push_frame_plain(tca->sloc(), ::rocket::sref("<proper tail call>"));
 
         // Call the hook function if any.
-        if(auto qhooks = global.get_hooks_opt())
-          qhooks->on_function_except(tca->sloc(), tca->get_target(), except);
+        if(ROCKET_UNEXPECT(global.has_hooks()))
+          global.get_hooks_opt()->on_function_except(tca->sloc(), tca->get_target(), except);
 
         // Evaluate deferred expressions if any.
         if(tca->get_defer_stack().size())
@@ -27,24 +27,47 @@ do_backtrace()
     ::std::rethrow_exception(eptr);
   }
   catch(Runtime_Error& nested) {
-    // Copy frames.
-    if(this->m_frames.empty())
-      this->m_frames = nested.m_frames;
-    else
-      this->m_frames.append(nested.m_frames.begin(), nested.m_frames.end());
+    // Copy frames. Our own frames will be displayed before them.
+    this->m_frames = nested.do_sort_frames();
+    if(!this->m_frames.empty())
+      this->m_chains.emplace_back(this->m_frames.size());
   }
   catch(::std::exception& /*nested*/) {
     // Do nothing.
   }
 
+const cow_vector<Backtrace_Frame>&
+Runtime_Error::
+do_sort_frames()
+const
+  {
+    // If there is only one backtrace, frames are in order of display.
+    if(ROCKET_EXPECT(this->m_chains.empty()))
+      return this->m_frames;
+
+    // Otherwise, backtraces are displayed in reverse order of recording.
+    if(this->m_sorted.empty()) {
+      cow_vector<Backtrace_Frame> sorted;
+      sorted.reserve(this->m_frames.size());
+      size_t epos = this->m_frames.size();
+      for(size_t k = this->m_chains.size();  k != 0;  --k) {
+        size_t bpos = this->m_chains[k-1];
+        sorted.append(this->m_frames.begin() + static_cast<ptrdiff_t>(bpos),
+                      this->m_frames.begin() + static_cast<ptrdiff_t>(epos));
+        epos = bpos;
+      }
+      sorted.append(this->m_frames.begin(), this->m_frames.begin() + static_cast<ptrdiff_t>(epos));
+      this->m_sorted = ::std::move(sorted);
+    }
+    return this->m_sorted;
+  }
+
 void
 Runtime_Error::
 do_compose_message()
-  {
-    // Reuse the storage if any.
+const noexcept
+  try {
     ::rocket::tinyfmt_str fmt;
-    fmt.set_string(::std::move(this->m_what));
-    fmt.clear_string();
 
     // Write the value. Strings are written as is. ALl other values are prettified.
     fmt << "asteria runtime error: ";
@@ -54,9 +77,10 @@ do_compose_message()
       fmt << this->m_value;
 
     // Append stack frames.
+    const auto& frames = this->do_sort_frames();
     fmt << "\n[backtrace frames:";
-    for(size_t i = 0;  i < this->m_frames.size();  ++i) {
-      const auto& frm = this->m_frames[i];
+    for(size_t i = 0;  i < frames.size();  ++i) {
+      const auto& frm = frames[i];
       format(fmt, "\n  #$1 $2 at '$3': $4", i, frm.what_type(), frm.sloc(), frm.value());
     }
     fmt << "\n  -- end of backtrace frames]";
@@ -64,5 +88,9 @@ do_compose_message()
     // Set the string.
     this->m_what = fmt.extract_string();
   }
+  catch(::std::exception& /*stdex*/) {
+    // Make a best effort.
+    this->m_what = ::rocket::sref("asteria runtime error: <message unavailable>");
+  }
 
 }  // namespace Asteria
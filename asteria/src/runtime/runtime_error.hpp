@@ -20,10 +20,12 @@ class Runtime_Error
 
   private:
     Value m_value;
-    cow_vector<Backtrace_Frame> m_frames;
-    size_t m_ipos = 0;  // where to insert new frames
+    cow_vector<Backtrace_Frame> m_frames;  // in order of recording
+    cow_vector<size_t> m_chains;  // where backtraces other than the first one begin
 
-    cow_string m_what;  // a comprehensive string that is human-readable.
+    // These are generated on demand.
+    mutable cow_vector<Backtrace_Frame> m_sorted;  // in order of display
+    mutable cow_string m_what;  // a comprehensive string that is human-readable.
 
   public:
     Runtime_Error(F_native, const exception& stdex)
@@ -50,26 +52,34 @@ class Runtime_Error
     void
     do_backtrace();
 
+    const cow_vector<Backtrace_Frame>&
+    do_sort_frames()
+    const;
+
     void
-    do_compose_message();
+    do_compose_message()
+    const noexcept;
 
     template<typename... ParamsT>
     void
     do_insert_frame(ParamsT&&... params)
       {
-        // Insert the frame. Note exception safety.
-        size_t ipos = this->m_ipos;
-        this->m_frames.insert(ipos, Backtrace_Frame(::std::forward<ParamsT>(params)...));
-        this->m_ipos = ipos + 1;
-        // Rebuild the message using new frames.
-        this->do_compose_message();
+        // Frames are only appended. Sorting and formatting are deferred until they are
+        // requested, so unwinding through deep stacks does not incur quadratic costs.
+        this->m_frames.emplace_back(::std::forward<ParamsT>(params)...);
+        this->m_sorted.clear();
+        this->m_what.clear();
       }
 
   public:
     const char*
     what()
     const noexcept override
-      { return this->m_what.c_str();  }
+      {
+        if(this->m_what.empty())
+          this->do_compose_message();
+        return this->m_what.c_str();
+      }
 
     const Value&
     value()
@@ -84,15 +94,16 @@ class Runtime_Error
     const Backtrace_Frame&
     frame(size_t index)
     const
-      { return this->m_frames.at(index);  }
+      { return this->do_sort_frames().at(index);  }
 
     template<typename XValT>
     Runtime_Error&
     push_frame_throw(const Source_Location& sloc, XValT&& xval)
       {
-        // Start a new backtrace.
+        // Start a new backtrace, which will be displayed before existing ones.
         this->m_value = ::std::forward<XValT>(xval);
-        this->m_ipos = 0;
+        if(!this->m_frames.empty())
+          this->m_chains.emplace_back(this->m_frames.size());
 
         // Append the first frame to the current backtrace.
         this->do_insert_frame(frame_type_throw, sloc, this->m_value);
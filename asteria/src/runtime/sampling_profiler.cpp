@@ -0,0 +1,231 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "sampling_profiler.hpp"
+#include "variadic_arguer.hpp"
+#include "../utilities.hpp"
+#include <signal.h>  // ::sigaction()
+#include <time.h>  // ::timer_create()
+#include <pthread.h>  // ::pthread_self()
+#include <sys/syscall.h>  // SYS_gettid
+#include <unistd.h>  // ::syscall()
+
+namespace Asteria {
+namespace {
+
+// Samples are passed from the signal handler to the sampled thread through a ring buffer.
+// The handler is the only writer of `s_head` and the thread is the only writer of `s_tail`.
+constexpr size_t s_max_depth = 64;
+constexpr uint32_t s_nslots = 16;
+
+struct Sample
+  {
+    size_t depth;
+    const Variadic_Arguer* frames[s_max_depth];  // innermost first
+  };
+
+Sample s_samples[s_nslots];
+::std::atomic<uint32_t> s_head;
+::std::atomic<uint32_t> s_tail;
+::std::atomic<uint32_t> s_ndropped;
+
+// These are set up by the running profiler.
+Sampling_Profiler* s_profiler;
+::pthread_t s_thread;
+::timer_t s_timer;
+struct ::sigaction s_old_action;
+
+// This is the innermost frame on each thread.
+thread_local Sampling_Profiler::Frame* s_top;
+
+void
+do_take_sample(int /*sig*/)
+noexcept
+  {
+    int err = errno;
+    uint32_t head = s_head.load(::std::memory_order_relaxed);
+    if(head - s_tail.load(::std::memory_order_acquire) >= s_nslots) {
+      s_ndropped.fetch_add(1, ::std::memory_order_relaxed);
+      errno = err;
+      return;
+    }
+
+    // Copy the chain of frames. Deep chains are truncated.
+    auto& smp = s_samples[head % s_nslots];
+    smp.depth = 0;
+    for(auto qframe = s_top;  qframe && (smp.depth < s_max_depth);  qframe = qframe->prev)
+      smp.frames[smp.depth++] = qframe->zvarg;
+
+    s_head.store(head + 1, ::std::memory_order_release);
+    errno = err;
+  }
+
+void
+do_append_frame(cow_string& stack, const Variadic_Arguer& zvarg)
+  {
+    // Semicolons delimit frames, so they must not appear in names.
+    ::rocket::tinyfmt_str fmt;
+    fmt << zvarg.func() << " @ " << zvarg.sloc();
+    auto name = fmt.extract_string();
+    ::std::replace(name.mut_begin(), name.mut_end(), ';', ',');
+
+    if(!stack.empty())
+      stack += ';';
+    stack += name;
+  }
+
+}  // namespace
+
+::std::atomic<bool> Sampling_Profiler::s_running;
+
+Sampling_Profiler::
+~Sampling_Profiler()
+  {
+    if(this->m_running)
+      this->stop();
+  }
+
+bool
+Sampling_Profiler::
+do_push_frame(Frame& frame, const Variadic_Arguer& zvarg)
+noexcept
+  {
+    // Only the thread that started the profiler is sampled.
+    if(!::pthread_equal(::pthread_self(), s_thread))
+      return false;
+
+    // Link the frame only after it has been initialized, in case a signal arrives.
+    frame.zvarg = &zvarg;
+    frame.prev = s_top;
+    ::std::atomic_signal_fence(::std::memory_order_release);
+    s_top = &frame;
+    return true;
+  }
+
+void
+Sampling_Profiler::
+do_pop_frame(Frame& frame)
+noexcept
+  {
+    // Unlink the frame first. Samples that have been taken may refer to it, so they are
+    // collected before the function returns and `zvarg` may be destroyed.
+    ROCKET_ASSERT(s_top == &frame);
+    s_top = frame.prev;
+    ::std::atomic_signal_fence(::std::memory_order_seq_cst);
+
+    if(s_profiler)
+      s_profiler->do_collect_samples();
+  }
+
+void
+Sampling_Profiler::
+do_collect_samples()
+noexcept
+  {
+    uint32_t tail = s_tail.load(::std::memory_order_relaxed);
+    while(tail != s_head.load(::std::memory_order_acquire)) {
+      const auto& smp = s_samples[tail % s_nslots];
+      if(smp.depth != 0) {
+        // Compose the collapsed stack, from the outermost frame to the innermost one.
+        // If memory is exhausted, the sample is dropped.
+        try {
+          cow_string stack;
+          for(size_t i = smp.depth - 1;  i != SIZE_MAX;  --i)
+            do_append_frame(stack, *(smp.frames[i]));
+          this->m_stacks.try_emplace(::std::move(stack)).first->second += 1;
+          this->m_nsamples++;
+        }
+        catch(::std::bad_alloc& /*stdex*/) {
+          this->m_ndropped++;
+        }
+      }
+      s_tail.store(++tail, ::std::memory_order_release);
+    }
+    this->m_ndropped += s_ndropped.exchange(0, ::std::memory_order_relaxed);
+  }
+
+Sampling_Profiler&
+Sampling_Profiler::
+start(uint32_t interval_us)
+  {
+    if(this->m_running)
+      return *this;
+
+    if(s_profiler)
+      ASTERIA_THROW("another profiler is running");
+
+    if(interval_us == 0)
+      ASTERIA_THROW("invalid sampling interval (interval_us `$1`)", interval_us);
+
+    // Install the signal handler.
+    struct ::sigaction sigx = { };
+    sigx.sa_handler = do_take_sample;
+    sigx.sa_flags = SA_RESTART;
+    if(::sigaction(SIGPROF, &sigx, &s_old_action) != 0)
+      ASTERIA_THROW_SYSTEM_ERROR("sigaction");
+
+    // Create a timer that measures CPU time of this thread, and signals this thread.
+    struct ::sigevent sigev = { };
+    sigev.sigev_notify = SIGEV_THREAD_ID;
+    sigev.sigev_signo = SIGPROF;
+    sigev._sigev_un._tid = static_cast<::pid_t>(::syscall(SYS_gettid));  // `sigev_notify_thread_id`
+    if(::timer_create(CLOCK_THREAD_CPUTIME_ID, &sigev, &s_timer) != 0) {
+      int err = errno;
+      ::sigaction(SIGPROF, &s_old_action, nullptr);
+      errno = err;
+      ASTERIA_THROW_SYSTEM_ERROR("timer_create");
+    }
+
+    // Discard stale samples.
+    s_tail.store(s_head.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+    s_ndropped.store(0, ::std::memory_order_relaxed);
+    s_thread = ::pthread_self();
+    s_profiler = this;
+    s_running.store(true, ::std::memory_order_relaxed);
+    this->m_running = true;
+
+    struct ::itimerspec its = { };
+    its.it_interval.tv_sec = static_cast<::time_t>(interval_us / 1000000);
+    its.it_interval.tv_nsec = static_cast<long>(interval_us % 1000000 * 1000);
+    its.it_value = its.it_interval;
+    if(::timer_settime(s_timer, 0, &its, nullptr) != 0) {
+      int err = errno;
+      this->stop();
+      errno = err;
+      ASTERIA_THROW_SYSTEM_ERROR("timer_settime");
+    }
+    return *this;
+  }
+
+Sampling_Profiler&
+Sampling_Profiler::
+stop()
+noexcept
+  {
+    if(!this->m_running)
+      return *this;
+
+    // Stop the timer before restoring the signal handler, then collect samples that
+    // have been taken.
+    ::timer_delete(s_timer);
+    ::sigaction(SIGPROF, &s_old_action, nullptr);
+    this->do_collect_samples();
+
+    s_running.store(false, ::std::memory_order_relaxed);
+    s_profiler = nullptr;
+    this->m_running = false;
+    return *this;
+  }
+
+tinyfmt&
+Sampling_Profiler::
+print_collapsed(tinyfmt& fmt)
+const
+  {
+    for(auto it = this->m_stacks.begin();  it != this->m_stacks.end();  ++it)
+      fmt << it->first << ' ' << it->second << '\n';
+    return fmt;
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,127 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_SAMPLING_PROFILER_HPP_
+#define ASTERIA_RUNTIME_SAMPLING_PROFILER_HPP_
+
+#include "../fwd.hpp"
+#include <atomic>
+
+namespace Asteria {
+
+// This is a sampling profiler for scripts. While it is running, script functions that are
+// called on the thread that started it record themselves in a chain of frames, which is
+// captured by a timer signal (`SIGPROF`) that is delivered after some CPU time. Results
+// are printed as collapsed stacks, which `flamegraph.pl` accepts.
+// At most one profiler may be running in a process at a time.
+class Sampling_Profiler
+  {
+  public:
+    // This is the node of a chain of frames, which resides on the native stack.
+    struct Frame
+      {
+        const Variadic_Arguer* zvarg;
+        Frame* prev;
+      };
+
+    // This records a script function during its execution if a profiler is running.
+    // It costs a single load otherwise.
+    class Frame_Guard
+      {
+      private:
+        Frame m_frame;
+        bool m_pushed;
+
+      public:
+        explicit
+        Frame_Guard(const Variadic_Arguer& zvarg)
+        noexcept
+          : m_pushed(ROCKET_UNEXPECT(s_running.load(::std::memory_order_relaxed))
+                     && Sampling_Profiler::do_push_frame(this->m_frame, zvarg))
+          { }
+
+        ~Frame_Guard()
+          {
+            if(ROCKET_UNEXPECT(this->m_pushed))
+              Sampling_Profiler::do_pop_frame(this->m_frame);
+          }
+
+        ASTERIA_DECLARE_NONCOPYABLE(Frame_Guard);
+      };
+
+  private:
+    // This is read by all threads, so it has to be atomic. Relaxed loads are plain loads
+    // on common targets.
+    static ::std::atomic<bool> s_running;
+
+    cow_dictionary<uint64_t> m_stacks;  // collapsed stacks and numbers of samples
+    uint64_t m_nsamples = 0;
+    uint64_t m_ndropped = 0;
+    bool m_running = false;
+
+  public:
+    Sampling_Profiler()
+    noexcept
+      = default;
+
+    ~Sampling_Profiler();
+
+    ASTERIA_DECLARE_NONCOPYABLE(Sampling_Profiler);
+
+  private:
+    static
+    bool
+    do_push_frame(Frame& frame, const Variadic_Arguer& zvarg)
+    noexcept;
+
+    static
+    void
+    do_pop_frame(Frame& frame)
+    noexcept;
+
+    void
+    do_collect_samples()
+    noexcept;
+
+  public:
+    bool
+    is_running()
+    const noexcept
+      { return this->m_running;  }
+
+    // Get the number of samples that have been recorded, or dropped because they came
+    // in faster than they were collected.
+    uint64_t
+    count_samples()
+    const noexcept
+      { return this->m_nsamples;  }
+
+    uint64_t
+    count_dropped_samples()
+    const noexcept
+      { return this->m_ndropped;  }
+
+    Sampling_Profiler&
+    clear()
+    noexcept
+      { return this->m_stacks.clear(), this->m_nsamples = 0, this->m_ndropped = 0, *this;  }
+
+    // Start sampling the calling thread every `interval_us` microseconds of CPU time.
+    // An exception is thrown if another profiler is running.
+    Sampling_Profiler&
+    start(uint32_t interval_us);
+
+    // Stop sampling. Samples that have been recorded are kept.
+    Sampling_Profiler&
+    stop()
+    noexcept;
+
+    // Print collapsed stacks, one per line, as `outer;inner count`.
+    tinyfmt&
+    print_collapsed(tinyfmt& fmt)
+    const;
+  };
+
+}  // namespace Asteria
+
+#endif
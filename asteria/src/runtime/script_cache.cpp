@@ -0,0 +1,197 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "script_cache.hpp"
+#include "air_serializer.hpp"
+#include "air_optimizer.hpp"
+#include "../compiler/token_stream.hpp"
+#include "../compiler/statement_sequence.hpp"
+#include "../utilities.hpp"
+#include <sys/stat.h>
+#include <unistd.h>  // ::write(), ::close()
+
+namespace Asteria {
+namespace {
+
+// This shall be incremented whenever the binary form of IR nodes is changed.
+constexpr char s_cache_magic[] = "Asteria compiled script v1";
+
+cow_string
+do_read_all(tinybuf& cbuf)
+  {
+    cow_string text;
+    char temp[4096];
+    size_t nread;
+    while((nread = cbuf.getn(temp, sizeof(temp))) != 0)
+      text.append(temp, nread);
+    return text;
+  }
+
+uint64_t
+do_hash_fnv1a64(const cow_string& text)
+  {
+    uint64_t hval = 0xCBF29CE484222325;
+    for(char ch : text)
+      hval = (hval ^ static_cast<unsigned char>(ch)) * 0x100000001B3;
+    return hval;
+  }
+
+void
+do_put_cache_key(AIR_Serializer& ser, const Compiler_Options& opts, const cow_string& path,
+                 const cow_string& text)
+  {
+    // The file may be modified after it has been read. Such a change is detected by
+    // the hash of its contents.
+    struct ::stat info;
+    if(::stat(path.safe_c_str(), &info) != 0)
+      ::std::memset(&info, 0, sizeof(info));
+
+    ser.put_string(::rocket::sref(s_cache_magic));
+    ser.put_string(path);
+    ser.put_int64(static_cast<int64_t>(info.st_size));
+    ser.put_int64(static_cast<int64_t>(info.st_mtim.tv_sec));
+    ser.put_int64(static_cast<int64_t>(info.st_mtim.tv_nsec));
+    ser.put_int64(static_cast<int64_t>(text.size()));
+    ser.put_int64(static_cast<int64_t>(do_hash_fnv1a64(text)));
+    ser.put_options(opts);
+  }
+
+bool
+do_load_cache(cow_vector<AIR_Node>& code, const cow_string& cpath, const cow_string& key)
+  {
+    ::rocket::unique_posix_file file(::fopen(cpath.safe_c_str(), "rb"), ::fclose);
+    if(!file)
+      return false;
+
+    // Read the entire file.
+    ::rocket::tinybuf_file cbuf;
+    cbuf.reset(file.release(), ::fclose);
+    auto data = do_read_all(cbuf);
+
+    // Check the key, which is a prefix of the file.
+    if((data.size() < key.size()) || (::std::memcmp(data.data(), key.data(), key.size()) != 0))
+      return false;
+
+    // Invalid cache files are ignored, as if they didn't exist.
+    try {
+      AIR_Deserializer des(data.data() + key.size(), data.data() + data.size());
+      code = des.get_code();
+      return des.at_end();
+    }
+    catch(exception& /*stdex*/) {
+      return false;
+    }
+  }
+
+bool
+do_write_cache(const cow_string& cpath, const cow_string& data)
+  {
+    // Write a temporary file, then move it into place, so readers never see a
+    // partially written file.
+    cow_string tpath = cpath + ".XXXXXX";
+    int fd = ::mkstemp(tpath.mut_data());
+    if(fd == -1)
+      return false;
+
+    size_t nwritten = 0;
+    while(nwritten < data.size()) {
+      auto nw = ::write(fd, data.data() + nwritten, data.size() - nwritten);
+      if(nw < 0)
+        break;
+      nwritten += static_cast<size_t>(nw);
+    }
+
+    if((::close(fd) != 0) || (nwritten != data.size()) || (::rename(tpath.c_str(), cpath.c_str()) != 0)) {
+      ::unlink(tpath.c_str());
+      return false;
+    }
+    return true;
+  }
+
+void
+do_compile(AIR_Optimizer& optmz, const cow_vector<phsh_string>& params, tinybuf& cbuf,
+           const cow_string& path)
+  {
+    // Parse source code.
+    Token_Stream tstrm(optmz.get_options());
+    tstrm.reload(cbuf, path);
+
+    Statement_Sequence stmtq(optmz.get_options());
+    stmtq.reload(tstrm);
+
+    // Generate code.
+    optmz.reload(nullptr, params, stmtq);
+  }
+
+}  // namespace
+
+cow_string
+get_script_cache_path(const cow_string& path)
+  {
+    return path + ".astc";
+  }
+
+cow_function
+compile_script_file(const Compiler_Options& opts, tinybuf& cbuf, const cow_string& path)
+  {
+    const cow_vector<phsh_string> params(1, ::rocket::sref("..."));
+    AIR_Optimizer optmz(opts);
+
+    if(!opts.cache_compiled_code) {
+      // Compile the file as usual.
+      do_compile(optmz, params, cbuf, path);
+      return optmz.create_function(Source_Location(path, 0, 0), ::rocket::sref("<file scope>"));
+    }
+
+    // Hash the source code, which is required to validate the cache file anyway.
+    auto text = do_read_all(cbuf);
+    AIR_Serializer ser;
+    do_put_cache_key(ser, opts, path, text);
+
+    // Try loading the cache file. The code contains no captured references, so
+    // it can be loaded as if it was the body of a closure.
+    auto cpath = get_script_cache_path(path);
+    cow_vector<AIR_Node> code;
+    if(do_load_cache(code, cpath, ser.get_string())) {
+      optmz.capture(params, code);
+      return optmz.create_function(Source_Location(path, 0, 0), ::rocket::sref("<file scope>"));
+    }
+
+    // Compile the file, then update the cache file.
+    ::rocket::tinybuf_str sbuf;
+    sbuf.set_string(text, tinybuf::open_read);
+    do_compile(optmz, params, sbuf, path);
+
+    if(ser.put_code(optmz))
+      do_write_cache(cpath, ser.get_string());
+    return optmz.create_function(Source_Location(path, 0, 0), ::rocket::sref("<file scope>"));
+  }
+
+void
+precompile_script_file(const Compiler_Options& opts, const cow_string& path)
+  {
+    // Make the cache file usable by `compile_script_file()`.
+    auto xopts = opts;
+    xopts.cache_compiled_code = true;
+
+    ::rocket::tinybuf_file cbuf;
+    cbuf.open(path.safe_c_str(), tinybuf::open_read);
+    auto text = do_read_all(cbuf);
+
+    ::rocket::tinybuf_str sbuf;
+    sbuf.set_string(text, tinybuf::open_read);
+    AIR_Optimizer optmz(xopts);
+    do_compile(optmz, cow_vector<phsh_string>(1, ::rocket::sref("...")), sbuf, path);
+
+    AIR_Serializer ser;
+    do_put_cache_key(ser, xopts, path, text);
+    if(!ser.put_code(optmz))
+      ASTERIA_THROW("script could not be serialized (path `$1`)", path);
+
+    auto cpath = get_script_cache_path(path);
+    if(!do_write_cache(cpath, ser.get_string()))
+      ASTERIA_THROW_SYSTEM_ERROR("write");
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,33 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_SCRIPT_CACHE_HPP_
+#define ASTERIA_RUNTIME_SCRIPT_CACHE_HPP_
+
+#include "../fwd.hpp"
+
+namespace Asteria {
+
+// Compiled code of a script file is cached in a file whose path is that of the script
+// file with `.astc` appended. A cache file is valid only if the path, size, modification
+// time and contents of the script file, as well as compiler options, match those when
+// it was written.
+cow_string
+get_script_cache_path(const cow_string& path);
+
+// Compile a script file into a function. `path` shall be absolute, and `cbuf` shall read
+// the contents of the file denoted by it.
+// If `opts.cache_compiled_code` is set, code is loaded from the cache file if it is valid,
+// otherwise source code is compiled and the cache file is updated. Failure to read or
+// write the cache file is not an error.
+cow_function
+compile_script_file(const Compiler_Options& opts, tinybuf& cbuf, const cow_string& path);
+
+// Compile a script file and write its cache file, regardless of `opts.cache_compiled_code`.
+// `path` shall be absolute. An exception is thrown if the cache file cannot be written.
+void
+precompile_script_file(const Compiler_Options& opts, const cow_string& path);
+
+}  // namespace Asteria
+
+#endif
@@ -0,0 +1,249 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "tracing_hooks.hpp"
+#include "instantiated_function.hpp"
+#include "../utilities.hpp"
+#include <chrono>
+#include <sys/syscall.h>  // SYS_gettid
+#include <unistd.h>  // ::syscall(), ::getpid()
+
+namespace Asteria {
+namespace {
+
+constexpr char s_categories[][8] = { "script", "native", "import", "gc" };
+
+inline
+uint64_t
+do_get_nanoseconds()
+noexcept
+  {
+    auto dur = ::std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(dur).count());
+  }
+
+inline
+uint32_t
+do_get_thread_id()
+noexcept
+  {
+    static thread_local uint32_t s_tid = static_cast<uint32_t>(::syscall(SYS_gettid));
+    return s_tid;
+  }
+
+tinyfmt&
+do_print_json_string(tinyfmt& fmt, const cow_string& str)
+  {
+    static constexpr char s_xdigits[] = "0123456789ABCDEF";
+
+    // Bytes above 0x7F are copied verbatim, as names are expected to be UTF-8.
+    fmt << '\"';
+    for(char ch : str) {
+      auto uch = static_cast<unsigned char>(ch);
+      if((ch == '\"') || (ch == '\\'))
+        fmt << '\\' << ch;
+      else if(uch < 0x20)
+        fmt << "\\u00" << s_xdigits[uch / 16] << s_xdigits[uch % 16];
+      else
+        fmt << ch;
+    }
+    fmt << '\"';
+    return fmt;
+  }
+
+tinyfmt&
+do_print_microseconds(tinyfmt& fmt, uint64_t ns)
+  {
+    // Timestamps are in microseconds, with three decimal places.
+    fmt << ns / 1000 << '.';
+    fmt << static_cast<char>('0' + ns / 100 % 10)
+        << static_cast<char>('0' + ns / 10 % 10)
+        << static_cast<char>('0' + ns % 10);
+    return fmt;
+  }
+
+}  // namespace
+
+Tracing_Hooks::
+~Tracing_Hooks()
+  {
+  }
+
+uint32_t
+Tracing_Hooks::
+do_intern_name(const cow_string& name)
+  {
+    auto index = static_cast<uint32_t>(this->m_names.size());
+    auto pair = this->m_name_indices.try_emplace(phsh_string(name), index);
+    if(pair.second)
+      this->m_names.emplace_back(name);
+    return pair.first->second;
+  }
+
+uint32_t
+Tracing_Hooks::
+do_intern_function_name(const cow_function& target)
+  {
+    // Look for the function in the cache first. As the cached function is kept alive,
+    // its address can't have been reused by another one.
+    auto qentry = ::rocket::get_probing_origin(::std::begin(this->m_name_cache),
+                                               ::std::end(this->m_name_cache),
+                                               reinterpret_cast<uintptr_t>(target.ptr()));
+    if(ROCKET_EXPECT(qentry->target && (qentry->target.ptr() == target.ptr())))
+      return qentry->name;
+
+    // Functions are identified by their descriptions, as their addresses may be reused.
+    // Only the first non-empty line is kept, as native functions are described with their
+    // documentation and addresses.
+    this->m_fmt.clear_string();
+    target.describe(this->m_fmt);
+    const auto& desc = this->m_fmt.get_string();
+    size_t bpos = desc.find_first_not_of('\n');
+    size_t epos = desc.find('\n', bpos);
+    if((bpos == cow_string::npos) || ((bpos == 0) && (epos == cow_string::npos)))
+      qentry->name = this->do_intern_name(desc);
+    else
+      qentry->name = this->do_intern_name(cow_string(desc, bpos, epos - bpos));
+
+    // Replace the old entry, if any.
+    qentry->target = target;
+    return qentry->name;
+  }
+
+void
+Tracing_Hooks::
+do_begin(Category cat, uint32_t name, uint64_t arg)
+  {
+    // Room is reserved for end events of all open events including this one, so none of
+    // them will be lost.
+    if(this->m_nskip || (this->m_events.size() + this->m_nopen + 2 > this->m_max_events)) {
+      this->m_nskip++;
+      this->m_ndropped++;
+      return;
+    }
+
+    Event event = { do_get_nanoseconds(), arg, name, do_get_thread_id(), 'B', cat };
+    this->m_events.emplace_back(event);
+    this->m_nopen++;
+  }
+
+void
+Tracing_Hooks::
+do_end(Category cat, uint32_t name, uint64_t arg)
+  {
+    if(this->m_nskip) {
+      this->m_nskip--;
+      this->m_ndropped++;
+      return;
+    }
+
+    Event event = { do_get_nanoseconds(), arg, name, do_get_thread_id(), 'E', cat };
+    this->m_events.emplace_back(event);
+
+    // The begin event may have preceded installation of these hooks.
+    if(this->m_nopen)
+      this->m_nopen--;
+  }
+
+tinyfmt&
+Tracing_Hooks::
+flush(tinyfmt& fmt)
+  {
+    auto pid = static_cast<uint32_t>(::getpid());
+    fmt << "{\"traceEvents\":[";
+
+    for(size_t i = 0;  i != this->m_events.size();  ++i) {
+      const auto& event = this->m_events[i];
+      fmt << (i ? ",\n" : "\n") << "{\"name\":";
+      do_print_json_string(fmt, this->m_names[event.name]);
+      fmt << ",\"cat\":\"" << s_categories[event.cat] << "\",\"ph\":\"" << event.phase
+          << "\",\"pid\":" << pid << ",\"tid\":" << event.tid << ",\"ts\":";
+      do_print_microseconds(fmt, event.time);
+
+      // Print arguments.
+      switch(event.cat) {
+        case category_script:
+        case category_native:
+          if(event.phase == 'E')
+            fmt << ",\"args\":{\"exception\":" << (event.arg ? "true" : "false") << "}";
+          break;
+
+        case category_import:
+          break;
+
+        case category_gc:
+          if(event.phase == 'B')
+            fmt << ",\"args\":{\"generation_limit\":" << event.arg << "}";
+          else
+            fmt << ",\"args\":{\"variables_collected\":" << event.arg << "}";
+          break;
+
+        default:
+          ROCKET_ASSERT(false);
+      }
+      fmt << "}";
+    }
+
+    fmt << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":"
+        << this->m_ndropped << "}}\n";
+
+    this->m_events.clear();
+    this->m_ndropped = 0;
+    this->do_clear_name_cache();
+    return fmt;
+  }
+
+void
+Tracing_Hooks::
+on_function_call(const Source_Location& /*sloc*/, const cow_function& target)
+  {
+    auto cat = (target.type() == typeid(Instantiated_Function)) ? category_script : category_native;
+    this->do_begin(cat, this->do_intern_function_name(target), 0);
+  }
+
+void
+Tracing_Hooks::
+on_function_return(const Source_Location& /*sloc*/, const cow_function& target, const Reference& /*result*/)
+  {
+    auto cat = (target.type() == typeid(Instantiated_Function)) ? category_script : category_native;
+    this->do_end(cat, this->do_intern_function_name(target), 0);
+  }
+
+void
+Tracing_Hooks::
+on_function_except(const Source_Location& /*sloc*/, const cow_function& target, const Runtime_Error& /*except*/)
+  {
+    auto cat = (target.type() == typeid(Instantiated_Function)) ? category_script : category_native;
+    this->do_end(cat, this->do_intern_function_name(target), 1);
+  }
+
+void
+Tracing_Hooks::
+on_module_compile_begin(const Source_Location& /*sloc*/, const cow_string& path)
+  {
+    this->do_begin(category_import, this->do_intern_name(path), 0);
+  }
+
+void
+Tracing_Hooks::
+on_module_compile_end(const Source_Location& /*sloc*/, const cow_string& path)
+  {
+    this->do_end(category_import, this->do_intern_name(path), 0);
+  }
+
+void
+Tracing_Hooks::
+on_garbage_collect_begin(GC_Generation gc_limit)
+  {
+    this->do_begin(category_gc, this->do_intern_name(::rocket::sref("garbage collection")), gc_limit);
+  }
+
+void
+Tracing_Hooks::
+on_garbage_collect_end(GC_Generation /*gc_limit*/, size_t nvars)
+  {
+    this->do_end(category_gc, this->do_intern_name(::rocket::sref("garbage collection")), nvars);
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,144 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_TRACING_HOOKS_HPP_
+#define ASTERIA_RUNTIME_TRACING_HOOKS_HPP_
+
+#include "../fwd.hpp"
+#include "abstract_hooks.hpp"
+
+namespace Asteria {
+
+// These hooks record a timeline of function calls, compilation of imported modules and
+// garbage collection. Events are buffered in memory as fixed-size records, and are printed
+// in the Trace Event Format on demand, which Chrome (`about:tracing`) and Perfetto accept.
+class Tracing_Hooks
+final
+  : public Abstract_Hooks
+  {
+  public:
+    enum Category : uint8_t
+      {
+        category_script  = 0,  // calls to script functions
+        category_native  = 1,  // calls to native functions
+        category_import  = 2,  // compilation of imported modules
+        category_gc      = 3,  // garbage collection
+      };
+
+  private:
+    struct Event
+      {
+        uint64_t time;  // nanoseconds since the epoch of `steady_clock`
+        uint64_t arg;  // specific to category and phase
+        uint32_t name;  // index into `m_names`
+        uint32_t tid;
+        char phase;  // `B` for begin and `E` for end
+        Category cat;
+      };
+
+    struct Cached_Name
+      {
+        cow_function target;  // keeps its address from being reused
+        uint32_t name;
+      };
+
+    size_t m_max_events;
+    cow_vector<Event> m_events;
+    cow_vector<cow_string> m_names;
+    cow_dictionary<uint32_t> m_name_indices;
+    // Names of functions are cached by address, so functions that are called again
+    // aren't described again. Cached functions are released by `flush()`.
+    Cached_Name m_name_cache[61];
+    ::rocket::tinyfmt_str m_fmt;  // reusable storage
+
+    size_t m_nopen = 0;  // number of begin events that have not ended
+    size_t m_nskip = 0;  // nesting level of events that are being dropped
+    uint64_t m_ndropped = 0;
+
+  public:
+    // At most `max_events` events are buffered. When the buffer is full, new events are
+    // dropped along with everything nested in them, until it is flushed.
+    explicit
+    Tracing_Hooks(size_t max_events = 1048576)
+      : m_max_events(max_events)
+      { }
+
+    ~Tracing_Hooks()
+    override;
+
+    ASTERIA_DECLARE_NONCOPYABLE(Tracing_Hooks);
+
+  private:
+    void
+    do_clear_name_cache()
+    noexcept
+      {
+        for(auto& entry : this->m_name_cache)
+          entry.target.reset();
+      }
+
+    uint32_t
+    do_intern_name(const cow_string& name);
+
+    uint32_t
+    do_intern_function_name(const cow_function& target);
+
+    void
+    do_begin(Category cat, uint32_t name, uint64_t arg);
+
+    void
+    do_end(Category cat, uint32_t name, uint64_t arg);
+
+  public:
+    size_t
+    count_events()
+    const noexcept
+      { return this->m_events.size();  }
+
+    uint64_t
+    count_dropped_events()
+    const noexcept
+      { return this->m_ndropped;  }
+
+    Tracing_Hooks&
+    clear()
+    noexcept
+      { return this->m_events.clear(), this->m_ndropped = 0, this->do_clear_name_cache(), *this;  }
+
+    // Print buffered events as a JSON object, then discard them. Events that began but
+    // have not ended yet will be printed with their ends in the next flush.
+    tinyfmt&
+    flush(tinyfmt& fmt);
+
+    void
+    on_function_call(const Source_Location& sloc, const cow_function& target)
+    override;
+
+    void
+    on_function_return(const Source_Location& sloc, const cow_function& target, const Reference& result)
+    override;
+
+    void
+    on_function_except(const Source_Location& sloc, const cow_function& target, const Runtime_Error& except)
+    override;
+
+    void
+    on_module_compile_begin(const Source_Location& sloc, const cow_string& path)
+    override;
+
+    void
+    on_module_compile_end(const Source_Location& sloc, const cow_string& path)
+    override;
+
+    void
+    on_garbage_collect_begin(GC_Generation gc_limit)
+    override;
+
+    void
+    on_garbage_collect_end(GC_Generation gc_limit, size_t nvars)
+    override;
+  };
+
+}  // namespace Asteria
+
+#endif
@@ -6,6 +6,7 @@
 #include "compiler/token_stream.hpp"
 #include "compiler/statement_sequence.hpp"
 #include "runtime/air_optimizer.hpp"
+#include "runtime/script_cache.hpp"
 #include "utilities.hpp"
 
 namespace Asteria {
@@ -53,7 +54,10 @@ reload_file(const char* path)
     // Open the file denoted by this path.
     ::rocket::tinybuf_file cbuf;
     cbuf.open(abspath, tinybuf::open_read);
-    return this->reload(cbuf, cow_string(abspath));
+
+    // The cache file is used if requested.
+    this->m_func = compile_script_file(this->m_opts, cbuf, cow_string(abspath));
+    return *this;
   }
 
 Simple_Script&
@@ -0,0 +1,72 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Parameters are bound by position. Missing ones are null.
+        func three(a, b, c) { return [ a, b, c ];  }
+        assert three(1, 2, 3) == [ 1, 2, 3 ];
+        assert three(1) == [ 1, null, null ];
+        assert three() == [ null, null, null ];
+
+        // Excess arguments are only allowed for variadic functions.
+        try {
+          three(1, 2, 3, 4);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "too many arguments") != null;
+
+        func var1(a, ...) { return [ a, __varg(), __varg ];  }
+        assert var1(1)[0] == 1;
+        assert var1(1)[1] == 0;
+        assert var1(1, 2, 3)[1] == 2;
+        assert var1(1, 2, 3)[2](0) == 2;
+        assert var1(1, 2, 3)[2](1) == 3;
+
+        // Storage for arguments is reused across calls. Make sure nothing leaks from
+        // one call to another, including calls that have thrown exceptions.
+        func nested(n, acc) {
+          if(n == 0)
+            return acc;
+          var r = acc + n;
+          if(n == 3)
+            try
+              three(1, 2, 3, 4);
+            catch(e)
+              r += 1;
+          return nested(n - 1, r) + 0;
+        }
+        for(var i = 0;  i < 100;  ++i)
+          assert nested(10, 0) == 56;
+
+        func reentrant(x) {
+          return std.array.count_if([ 1, 2, 3, 4 ], func(v) { return three(v, x)[0] > x;  });
+        }
+        assert reentrant(2) == 2;
+        assert reentrant(3) == 1;
+        assert three(4, 5) == [ 4, 5, null ];
+
+        // Arguments of native functions.
+        assert std.string.format("$1$2$3", 1, 2, 3) == "123";
+        assert std.array.max_of([ 5, 9, 2 ]) == 9;
+        assert three(std.numeric.abs(-1), "b") == [ 1, "b", null ];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
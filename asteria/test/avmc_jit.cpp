@@ -0,0 +1,75 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Loops and recursion
+        func fib(n) {
+          if(n <= 1)
+            return n;
+          return fib(n - 1) + fib(n - 2);
+        }
+        var r = 0;
+        for(var i = 0;  i < 20;  ++i)
+          r += fib(i);
+        assert r == 10945;
+
+        // Exceptions are propagated through native code, with backtraces.
+        func deep(d) {
+          if(d == 0)
+            throw "bail out";
+          return deep(d - 1) + 1;
+        }
+        var count = 0;
+        var bt;
+        for(var i = 0;  i < 100;  ++i)
+          try
+            deep(10);
+          catch(e) {
+            assert e == "bail out";
+            bt = __backtrace;
+            ++count;
+          }
+        assert count == 100;
+        assert bt[0].frame == "throw statement";
+        assert countof bt > 10;
+
+        // Early exits from loops
+        var s = 0;
+        for(var i = 0;  i < 100;  ++i) {
+          if(i == 50)
+            break;
+          if(i % 2 == 0)
+            continue;
+          s += i;
+        }
+        assert s == 625;
+
+        return r;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+
+    // Generate native code for every queue that is executed.
+    global.set_jit_threshold(1);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 10945);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 10945);
+
+    // Disable generation of native code.
+    global.set_jit_threshold(0);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 10945);
+  }
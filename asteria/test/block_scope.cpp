@@ -0,0 +1,114 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Blocks that declare nothing share the enclosing scope.
+        var a = 1;
+        {
+          {
+            a += 1;
+          }
+          if(a == 2) {
+            a *= 10;
+          }
+        }
+        assert a == 20;
+
+        // Shadowing in loop bodies, whose scopes are reused across iterations.
+        var x = "outer";
+        var seen = [];
+        for(var i = 0;  i < 3;  ++i) {
+          assert x == "outer";
+          var x = i;
+          seen[$] = x;
+        }
+        assert x == "outer";
+        assert seen == [ 0, 1, 2 ];
+
+        // Each iteration gets its own variables.
+        var fs = [];
+        for(each k, v : [ "a", "b", "c" ]) {
+          var copy = v;
+          fs[$] = func() { return copy;  };
+        }
+        assert fs[0]() == "a";
+        assert fs[1]() == "b";
+        assert fs[2]() == "c";
+
+        var n = 0;
+        var gs = [];
+        while(n < 3) {
+          var m = n * 2;
+          gs[$] = func() { return m;  };
+          ++n;
+        }
+        assert gs[0]() == 0;
+        assert gs[1]() == 2;
+        assert gs[2]() == 4;
+
+        // Deferred expressions are evaluated at the end of each iteration.
+        var log = [];
+        do {
+          defer log[$] = n;
+          --n;
+        }
+        while(n > 0);
+        assert log == [ 2, 1, 0 ];
+
+        // ... and on `break`, `continue` and exceptions.
+        log = [];
+        for(var j = 0;  j < 5;  ++j) {
+          defer log[$] = j;
+          if(j == 1)
+            continue;
+          if(j == 3)
+            break;
+        }
+        assert log == [ 0, 1, 2, 3 ];
+
+        log = [];
+        try {
+          while(true) {
+            defer log[$] = "exit";
+            throw "boom";
+          }
+        }
+        catch(e)
+          log[$] = e;
+        assert log == [ "exit", "boom" ];
+
+        // Nested blocks referring to outer variables.
+        func nest(p) {
+          var q = p + 1;
+          if(p > 0) {
+            var r = q * 2;
+            {
+              var s = r + q;
+              return s;
+            }
+          }
+          else
+            return q;
+        }
+        assert nest(1) == 6;
+        assert nest(0) == 1;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
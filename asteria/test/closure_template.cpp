@@ -0,0 +1,144 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Each closure has its own captured references.
+        func counter(n) {
+          var v = n;
+          return func() { return ++v;  };
+        }
+        var c1 = counter(10);
+        var c2 = counter(20);
+        assert c1() == 11;
+        assert c1() == 12;
+        assert c2() == 21;
+        assert c1() == 13;
+
+        // Closures created in loops share the same code.
+        var fs = [];
+        for(var i = 0;  i < 5;  ++i) {
+          var k = i * 2;
+          fs[$] = func(x) { return x + k;  };
+        }
+        for(var i = 0;  i < 5;  ++i)
+          assert fs[i](1) == i * 2 + 1;
+
+        // References may be captured from several levels.
+        func outer(a) {
+          var b = a + 1;
+          return func(c) {
+            var d = c * 2;
+            return func(e) {
+              {
+                var f = 100;
+                return a + b + c + d + e + f;
+              }
+            };
+          };
+        }
+        assert outer(1)(2)(3) == 1 + 2 + 2 + 4 + 3 + 100;
+        assert outer(10)(20)(30) == 10 + 11 + 20 + 40 + 30 + 100;
+        var mid = outer(5);
+        assert mid(1)(0) == 5 + 6 + 1 + 2 + 0 + 100;
+        assert mid(2)(0) == 5 + 6 + 2 + 4 + 0 + 100;
+
+        // Captured variables are shared with the enclosing function.
+        func pair() {
+          var v = 0;
+          return [ func() { return v;  }, func(x) { v = x;  } ];
+        }
+        var p = pair();
+        var q = pair();
+        p[1](42);
+        assert p[0]() == 42;
+        assert q[0]() == 0;
+
+        // Captured references in deferred expressions.
+        var log = [];
+        func deferred(x) {
+          return func() {
+            defer log[$] = x;
+            defer (func() { log[$] = x + 1;  })();
+            return x;
+          };
+        }
+        assert deferred(7)() == 7;
+        assert log == [ 8, 7 ];
+
+        // Deferred expressions are bound when they are declared, so they don't see
+        // variables that are declared later with the same name.
+        func shadow(x) {
+          var y = x + 1;
+          return func(z) {
+            var w = z + 1;
+            defer log[$] = [ x, y, z, w ];
+            var x = "x";
+            var y = "y";
+            var z = "z";
+            var w = "w";
+            return [ x, y, z, w ];
+          };
+        }
+        log = [];
+        assert shadow(1)(3) == [ "x", "y", "z", "w" ];
+        assert log == [ [ 1, 2, 3, 4 ] ];
+
+        // Captured references in proper tail calls.
+        func tail(x) {
+          return func(y) {
+            defer log[$] = x;
+            return std.string.format("$1$2", x, y);
+          };
+        }
+        log = [];
+        assert tail("a")("b") == "ab";
+        assert log == [ "a" ];
+
+        // Recursive closures.
+        func make_fact() {
+          var fact;
+          fact = func(n) {
+            if(n <= 1)
+              return 1;
+            return n * fact(n - 1);
+          };
+          return fact;
+        }
+        assert make_fact()(10) == 3628800;
+
+        // Bypassed variables can't be used.
+        func bypass(x) {
+          switch(x) {
+          case 1:
+            var a = "a";
+          case 2:
+            return func() { return a;  };
+          }
+        }
+        assert bypass(1)() == "a";
+        try {
+          bypass(2)();
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "bypassed") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,100 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Constant expressions are folded at compile time.
+        assert 1 + 2 * 3 == 7;
+        assert (1 << 40) + 1 == 1099511627777;
+        assert 0x7FFFFFFFFFFFFFFF + 0 == 9223372036854775807;
+        assert -(1.5) * 2 == -3.0;
+        assert "abc" + "def" == "abcdef";
+        assert !true == false;
+        assert typeof (1 + 2.0) == "real";
+        assert countof "hello" == 5;
+        assert __abs -5 == 5;
+        assert (1 < 2) == true;
+        assert (1 <=> 2) == -1;
+
+        // Operations that fail must still fail at run time.
+        try {
+          var r = 1 / 0;
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "zero") != null;
+
+        try {
+          var r = 0x7FFFFFFFFFFFFFFF + 1;
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "overflow") != null;
+
+        // Branches with constant conditions are pruned.
+        var x = 1;
+        if(1 + 1 == 2)
+          x = 2;
+        else
+          x = 3;
+        assert x == 2;
+
+        if(!(1 + 1 == 2)) {
+          var y = 4;
+          x = y;
+        }
+        assert x == 2;
+
+        assert (true ? "a" : "b") == "a";
+        assert (0 ? "a" : "b") == "b";
+        assert (2 * 3 ?? 7) == 6;
+        assert (null ?? 1 + 1) == 2;
+
+        // Code following `return` is never executed.
+        func ret(n) {
+          var unused;
+          return n * 2;
+          n = 1;
+          throw "unreachable";
+        }
+        assert ret(21) == 42;
+
+        // Unused variables are removed, but used ones are not.
+        func vars() {
+          var a;
+          var b;
+          var c;
+          b = 5;
+          return func() { return c;  };
+        }
+        assert vars()() == null;
+
+        // Declarations in `switch` clauses are shared by all clauses.
+        func sw(k) {
+          switch(k) {
+          case 1:
+            var s;
+          case 2:
+            return s;
+          }
+        }
+        assert sw(1) == null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
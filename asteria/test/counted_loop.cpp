@@ -0,0 +1,142 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Plain counted loops.
+        var s = 0;
+        for(var i = 0;  i < 100;  ++i)
+          s += i;
+        assert s == 4950;
+
+        s = 0;
+        for(var i = 1;  i <= 100;  i++)
+          s += i;
+        assert s == 5050;
+
+        var n = 10;
+        s = 0;
+        for(var i = -5;  i < n;  ++i)
+          s += 1;
+        assert s == 15;
+
+        s = 0;
+        for(var i = 5;  i < 5;  ++i)
+          s += 1;
+        assert s == 0;
+
+        // The bound may change in the body.
+        s = 0;
+        for(var i = 0;  i < n;  ++i) {
+          if(i == 3)
+            n = 5;
+          s += 1;
+        }
+        assert s == 5;
+
+        var a = [ 1, 2, 3, 4 ];
+        s = 0;
+        for(var i = 0;  i < countof a;  ++i)
+          s += a[i];
+        assert s == 10;
+
+        // The induction variable may be modified in the body.
+        s = 0;
+        for(var i = 0;  i < 10;  ++i) {
+          i += 2;
+          s += 1;
+        }
+        assert s == 4;
+
+        // The induction variable may become a non-integer.
+        s = 0;
+        for(var i = 0;  i < 3;  ++i) {
+          if(i == 1)
+            i = 1.5;
+          s += 1;
+        }
+        assert s == 3;
+
+        // Mixed types in comparison.
+        s = 0;
+        for(var i = 0;  i < 2.5;  ++i)
+          s += 1;
+        assert s == 3;
+
+        s = 0;
+        for(var i = 0.5;  i <= 3;  ++i)
+          s += 1;
+        assert s == 3;
+
+        // Control flow in the body.
+        s = 0;
+        for(var i = 0;  i < 100;  ++i) {
+          if(i % 2 == 0)
+            continue;
+          if(i > 10)
+            break;
+          s += i;
+        }
+        assert s == 25;
+
+        var d = [];
+        func test_defer() {
+          for(var i = 0;  i < 3;  ++i) {
+            defer d[$] = i;
+            var t = i;
+          }
+        }
+        test_defer();
+        assert d == [ 0, 1, 2 ];
+
+        func find(x) {
+          for(var i = 0;  i < countof a;  ++i)
+            if(a[i] == x)
+              return i;
+          return -1;
+        }
+        assert find(3) == 2;
+        assert find(5) == -1;
+
+        // Closures capture the induction variable by reference.
+        var f = [];
+        for(var i = 0;  i < 3;  ++i)
+          f[$] = func() { return i;  };
+        assert f[0]() == 3;
+        assert f[2]() == 3;
+
+        // Overflow must still be reported.
+        s = 0;
+        try
+          for(var i = 0x7FFFFFFFFFFFFFFE;  i <= 0x7FFFFFFFFFFFFFFF;  ++i)
+            s += 1;
+        catch(e)
+          s = std.string.find(e, "integer addition overflow") != null;
+        assert s == true;
+
+        // Immutable variables must not be incremented.
+        try
+          for(const i = 0;  i < 10;  ++i)
+            s += 1;
+        catch(e)
+          s = e;
+        assert typeof s == "string";
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
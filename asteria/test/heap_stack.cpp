@@ -0,0 +1,62 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // This is not a tail call, so every level takes a frame.
+        func depth(n) {
+          if(n == 0)
+            return 0;
+          return 1 + depth(n - 1);
+        }
+        assert depth(20000) == 20000;
+
+        // Segments are reused.
+        for(var i = 0;  i < 10;  ++i)
+          assert depth(5000) == 5000;
+
+        // Exceptions are propagated across stack segments.
+        func fail(n) {
+          if(n == 0)
+            throw "bottom";
+          return 1 + fail(n - 1);
+        }
+        try {
+          fail(1200);
+          assert false;
+        }
+        catch(e)
+          assert e == "bottom";
+
+        return depth;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    global.set_heap_stack_limit(size_t(64) << 20);
+    auto depth = code.execute(global).read().as_function();
+
+    // Running out of segments is still reported as a stack overflow.
+    Reference_root::S_constant xref = { V_integer(20000) };
+    cow_vector<Reference> args;
+    args.emplace_back(xref);
+    global.set_heap_stack_limit(size_t(1) << 20);
+    ASTERIA_TEST_CHECK_CATCH(depth.invoke(global, cow_vector<Reference>(args)));
+
+    // Without heap-allocated stacks, recursion is limited by the native stack.
+    global.set_heap_stack_limit(0);
+    ASTERIA_TEST_CHECK_CATCH(depth.invoke(global, cow_vector<Reference>(args)));
+  }
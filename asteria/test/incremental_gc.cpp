@@ -0,0 +1,87 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/genius_collector.hpp"
+#include "../src/runtime/native_binding.hpp"
+
+using namespace Asteria;
+
+namespace {
+
+V_integer
+do_gc_step(Global_Context& global, V_integer nsteps)
+  {
+    return static_cast<V_integer>(global.genius_collector()->collect_steps(static_cast<size_t>(nsteps)));
+  }
+
+}  // namespace
+
+int main()
+  {
+    Global_Context global;
+    auto gcoll = global.genius_collector();
+    gcoll->set_incremental_slice(16);
+    global.open_named_reference(::rocket::sref("gc_step")) = Reference_root::S_constant{
+      bind_native<Native_Overload<V_integer, Global_Context&, V_integer>::Target<do_gc_step>>(
+                  "gc_step", "`gc_step(nsteps)`") };
+
+    // References are moved between closures while a cycle is in progress, which makes
+    // results of earlier steps stale. No reachable variable shall be collected.
+    Simple_Script code;
+    code.reload_string(::rocket::sref(
+      R"__(
+        var cells = [];
+        for(var i = 0;  i < 200;  ++i) {
+          var y = i;
+          cells[i] = func() { return y; };
+        }
+        for(var j = 0;  j < 4000;  ++j) {
+          gc_step(7);
+          var a = j * 37 % 200;
+          var b = j * 91 % 200;
+          var t = cells[a];
+          cells[a] = cells[b];
+          cells[b] = t;
+          if(j % 8 == 0) {
+            var old = cells[b];
+            cells[b] = func() { return old(); };
+          }
+          // Make some garbage.
+          var f;
+          f = func() { return f; };
+        }
+        var sum = 0;
+        for(var i = 0;  i < 200;  ++i)
+          sum += cells[i]();
+        return sum;
+      )__"), ::rocket::sref(__FILE__));
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 19900);
+
+    // Garbage has been collected by allocation.
+    size_t ntracked = 0;
+    for(auto gc_gen : { gc_generation_newest, gc_generation_middle, gc_generation_oldest })
+      ntracked += gcoll->get_collector(gc_gen).count_tracked_variables();
+    ASTERIA_TEST_CHECK(ntracked < 4000);
+
+    // Complete a pass over all generations by steps.
+    size_t nvars = 0;
+    do
+      nvars += gcoll->collect_steps(10);
+    while(gcoll->is_cycle_in_progress());
+    ASTERIA_TEST_CHECK(nvars > 0);
+    ASTERIA_TEST_CHECK(gcoll->is_cycle_in_progress() == false);
+
+    // Nothing remains.
+    gcoll->collect_for(1000000);
+    ASTERIA_TEST_CHECK(gcoll->collect_for(1000000) == 0);
+
+    // Full collection cancels the cycle in progress.
+    gcoll->collect_steps(1);
+    ASTERIA_TEST_CHECK(gcoll->is_cycle_in_progress());
+    gcoll->collect_variables();
+    ASTERIA_TEST_CHECK(gcoll->is_cycle_in_progress() == false);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 19900);
+  }
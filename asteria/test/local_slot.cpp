@@ -0,0 +1,95 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Slots of locals are resolved at compile time. Declarations that are bypassed
+        // at runtime shift slots, which must not confuse lookups.
+        func sel(x) {
+          switch(x) {
+          case 1:
+            var a = "a";
+          case 2:
+            var b = "b";
+          case 3:
+            var c = "c";
+            return c;
+          }
+        }
+        assert sel(1) == "c";
+        assert sel(2) == "c";
+        assert sel(3) == "c";
+
+        // Pre-defined references are initialized lazily but have fixed slots.
+        func pre(x, ...) {
+          var y = x * 2;
+          return [ y, __varg(), __func, this ];
+        }
+        var r = pre(3, 4, 5);
+        assert r[0] == 6;
+        assert r[1] == 2;
+        assert std.string.starts_with(r[2], "pre");
+        assert r[3] == null;
+
+        var obj = { val: 42, get: func() { return this.val;  } };
+        assert obj.get() == 42;
+
+        // Captured references in nested closures.
+        func make(n) {
+          var sum = 0;
+          for(each k, v : [ 1, 2, 3 ])
+            sum += k * v + n;
+          return func(m) { return sum + m;  };
+        }
+        assert make(10)(1) == 39;
+
+        // Locals in deep nesting.
+        var acc = 0;
+        for(var i = 0;  i < 10;  ++i) {
+          var j = i;
+          {
+            var k = j + 1;
+            acc += k;
+          }
+        }
+        assert acc == 55;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+
+    // Declarations of variables that are never referenced are removed, but their slots
+    // are kept, so slots of subsequent variables are not stale.
+    code.reload_string(::rocket::sref(
+      R"__(
+        func f(a) {
+          var x;
+          var y = a;
+          var z;
+          return y + countof __func;
+        }
+        var w;
+        var s = 0;
+        for(var i = 0;  i < 100;  ++i)
+          s += f(i);
+        return s;
+      )__"), ::rocket::sref(__FILE__));
+    ASTERIA_TEST_CHECK(code.get_options().optimization_level >= 2);
+    auto nmisses = global.count_slot_misses();
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 4950 + 100 * 4);
+    ASTERIA_TEST_CHECK(global.count_slot_misses() == nmisses);
+  }
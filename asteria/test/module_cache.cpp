@@ -0,0 +1,74 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/module_cache.hpp"
+#include <unistd.h>
+
+using namespace Asteria;
+
+namespace {
+
+void
+do_replace_file(const cow_string& path, const char* text)
+  {
+    // Write a new file then move it into place, which changes its inode number.
+    auto tpath = path + ".tmp";
+    ::rocket::unique_posix_file file(::fopen(tpath.c_str(), "wb"), ::fclose);
+    ASTERIA_TEST_CHECK(file);
+    ASTERIA_TEST_CHECK(::fputs(text, file) >= 0);
+    file.reset();
+    ASTERIA_TEST_CHECK(::rename(tpath.c_str(), path.c_str()) == 0);
+  }
+
+}  // namespace
+
+int main()
+  {
+    char dname[] = "/tmp/asteria-module_cache-XXXXXX";
+    ASTERIA_TEST_CHECK(::mkdtemp(dname));
+    cow_string lib_path = cow_string(dname) + "/lib.ast";
+    do_replace_file(lib_path, "return __varg(0) * 2;");
+
+    Simple_Script code;
+    code.reload_string(::rocket::sref(
+      R"__(
+        var r = 0;
+        for(var i = 0;  i < 100;  ++i)
+          r += import("lib.ast", i);
+        return r;
+      )__"), cow_string(dname) + "/main.ast");
+
+    Global_Context global;
+    auto modcache = global.module_cache();
+    ASTERIA_TEST_CHECK(modcache->empty());
+
+    // The module is compiled only once.
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 9900);
+    ASTERIA_TEST_CHECK(modcache->size() == 1);
+
+    // A modified module is compiled again.
+    do_replace_file(lib_path, "return __varg(0) * 3;");
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 14850);
+    ASTERIA_TEST_CHECK(modcache->size() == 1);
+
+    // Different options result in different functions.
+    code.open_options().optimization_level = 0;
+    code.reload_string(::rocket::sref("return import(\"lib.ast\", 1);"), cow_string(dname) + "/main.ast");
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 3);
+    ASTERIA_TEST_CHECK(modcache->size() == 2);
+
+    // Modules can be invalidated explicitly.
+    char* abspath = ::realpath(lib_path.c_str(), nullptr);
+    ASTERIA_TEST_CHECK(abspath);
+    ASTERIA_TEST_CHECK(modcache->invalidate(cow_string(abspath)) == 2);
+    ::free(abspath);
+    ASTERIA_TEST_CHECK(modcache->empty());
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 3);
+    ASTERIA_TEST_CHECK(modcache->size() == 1);
+
+    ::unlink(lib_path.c_str());
+    ::rmdir(dname);
+  }
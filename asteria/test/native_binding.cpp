@@ -0,0 +1,92 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/runtime/native_binding.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+namespace {
+
+V_integer
+do_sum(V_integer x, optV_integer y)
+  {
+    return x + y.value_or(100);
+  }
+
+V_string
+do_sum(V_string x, V_string y)
+  {
+    return x + y;
+  }
+
+V_boolean
+do_has_callback(Global_Context& /*global*/, optV_function callback)
+  {
+    return static_cast<bool>(callback);
+  }
+
+int calls;
+
+void
+do_count(Value /*value*/)
+  {
+    calls++;
+  }
+
+template<typename... ArgsT>
+Value
+do_call(Global_Context& global, const V_function& func, ArgsT&&... args)
+  {
+    cow_vector<Reference> refs;
+    const int dummy[] = { (refs.emplace_back(Reference_root::S_constant{ ::std::forward<ArgsT>(args) }), 1)..., 1 };
+    static_cast<void>(dummy);
+    return func.invoke(global, ::std::move(refs)).read();
+  }
+
+}  // namespace
+
+int main()
+  {
+    Global_Context global;
+
+    auto sum = bind_native<Native_Overload<V_integer, V_integer, optV_integer>::Target<do_sum>,
+                           Native_Overload<V_string, V_string, V_string>::Target<do_sum>>(
+                           "test.sum", "`test.sum(x, [y])`");
+    ASTERIA_TEST_CHECK(do_call(global, sum, V_integer(1), V_integer(2)).as_integer() == 3);
+    ASTERIA_TEST_CHECK(do_call(global, sum, V_integer(1)).as_integer() == 101);
+    ASTERIA_TEST_CHECK(do_call(global, sum, V_integer(1), V_null()).as_integer() == 101);
+    ASTERIA_TEST_CHECK(do_call(global, sum, V_string("a"), V_string("b")).as_string() == "ab");
+    ASTERIA_TEST_CHECK_CATCH(do_call(global, sum));
+    ASTERIA_TEST_CHECK_CATCH(do_call(global, sum, V_string("a")));
+    ASTERIA_TEST_CHECK_CATCH(do_call(global, sum, V_integer(1), V_integer(2), V_integer(3)));
+
+    // The message lists all overloads.
+    try {
+      do_call(global, sum, V_real(1.5));
+      ASTERIA_TEST_CHECK(false);
+    }
+    catch(exception& except) {
+      ASTERIA_TEST_CHECK(::std::strstr(except.what(), "no matching function call for `test.sum(real)`"));
+      ASTERIA_TEST_CHECK(::std::strstr(except.what(), "`test.sum(integer, [integer])`"));
+      ASTERIA_TEST_CHECK(::std::strstr(except.what(), "`test.sum(string, string)`"));
+    }
+
+    // `Global_Context&` takes no argument. Optional functions may be absent.
+    auto has_callback = bind_native<Native_Overload<V_boolean, Global_Context&, opt<V_function>>::Target<do_has_callback>>(
+                                    "test.has_callback", "`test.has_callback([callback])`");
+    ASTERIA_TEST_CHECK(do_call(global, has_callback).as_boolean() == false);
+    ASTERIA_TEST_CHECK(do_call(global, has_callback, V_null()).as_boolean() == false);
+    ASTERIA_TEST_CHECK(do_call(global, has_callback, sum).as_boolean() == true);
+    ASTERIA_TEST_CHECK_CATCH(do_call(global, has_callback, V_integer(1)));
+
+    // Functions returning `void` return void references.
+    auto count = bind_native<Native_Overload<void, Value>::Target<do_count>>("test.count", "`test.count(value)`");
+    cow_vector<Reference> args;
+    args.emplace_back(Reference_root::S_constant{ V_string("x") });
+    Reference self = Reference_root::S_constant();
+    count.invoke(self, global, ::std::move(args));
+    ASTERIA_TEST_CHECK(self.is_void());
+    ASTERIA_TEST_CHECK(calls == 1);
+  }
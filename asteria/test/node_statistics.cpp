@@ -0,0 +1,54 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/llds/avmc_queue.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+        func add(x, y) {
+          return x + y;
+        }
+        var r = 0;
+        for(var i = 0;  i < 1000;  ++i)
+          r = add(r, i);
+        return r;
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref("my_file"));
+    Global_Context global;
+
+    // Nothing is collected by default.
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 499500);
+    ::rocket::tinyfmt_str fmt;
+    AVMC_Queue::print_statistics(fmt);
+    ASTERIA_TEST_CHECK(fmt.get_string().find("queue ") == cow_string::npos);
+
+    global.enable_node_statistics(true);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 499500);
+    global.enable_node_statistics(false);
+
+    fmt.clear_string();
+    AVMC_Queue::print_statistics(fmt);
+    auto text = fmt.extract_string();
+
+    // Nodes are named after their kinds, with source locations and counts.
+    ASTERIA_TEST_CHECK(text.find("S_function_call") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("@ my_file:7:") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("count 1000  ") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("self time by line\n") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("  my_file:3  count ") != cow_string::npos);
+
+    // Counts can be reset.
+    AVMC_Queue::clear_statistics();
+    fmt.clear_string();
+    AVMC_Queue::print_statistics(fmt);
+    ASTERIA_TEST_CHECK(fmt.get_string().find("count 1000  ") == cow_string::npos);
+  }
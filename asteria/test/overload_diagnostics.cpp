@@ -0,0 +1,91 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/argument_reader.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Overloads that are tried later must not be affected by earlier ones.
+        assert std.numeric.abs(-3) == 3;
+        assert std.numeric.abs(-1.5) == 1.5;
+        assert std.string.find("hello", 1, "l") == 2;
+        assert std.string.find("hello", 1, 2, "l") == 2;
+        assert std.string.find("hello", 1, null, "o") == 4;
+
+        // The list of overloads is composed when no overload matches.
+        try {
+          std.numeric.abs("x");
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "no matching function call for `std.numeric.abs(string)`") != null;
+          assert std.string.find(e, "`std.numeric.abs(integer)`") != null;
+          assert std.string.find(e, "`std.numeric.abs(real)`") != null;
+        }
+
+        try {
+          std.string.find("hello", true);
+          assert false;
+        }
+        catch(e) {
+          assert std.string.find(e, "`std.string.find(string, string)`") != null;
+          assert std.string.find(e, "`std.string.find(string, integer, [integer], string)`") != null;
+        }
+
+        try {
+          std.string.format();
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "`std.string.format(string, ...)`") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+
+    // Overloads that don't fit in the list are marked with `<more>`.
+    cow_vector<Reference> args;
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("test.many"));
+    V_integer ival;
+    V_string sval;
+    for(size_t k = 0;  k < 40;  ++k) {
+      reader.I().v(ival).v(sval).v(ival).v(sval).v(ival);
+      ASTERIA_TEST_CHECK(reader.F() == false);
+    }
+    try {
+      reader.throw_no_matching_function_call();
+    }
+    catch(exception& except) {
+      ::rocket::cow_string what = ::rocket::sref(except.what());
+      ASTERIA_TEST_CHECK(what.find("`test.many(integer, string, integer, string, integer)`") != what.npos);
+      ASTERIA_TEST_CHECK(what.find("\n  <more>\n  -- end of list of overloads]") != what.npos);
+    }
+
+    // Parameters that don't fit in the history are marked with `<more>`, not `...`.
+    Argument_Reader wide(::rocket::ref(args), ::rocket::sref("test.wide"));
+    wide.I();
+    for(size_t k = 0;  k < 20;  ++k)
+      wide.v(ival);
+    ASTERIA_TEST_CHECK(wide.F() == false);
+    try {
+      wide.throw_no_matching_function_call();
+    }
+    catch(exception& except) {
+      ::rocket::cow_string what = ::rocket::sref(except.what());
+      ASTERIA_TEST_CHECK(what.find("integer, integer, <more>)`") != what.npos);
+      ASTERIA_TEST_CHECK(what.find("...") == what.npos);
+    }
+  }
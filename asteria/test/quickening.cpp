@@ -0,0 +1,96 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Each operator node specializes itself on its first execution, and has
+        // to fall back to the generic path if operands change types later.
+        func add(x, y) { return x + y;  }
+        func sub(x, y) { return x - y;  }
+        func mul(x, y) { return x * y;  }
+        func div(x, y) { return x / y;  }
+        func mod(x, y) { return x % y;  }
+        func lt(x, y) { return x < y;  }
+        func eq(x, y) { return x == y;  }
+        func gte(x, y) { return x >= y;  }
+
+        assert add(1, 2) == 3;
+        assert add(1.5, 2) == 3.5;
+        assert add("a", "b") == "ab";
+        assert add(true, false) == true;
+        assert add(4, 5) == 9;
+
+        assert sub(2.5, 1.0) == 1.5;
+        assert sub(2, 5) == -3;
+        assert mul(3, 4) == 12;
+        assert mul("ab", 2) == "abab";
+        assert div(7, 2) == 3;
+        assert div(7.0, 2.0) == 3.5;
+        assert div(7, 2.0) == 3.5;
+        assert mod(7, 3) == 1;
+        assert mod(7.5, 2.0) == 1.5;
+
+        assert lt(1.0, 2.0) == true;
+        assert lt(2, 1) == false;
+        assert lt("a", "b") == true;
+        assert eq(1.0, 1.0) == true;
+        assert eq(1, 1) == true;
+        assert eq(1, 1.0) == true;
+        assert eq(null, null) == true;
+        assert eq(0.0/0.0, 0.0/0.0) == false;
+        assert gte(3, 3) == true;
+        assert gte(-0.0, 0.0) == true;
+
+        // Errors must be reported by the specialized paths as usual.
+        try {
+          add(0x7FFFFFFFFFFFFFFF, 1);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "addition overflow") != null;
+
+        try {
+          div(1, 0);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "divided by zero") != null;
+
+        try {
+          lt(1.0, 0.0/0.0);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "not comparable") != null;
+
+        assert lt(1.0, 2.0) == true;
+
+        // Compound assignment.
+        func acc(v, n) {
+          var r = v;
+          for(var i = 0;  i < n;  ++i)
+            r += r;
+          return r;
+        }
+        assert acc(1, 10) == 1024;
+        assert acc(0.5, 2) == 2.0;
+        assert acc("ab", 2) == "abababab";
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
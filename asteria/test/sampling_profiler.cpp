@@ -0,0 +1,65 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/sampling_profiler.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func busy(n) {
+          var r = 0;
+          for(var i = 0;  i < n;  ++i)
+            r += i;
+          return r;
+        }
+        // Proper tail calls replace their callers, so they are avoided here.
+        func outer() {
+          var r = busy(100000);
+          return r;
+        }
+        var r = outer();
+        return r;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref("my_file"));
+    Global_Context global;
+
+    // Samples are taken while the profiler is running.
+    Sampling_Profiler profiler;
+    profiler.start(1000);
+    ASTERIA_TEST_CHECK(profiler.is_running());
+    ASTERIA_TEST_CHECK_CATCH(Sampling_Profiler().start(1000));
+
+    for(size_t i = 0;  (i < 1000) && (profiler.count_samples() < 20);  ++i)
+      ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 4999950000);
+    profiler.stop();
+    ASTERIA_TEST_CHECK(!profiler.is_running());
+    ASTERIA_TEST_CHECK(profiler.count_samples() >= 20);
+
+    // Frames appear from the outermost to the innermost.
+    ::rocket::tinyfmt_str fmt;
+    profiler.print_collapsed(fmt);
+    auto text = fmt.extract_string();
+    ASTERIA_TEST_CHECK(text.find("<file scope> @ my_file:0:0;outer() @ my_file:") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find(";busy(n) @ my_file:") != cow_string::npos);
+
+    // No samples are taken after it stops.
+    auto nsamples = profiler.count_samples();
+    for(size_t i = 0;  i < 10;  ++i)
+      code.execute(global);
+    ASTERIA_TEST_CHECK(profiler.count_samples() == nsamples);
+
+    profiler.clear();
+    ASTERIA_TEST_CHECK(profiler.count_samples() == 0);
+  }
@@ -0,0 +1,165 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/script_cache.hpp"
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Asteria;
+
+namespace {
+
+void
+do_write_file(const cow_string& path, const char* text)
+  {
+    ::rocket::unique_posix_file file(::fopen(path.c_str(), "wb"), ::fclose);
+    ASTERIA_TEST_CHECK(file);
+    ASTERIA_TEST_CHECK(::fputs(text, file) >= 0);
+  }
+
+ino_t
+do_get_inode(const cow_string& path)
+  {
+    struct ::stat info;
+    if(::stat(path.c_str(), &info) != 0)
+      return 0;
+    return info.st_ino;
+  }
+
+V_integer
+do_run(const cow_string& path, bool cache)
+  {
+    Simple_Script code;
+    code.open_options().cache_compiled_code = cache;
+    code.reload_file(path.c_str());
+    Global_Context global;
+    return code.execute(global).read().as_integer();
+  }
+
+}  // namespace
+
+int main()
+  {
+    char dname[] = "/tmp/asteria-script_cache-XXXXXX";
+    ASTERIA_TEST_CHECK(::mkdtemp(dname));
+    cow_string main_path = cow_string(dname) + "/main.ast";
+    cow_string lib_path = cow_string(dname) + "/lib.ast";
+
+    // This script covers most kinds of IR nodes.
+    do_write_file(main_path,
+      R"__(
+        var sum = 0;
+        for(var i = 0;  i < 10;  ++i) {
+          if(i % 3 == 0)
+            continue;
+          sum += i;
+        }
+        assert sum == 27 : "bad sum";
+
+        func make_counter(n) {
+          var k = n;
+          return func() { return ++k;  };
+        }
+        var c = make_counter(5);
+        c();
+        assert c() == 7;
+
+        var names = [];
+        for(each key, value : { a: 1, b: [2, 3.5, "x"], c: null })
+          names[$] = key;
+        assert std.array.sort(names) == ["a","b","c"];
+
+        var [ x, y ] = [ 1, 2 ];
+        var { p, q } = { p: "p", q: true };
+        assert x + y == 3 && p == "p" && q;
+
+        func sel(v) {
+          switch(v) {
+            case 1:
+              return "one";
+            case "two":
+              return "two";
+            default:
+              return v ?? "null";
+          }
+        }
+        assert sel(1) == "one";
+        assert sel("two") == "two";
+        assert sel(null) == "null";
+
+        var log = "";
+        try {
+          defer log += "d";
+          throw "e";
+        }
+        catch(e)
+          log += e;
+        assert log == "de";
+
+        func vsum(...) {
+          var r = 0;
+          for(var i = 0;  i < __varg();  ++i)
+            r += __varg(i);
+          return r;
+        }
+        assert vsum(1, 2, 3) == 6;
+        assert (x > 0 ? 1.5 : 2.5) == 1.5;
+
+        var w = 0;
+        do
+          w += 4;
+        while(w < 100);
+        while(w > 90)
+          w -= 1;
+        assert w == 90;
+
+        return 42 + import("lib.ast", 5);
+      )__");
+    do_write_file(lib_path, "return __varg(0) * 2;");
+
+    // Compile the scripts, which writes cache files.
+    auto main_cache = get_script_cache_path(main_path);
+    auto lib_cache = get_script_cache_path(lib_path);
+    ASTERIA_TEST_CHECK(do_run(main_path, true) == 52);
+    auto main_inode = do_get_inode(main_cache);
+    auto lib_inode = do_get_inode(lib_cache);
+    ASTERIA_TEST_CHECK(main_inode != 0);
+    ASTERIA_TEST_CHECK(lib_inode != 0);
+
+    // Load them from the cache files, which are not rewritten.
+    ASTERIA_TEST_CHECK(do_run(main_path, true) == 52);
+    ASTERIA_TEST_CHECK(do_get_inode(main_cache) == main_inode);
+    ASTERIA_TEST_CHECK(do_get_inode(lib_cache) == lib_inode);
+
+    // The cache files are ignored if the source files are changed, even if their
+    // sizes are the same.
+    do_write_file(lib_path, "return __varg(0) * 3;");
+    ASTERIA_TEST_CHECK(do_run(main_path, true) == 57);
+    ASTERIA_TEST_CHECK(do_get_inode(main_cache) == main_inode);
+    ASTERIA_TEST_CHECK(do_get_inode(lib_cache) != lib_inode);
+
+    // The cache files are ignored if compiler options are changed.
+    ASTERIA_TEST_CHECK(do_run(main_path, false) == 57);
+
+    // Broken cache files are replaced.
+    ASTERIA_TEST_CHECK(::truncate(main_cache.c_str(), 200) == 0);
+    ASTERIA_TEST_CHECK(do_run(main_path, true) == 57);
+    ASTERIA_TEST_CHECK(do_get_inode(main_cache) != main_inode);
+    main_inode = do_get_inode(main_cache);
+
+    // Precompilation writes a cache file that can be loaded.
+    precompile_script_file(Compiler_Options(), main_path);
+    ASTERIA_TEST_CHECK(do_get_inode(main_cache) != main_inode);
+    main_inode = do_get_inode(main_cache);
+    ASTERIA_TEST_CHECK(do_run(main_path, true) == 57);
+    ASTERIA_TEST_CHECK(do_get_inode(main_cache) == main_inode);
+
+    ::unlink(main_path.c_str());
+    ::unlink(lib_path.c_str());
+    ::unlink(main_cache.c_str());
+    ::unlink(lib_cache.c_str());
+    ::rmdir(dname);
+  }
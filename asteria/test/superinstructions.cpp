@@ -0,0 +1,84 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // local reference, immediate, binary operator
+        var a = 5;
+        assert a + 1 == 6;
+        assert a * 2.5 == 12.5;
+        assert a << 2 == 20;
+        assert (a += 3) == 8;
+        assert a == 8;
+        a -= 10;
+        assert a == -2;
+        var s = "x";
+        s += "y";
+        assert s == "xy";
+        assert s + "z" == "xyz";
+
+        // The left-hand operand may be in an outer scope.
+        var n = 0;
+        for(var i = 0;  i < 10;  ++i) {
+          n += 2;
+        }
+        assert n == 20;
+
+        // immediate, binary operator
+        assert [ 1, 2 ][0] + 10 == 11;
+        assert std.math.pi * 2 > 6;
+
+        // comparison operator, `if` statement
+        var b = 3;
+        if(a < b)
+          b = a;
+        assert b == -2;
+        if(a > 100)
+          assert false;
+        else
+          b = 100;
+        assert b == 100;
+
+        func fib(x) {
+          if(x <= 1)
+            return x;
+          return fib(x - 1) + fib(x - 2);
+        }
+        assert fib(20) == 6765;
+
+        // Errors must be reported as usual.
+        var m = 0x7FFFFFFFFFFFFFFF;
+        try {
+          m += 1;
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "overflow") != null;
+        assert m == 0x7FFFFFFFFFFFFFFF;
+
+        try {
+          if(m < "str")
+            assert false;
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "not comparable") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
@@ -0,0 +1,112 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // All labels are constants, so a dispatch table is used.
+        func sel(x) {
+          var r = [];
+          switch(x) {
+          case 1:
+            r[$] = "one";
+          case "two":
+            r[$] = "two";
+            break;
+          default:
+            r[$] = "default";
+          case 3:
+            r[$] = "three";
+            break;
+          case 1:
+            r[$] = "duplicate";
+          }
+          return r;
+        }
+        assert sel(1) == [ "one", "two" ];
+        assert sel("two") == [ "two" ];
+        assert sel(3) == [ "three" ];
+        assert sel(4) == [ "default", "three" ];
+        assert sel("three") == [ "default", "three" ];
+        assert sel(null) == [ "default", "three" ];
+        assert sel(true) == [ "default", "three" ];
+        assert sel(-1) == [ "default", "three" ];
+
+        // Reals compare equal to integers.
+        assert sel(1.0) == [ "one", "two" ];
+        assert sel(3.0) == [ "three" ];
+        assert sel(3.5) == [ "default", "three" ];
+
+        // Without a `default` clause, nothing is executed.
+        func nodef(x) {
+          switch(x) {
+          case "a":
+            return 1;
+          case "b":
+            return 2;
+          }
+          return 0;
+        }
+        assert nodef("a") == 1;
+        assert nodef("b") == 2;
+        assert nodef("c") == 0;
+        assert nodef(1) == 0;
+
+        // Dynamic labels are still evaluated in order.
+        var n = 0;
+        func lbl(v) {
+          ++n;
+          return v;
+        }
+        func dyn(x) {
+          switch(x) {
+          case lbl(1):
+            return "a";
+          case lbl(2):
+            return "b";
+          default:
+            return "c";
+          }
+        }
+        n = 0;
+        assert dyn(2) == "b";
+        assert n == 2;
+        n = 0;
+        assert dyn(5) == "c";
+        assert n == 2;
+
+        // Variables declared in bypassed clauses.
+        func bypass(x) {
+          switch(x) {
+          case 1:
+            var a = 1;
+          case 2:
+            var b = 2;
+            return typeof a;
+          }
+        }
+        assert bypass(1) == "integer";
+        try {
+          bypass(2);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "bypassed") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
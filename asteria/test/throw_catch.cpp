@@ -0,0 +1,67 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/runtime_error.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Backtraces of rethrown exceptions are displayed before older ones.
+        var bt;
+        try {
+          try
+            throw 1;
+          catch(e)
+            throw e + 1;
+        }
+        catch(e)
+          bt = __backtrace;
+        assert bt[0].frame == "throw statement";
+        assert bt[0].value == 2;
+        var n = 0;
+        for(each k, f : bt)
+          if(f.frame == "throw statement") {
+            assert f.value == 2 - n;
+            ++n;
+          }
+        assert n == 2;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+
+    // Messages are composed on demand.
+    cbuf.set_string(::rocket::sref(
+      R"__(
+        func inner() { throw "meow";  }
+        func outer() { return inner();  }
+        outer();
+      )__"), tinybuf::open_read);
+
+    code.reload(cbuf, ::rocket::sref(__FILE__));
+    try {
+      code.execute(global);
+      ASTERIA_TERMINATE("no exception thrown");
+    }
+    catch(Runtime_Error& except) {
+      ASTERIA_TEST_CHECK(except.value().as_string() == "meow");
+      ASTERIA_TEST_CHECK(except.count_frames() > 2);
+      ASTERIA_TEST_CHECK(except.frame(0).type() == frame_type_throw);
+      ::rocket::cow_string what = ::rocket::sref(except.what());
+      ASTERIA_TEST_CHECK(what.find("meow") != what.npos);
+      ASTERIA_TEST_CHECK(what.find("inner") != what.npos);
+      ASTERIA_TEST_CHECK(what.find("outer") != what.npos);
+    }
+  }
@@ -0,0 +1,107 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+#include "../src/runtime/tracing_hooks.hpp"
+#include <unistd.h>
+
+using namespace Asteria;
+
+int main()
+  {
+    char dname[] = "/tmp/asteria-tracing_hooks-XXXXXX";
+    ASTERIA_TEST_CHECK(::mkdtemp(dname));
+    cow_string lib_path = cow_string(dname) + "/lib.ast";
+    ::rocket::unique_posix_file file(::fopen(lib_path.c_str(), "wb"), ::fclose);
+    ASTERIA_TEST_CHECK(file);
+    ASTERIA_TEST_CHECK(::fputs("return __varg(0) + 1;", file) >= 0);
+    file.reset();
+
+    Simple_Script code;
+    code.reload_string(::rocket::sref(
+      R"__(
+        func square(x) {
+          return x * x;
+        }
+        func fail() {
+          throw "meow";
+        }
+        var r = square(3);
+        try
+          fail();
+        catch(e)
+          r += 1;
+        r += std.string.find("hello", "l");
+        std.system.gc_collect();
+        r += import("lib.ast", 4);
+        return r;
+      )__"), cow_string(dname) + "/main.ast");
+
+    Global_Context global;
+    auto tracer = ::rocket::make_refcnt<Tracing_Hooks>();
+    global.set_hooks(tracer);
+    ASTERIA_TEST_CHECK(code.execute(global).read().as_integer() == 17);
+
+    ::rocket::tinyfmt_str fmt;
+    tracer->flush(fmt);
+    auto text = fmt.extract_string();
+    ASTERIA_TEST_CHECK(text.find("{\"traceEvents\":[") == 0);
+    ASTERIA_TEST_CHECK(tracer->count_events() == 0);
+
+    // Every kind of event is present, with begins and ends.
+    ASTERIA_TEST_CHECK(text.find("square(x)") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"cat\":\"script\",\"ph\":\"B\"") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"cat\":\"script\",\"ph\":\"E\"") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"args\":{\"exception\":true}") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"cat\":\"native\",\"ph\":\"B\"") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"cat\":\"gc\",\"ph\":\"B\"") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"args\":{\"variables_collected\":") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("\"cat\":\"import\",\"ph\":\"E\"") != cow_string::npos);
+    ASTERIA_TEST_CHECK(text.find("/lib.ast\"") != cow_string::npos);
+
+    // Names of functions that are called repeatedly are cached, and remain correct.
+    Simple_Script loop;
+    loop.reload_string(::rocket::sref(
+      R"__(
+        func alpha() { }
+        func beta() { }
+        for(var i = 0;  i < 100;  ++i) {
+          alpha();
+          beta();
+        }
+      )__"), cow_string(dname) + "/loop.ast");
+    loop.execute(global);
+
+    fmt.clear_string();
+    tracer->flush(fmt);
+    text = fmt.extract_string();
+    size_t nalpha = 0, nbeta = 0;
+    for(size_t pos = 0;  (pos = text.find("{\"name\":\"", pos)) != cow_string::npos;  ++pos)
+      if(text.compare(pos + 9, 10, "alpha() @ ") == 0)
+        ++nalpha;
+      else if(text.compare(pos + 9, 9, "beta() @ ") == 0)
+        ++nbeta;
+    ASTERIA_TEST_CHECK(nalpha == 200);
+    ASTERIA_TEST_CHECK(nbeta == 200);
+
+    // Events are dropped in a small buffer, but they remain balanced.
+    tracer = ::rocket::make_refcnt<Tracing_Hooks>(5U);
+    global.set_hooks(tracer);
+    code.execute(global);
+    ASTERIA_TEST_CHECK(tracer->count_events() <= 5);
+    ASTERIA_TEST_CHECK(tracer->count_dropped_events() != 0);
+
+    fmt.clear_string();
+    tracer->flush(fmt);
+    text = fmt.extract_string();
+    size_t nbegins = 0, nends = 0;
+    for(size_t pos = 0;  (pos = text.find("\"ph\":\"", pos)) != cow_string::npos;  ++pos)
+      (text[pos + 6] == 'B') ? ++nbegins : ++nends;
+    ASTERIA_TEST_CHECK(nbegins == nends);
+
+    global.set_hooks(nullptr);
+    ::unlink(lib_path.c_str());
+    ::rmdir(dname);
+  }